@@ -72,6 +72,7 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
     SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/audio_$(strip $(AUDIO_DRIVER)).c
     SRC += $(QUANTUM_DIR)/audio/voices.c
     SRC += $(QUANTUM_DIR)/audio/luts.c
+    SRC += $(QUANTUM_DIR)/audio/synth.c
 endif
 
 ifeq ($(strip $(SEQUENCER_ENABLE)), yes)
@@ -87,7 +88,6 @@ ifeq ($(strip $(MIDI_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/midi/qmk_midi.c
     SRC += $(QUANTUM_DIR)/midi/sysex_tools.c
     SRC += $(QUANTUM_DIR)/midi/bytequeue/bytequeue.c
-    SRC += $(QUANTUM_DIR)/midi/bytequeue/interrupt_setting.c
     SRC += $(QUANTUM_DIR)/process_keycode/process_midi.c
 endif
 
@@ -131,6 +131,7 @@ ifeq ($(strip $(POINTING_DEVICE_ENABLE)), yes)
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device.c
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_drivers.c
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_auto_mouse.c
+        SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_accumulator.c
         ifneq ($(strip $(POINTING_DEVICE_DRIVER)), custom)
             SRC += drivers/sensors/$(strip $(POINTING_DEVICE_DRIVER)).c
             OPT_DEFS += -DPOINTING_DEVICE_DRIVER_$(strip $(shell echo $(POINTING_DEVICE_DRIVER) | tr '[:lower:]' '[:upper:]'))
@@ -490,6 +491,10 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
         I2C_DRIVER_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3733.c
+        ifeq ($(strip $(IS31FL3733_I2C_ASYNC)), yes)
+            I2C_ASYNC_REQUIRED = yes
+            OPT_DEFS += -DIS31FL3733_I2C_ASYNC
+        endif
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3736)
@@ -557,6 +562,20 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     endif
 endif
 
+# Register writes shared by the ISSI drivers, whether LED/RGB Matrix or the keyboard's own SRC pulled them in
+IS31_DRIVER_SRC := $(foreach part,3218 3729 3731 3733 3736 3737 3741 3742a 3743a 3745 3746a,is31fl$(part).c is31fl$(part)-mono.c)
+ifneq ($(filter $(IS31_DRIVER_SRC),$(notdir $(SRC))),)
+    COMMON_VPATH += $(DRIVER_PATH)/led/issi
+    SRC += is31_common.c
+endif
+
+# Underglow and RGB Matrix on the same WS2812 chain are composited into one frame
+ifeq ($(strip $(RGBLIGHT_ENABLE))-$(strip $(RGBLIGHT_DRIVER))-$(strip $(RGB_MATRIX_ENABLE))-$(strip $(RGB_MATRIX_DRIVER)), yes-ws2812-yes-ws2812)
+    OPT_DEFS += -DLIGHTING_SHARED_WS2812
+    COMMON_VPATH += $(QUANTUM_DIR)/lighting
+    SRC += $(QUANTUM_DIR)/lighting/lighting.c
+endif
+
 ifeq ($(strip $(RGB_KEYCODES_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/process_keycode/process_rgb.c
 endif
@@ -645,7 +664,7 @@ ifneq ($(strip $(DEBOUNCE_TYPE)), custom)
 endif
 
 
-VALID_SERIAL_DRIVER_TYPES := bitbang usart vendor
+VALID_SERIAL_DRIVER_TYPES := bitbang usart usart_dma vendor
 
 SERIAL_DRIVER ?= bitbang
 ifeq ($(filter $(SERIAL_DRIVER),$(VALID_SERIAL_DRIVER_TYPES)),)
@@ -679,6 +698,9 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
         OPT_DEFS += -DSERIAL_DRIVER_$(strip $(shell echo $(SERIAL_DRIVER) | tr '[:lower:]' '[:upper:]'))
         ifeq ($(strip $(SERIAL_DRIVER)), bitbang)
             QUANTUM_LIB_SRC += serial.c
+        else ifeq ($(strip $(SERIAL_DRIVER)), usart_dma)
+            # Answers transactions from the UART interrupts, without serial_protocol.c
+            QUANTUM_LIB_SRC += serial_usart_dma.c
         else
             QUANTUM_LIB_SRC += serial_protocol.c
             QUANTUM_LIB_SRC += serial_$(strip $(SERIAL_DRIVER)).c
@@ -710,7 +732,7 @@ ifeq ($(strip $(HAPTIC_ENABLE)),yes)
         COMMON_VPATH += $(DRIVER_PATH)/haptic
 
         ifeq ($(strip $(HAPTIC_DRIVER)), drv2605l)
-            I2C_DRIVER_REQUIRED = yes
+            I2C_ASYNC_REQUIRED = yes
             SRC += drv2605l.c
         endif
 
@@ -949,6 +971,12 @@ ifeq ($(strip $(ANALOG_DRIVER_REQUIRED)), yes)
     QUANTUM_LIB_SRC += analog.c
 endif
 
+ifeq ($(strip $(I2C_ASYNC_REQUIRED)), yes)
+    I2C_DRIVER_REQUIRED = yes
+    OPT_DEFS += -DI2C_ASYNC_ENABLE
+    QUANTUM_LIB_SRC += i2c_async.c
+endif
+
 ifeq ($(strip $(I2C_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_I2C=TRUE
     QUANTUM_LIB_SRC += i2c_master.c
@@ -7,6 +7,8 @@
 #include "timer.h"
 #include "gpio.h"
 #include "ringbuffer.hpp"
+#include "bluefruit_le_queue.hpp"
+#include "bluefruit_le_response.hpp"
 #include <string.h>
 #include "spi_master.h"
 #include "wait.h"
@@ -53,6 +55,7 @@ static struct {
     uint32_t vbat;
 #endif
     uint16_t last_connection_update;
+    uint8_t  mouse_buttons;
 } state;
 
 // Commands are encoded using SDEP and sent via SPI
@@ -70,37 +73,8 @@ struct sdep_msg {
     uint8_t payload[SdepMaxPayload];
 } __attribute__((packed));
 
-// The recv latency is relatively high, so when we're hammering keys quickly,
-// we want to avoid waiting for the responses in the matrix loop.  We maintain
-// a short queue for that.  Since there is quite a lot of space overhead for
-// the AT command representation wrapped up in SDEP, we queue the minimal
-// information here.
-
-enum queue_type {
-    QTKeyReport, // 1-byte modifier + 6-byte key report
-    QTConsumer,  // 16-bit key code
-    QTMouseMove, // 4-byte mouse report
-};
-
-struct queue_item {
-    enum queue_type queue_type;
-    uint16_t        added;
-    union __attribute__((packed)) {
-        struct __attribute__((packed)) {
-            uint8_t modifier;
-            uint8_t keys[6];
-        } key;
-
-        uint16_t consumer;
-        struct __attribute__((packed)) {
-            int8_t  x, y, scroll, pan;
-            uint8_t buttons;
-        } mousemove;
-    };
-};
-
 // Items that we wish to send
-static RingBuffer<queue_item, 40> send_buf;
+static ReportQueue<40> send_buf;
 // Pending response; while pending, we can't send any more requests.
 // This records the time at which we sent the command for which we
 // are expecting a response.
@@ -256,19 +230,17 @@ static void resp_buf_read_one(bool greedy) {
 }
 
 static void send_buf_send_one(uint16_t timeout = SdepTimeout) {
-    struct queue_item item;
-
     // Don't send anything more until we get an ACK
     if (!resp_buf.empty()) {
         return;
     }
 
-    if (!send_buf.peek(item)) {
+    if (send_buf.empty()) {
         return;
     }
-    if (process_queue_item(&item, timeout)) {
-        // commit that peek
-        send_buf.get(item);
+    // The front item is updated with what went out, should only part of it make it
+    if (process_queue_item(&send_buf.front(), timeout)) {
+        send_buf.sent(timer_read());
         dprintf("send_buf_send_one: have %d remaining\n", (int)send_buf.size());
     } else {
         dprint("failed to send, will retry\n");
@@ -289,9 +261,10 @@ static void resp_buf_wait(const char *cmd) {
 }
 
 void bluefruit_le_init(void) {
-    state.initialized  = false;
-    state.configured   = false;
-    state.is_connected = false;
+    state.initialized   = false;
+    state.configured    = false;
+    state.is_connected  = false;
+    state.mouse_buttons = 0;
 
     gpio_set_pin_input(BLUEFRUIT_LE_IRQ_PIN);
 
@@ -315,7 +288,7 @@ static inline uint8_t min(uint8_t a, uint8_t b) {
 
 static bool read_response(char *resp, uint16_t resplen, bool verbose) {
     char *dest = resp;
-    char *end  = dest + resplen;
+    char *end  = dest + resplen - 1; // room for the NUL
 
     while (true) {
         struct sdep_msg msg;
@@ -342,29 +315,7 @@ static bool read_response(char *resp, uint16_t resplen, bool verbose) {
         }
     }
 
-    // Ensure the response is NUL terminated
-    *dest = 0;
-
-    // "Parse" the result text; we want to snip off the trailing OK or ERROR line
-    // Rewind past the possible trailing CRLF so that we can strip it
-    --dest;
-    while (dest > resp && (dest[0] == '\n' || dest[0] == '\r')) {
-        *dest = 0;
-        --dest;
-    }
-
-    // Look back for start of preceeding line
-    char *last_line = strrchr(resp, '\n');
-    if (last_line) {
-        ++last_line;
-    } else {
-        last_line = resp;
-    }
-
-    bool              success       = false;
-    static const char kOK[] PROGMEM = "OK";
-
-    success = !strcmp_P(last_line, kOK);
+    bool success = at_response_ok(resp, dest);
 
     if (verbose || !success) {
         dprintf("result: %s\n", resp);
@@ -587,10 +538,20 @@ static bool process_queue_item(struct queue_item *item, uint16_t timeout) {
 
 #ifdef MOUSE_ENABLE
         case QTMouseMove:
-            strcpy_P(fmtbuf, PSTR("AT+BLEHIDMOUSEMOVE=%d,%d,%d,%d"));
-            snprintf(cmdbuf, sizeof(cmdbuf), fmtbuf, item->mousemove.x, item->mousemove.y, item->mousemove.scroll, item->mousemove.pan);
-            if (!at_command(cmdbuf, NULL, 0, true, timeout)) {
-                return false;
+            if (item->mousemove.x || item->mousemove.y || item->mousemove.scroll || item->mousemove.pan) {
+                strcpy_P(fmtbuf, PSTR("AT+BLEHIDMOUSEMOVE=%d,%d,%d,%d"));
+                snprintf(cmdbuf, sizeof(cmdbuf), fmtbuf, item->mousemove.x, item->mousemove.y, item->mousemove.scroll, item->mousemove.pan);
+                if (!at_command(cmdbuf, NULL, 0, true, timeout)) {
+                    return false;
+                }
+                // Moved already, should the buttons have to be sent again
+                item->mousemove.x      = 0;
+                item->mousemove.y      = 0;
+                item->mousemove.scroll = 0;
+                item->mousemove.pan    = 0;
+            }
+            if (item->mousemove.buttons == state.mouse_buttons) {
+                return true;
             }
             strcpy_P(cmdbuf, PSTR("AT+BLEHIDMOUSEBUTTON="));
             if (item->mousemove.buttons & MOUSE_BTN1) {
@@ -605,7 +566,11 @@ static bool process_queue_item(struct queue_item *item, uint16_t timeout) {
             if (item->mousemove.buttons == 0) {
                 strcat(cmdbuf, "0");
             }
-            return at_command(cmdbuf, NULL, 0, true, timeout);
+            if (!at_command(cmdbuf, NULL, 0, true, timeout)) {
+                return false;
+            }
+            state.mouse_buttons = item->mousemove.buttons;
+            return true;
 #endif
         default:
             return true;
@@ -624,7 +589,7 @@ void bluefruit_le_send_keyboard(report_keyboard_t *report) {
     item.key.keys[4]  = report->keys[4];
     item.key.keys[5]  = report->keys[5];
 
-    while (!send_buf.enqueue(item)) {
+    while (!send_buf.add(item, timer_read())) {
         send_buf_send_one();
     }
 }
@@ -635,7 +600,7 @@ void bluefruit_le_send_consumer(uint16_t usage) {
     item.queue_type = QTConsumer;
     item.consumer   = usage;
 
-    while (!send_buf.enqueue(item)) {
+    while (!send_buf.add(item, timer_read())) {
         send_buf_send_one();
     }
 }
@@ -650,11 +615,19 @@ void bluefruit_le_send_mouse(report_mouse_t *report) {
     item.mousemove.pan     = report->h;
     item.mousemove.buttons = report->buttons;
 
-    while (!send_buf.enqueue(item)) {
+    while (!send_buf.add(item, timer_read())) {
         send_buf_send_one();
     }
 }
 
+void bluefruit_le_get_queue_stats(bluefruit_le_queue_stats_t *stats) {
+    *stats = send_buf.stats();
+}
+
+void bluefruit_le_reset_queue_stats(void) {
+    send_buf.reset_stats();
+}
+
 uint32_t bluefruit_le_read_battery_voltage(void) {
     return state.vbat;
 }
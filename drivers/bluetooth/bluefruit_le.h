@@ -52,6 +52,18 @@ extern uint32_t bluefruit_le_read_battery_voltage(void);
 extern bool bluefruit_le_set_mode_leds(bool on);
 extern bool bluefruit_le_set_power_level(int8_t level);
 
+typedef struct {
+    uint16_t sent;          // reports that went out
+    uint16_t coalesced;     // reports merged into one still waiting in the queue
+    uint16_t max_latency;   // longest wait in the queue, in milliseconds
+    uint32_t total_latency; // sum of the waits, in milliseconds
+    uint8_t  max_depth;     // most reports waiting at once
+} bluefruit_le_queue_stats_t;
+
+/* How the reports fared in the send queue since the last reset */
+extern void bluefruit_le_get_queue_stats(bluefruit_le_queue_stats_t *stats);
+extern void bluefruit_le_reset_queue_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
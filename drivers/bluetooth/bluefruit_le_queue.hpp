@@ -0,0 +1,178 @@
+#pragma once
+
+#include <stdint.h>
+#include "bluefruit_le.h"
+#include "timer.h"
+#include "ringbuffer.hpp"
+
+// The recv latency is relatively high, so when we're hammering keys quickly,
+// we want to avoid waiting for the responses in the matrix loop.  We maintain
+// a short queue for that.  Since there is quite a lot of space overhead for
+// the AT command representation wrapped up in SDEP, we queue the minimal
+// information here.
+
+enum queue_type {
+    QTKeyReport, // 1-byte modifier + 6-byte key report
+    QTConsumer,  // 16-bit key code
+    QTMouseMove, // 4-byte mouse report
+};
+
+struct queue_key_report {
+    uint8_t modifier;
+    uint8_t keys[6];
+} __attribute__((packed));
+
+struct queue_item {
+    enum queue_type queue_type;
+    uint16_t        added;
+    union __attribute__((packed)) {
+        struct queue_key_report key;
+
+        uint16_t consumer;
+        struct __attribute__((packed)) {
+            int8_t  x, y, scroll, pan;
+            uint8_t buttons;
+        } mousemove;
+    };
+};
+
+/* A queue of reports waiting for the module, which merges a new report into
+ * the last one queued while that one still waits behind another:
+ *  - mouse movements add up, as long as the buttons stay the same
+ *  - a keyboard report replaces the last one if the host cannot tell the
+ *    difference: no key goes down and up again unseen, and keys that go down
+ *    in both reports keep their order
+ * The front item is left alone, it may be half sent. */
+template <uint8_t Size>
+class ReportQueue : public RingBuffer<queue_item, Size> {
+    using RingBuffer<queue_item, Size>::buf_;
+    using RingBuffer<queue_item, Size>::head_;
+
+   public:
+    // Queues the item, merged into the last one if possible. Returns false when the queue is full.
+    bool add(queue_item item, uint16_t now) {
+        if (merge(item)) {
+            stats_.coalesced++;
+            return true;
+        }
+
+        item.added = now;
+        if (!this->enqueue(item)) {
+            return false;
+        }
+        if (item.queue_type == QTKeyReport) {
+            before_last_key_ = last_key_;
+            last_key_        = item.key;
+        }
+        if (this->size() > stats_.max_depth) {
+            stats_.max_depth = this->size();
+        }
+        return true;
+    }
+
+    // Drops the front item once it has been sent
+    void sent(uint16_t now) {
+        queue_item item;
+        if (!this->get(item)) {
+            return;
+        }
+        uint16_t latency = TIMER_DIFF_16(now, item.added);
+        stats_.sent++;
+        stats_.total_latency += latency;
+        if (latency > stats_.max_latency) {
+            stats_.max_latency = latency;
+        }
+    }
+
+    const bluefruit_le_queue_stats_t &stats() const {
+        return stats_;
+    }
+
+    void reset_stats() {
+        stats_ = {};
+    }
+
+   private:
+    bool merge(const queue_item &item) {
+        if (this->size() < 2) {
+            return false;
+        }
+        queue_item &last = buf_[this->prevPosition(head_)];
+        if (last.queue_type != item.queue_type) {
+            return false;
+        }
+
+        switch (item.queue_type) {
+            case QTKeyReport:
+                if (!supersedes(before_last_key_, last.key, item.key)) {
+                    return false;
+                }
+                last.key  = item.key;
+                last_key_ = item.key;
+                return true;
+
+            case QTMouseMove:
+                if (last.mousemove.buttons != item.mousemove.buttons) {
+                    return false;
+                }
+                if (!add_fits(last.mousemove.x, item.mousemove.x) || !add_fits(last.mousemove.y, item.mousemove.y) || !add_fits(last.mousemove.scroll, item.mousemove.scroll) || !add_fits(last.mousemove.pan, item.mousemove.pan)) {
+                    return false;
+                }
+                last.mousemove.x += item.mousemove.x;
+                last.mousemove.y += item.mousemove.y;
+                last.mousemove.scroll += item.mousemove.scroll;
+                last.mousemove.pan += item.mousemove.pan;
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    static bool add_fits(int8_t a, int8_t b) {
+        int16_t sum = a + b;
+        return sum >= -127 && sum <= 127;
+    }
+
+    static bool has_key(const queue_key_report &report, uint8_t key) {
+        for (uint8_t i = 0; i < sizeof(report.keys); i++) {
+            if (report.keys[i] == key) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Whether the host can go from before straight to next, without last in between
+    static bool supersedes(const queue_key_report &before, const queue_key_report &last, const queue_key_report &next) {
+        bool last_presses = (last.modifier & ~before.modifier) != 0;
+        bool next_presses = (next.modifier & ~last.modifier) != 0;
+
+        // A modifier pressed and released again, or released and pressed again
+        if ((last.modifier & ~before.modifier & ~next.modifier) || (before.modifier & ~last.modifier & next.modifier)) {
+            return false;
+        }
+        for (uint8_t i = 0; i < sizeof(last.keys); i++) {
+            uint8_t key = last.keys[i];
+            if (key && !has_key(before, key)) {
+                last_presses = true;
+                if (!has_key(next, key)) {
+                    return false;
+                }
+            }
+            key = next.keys[i];
+            if (key && !has_key(last, key)) {
+                next_presses = true;
+                if (has_key(before, key)) {
+                    return false;
+                }
+            }
+        }
+        // Keys that went down one after the other would arrive together
+        return !(last_presses && next_presses);
+    }
+
+    bluefruit_le_queue_stats_t stats_ = {};
+    queue_key_report           last_key_        = {};
+    queue_key_report           before_last_key_ = {};
+};
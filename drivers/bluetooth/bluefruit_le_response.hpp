@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdbool.h>
+#include <string.h>
+#include "progmem.h"
+
+/* "Parse" the result text of an AT command, which ends in a line with OK or
+ * ERROR.  Snips off the trailing line breaks, so that resp holds just the
+ * text, and returns whether the command succeeded.  end points just past the
+ * last character of the response. */
+static inline bool at_response_ok(char *resp, char *end) {
+    *end = 0;
+
+    // Rewind past the possible trailing CRLF so that we can strip it
+    while (end > resp && (end[-1] == '\n' || end[-1] == '\r')) {
+        *--end = 0;
+    }
+
+    // Look back for start of preceeding line
+    char *last_line = strrchr(resp, '\n');
+    if (last_line) {
+        ++last_line;
+    } else {
+        last_line = resp;
+    }
+
+    static const char kOK[] PROGMEM = "OK";
+    return !strcmp_P(last_line, kOK);
+}
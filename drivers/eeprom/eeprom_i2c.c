@@ -15,6 +15,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #if defined(EXTERNAL_EEPROM_WP_PIN)
 #    include "gpio.h"
@@ -33,24 +34,151 @@
     there is nothing to override during linkage.
 */
 
-#include "wait.h"
 #include "i2c_master.h"
+#include "timer.h"
+#include "util.h"
 #include "eeprom.h"
+#include "eeprom_driver.h"
 #include "eeprom_i2c.h"
 
 // #define DEBUG_EEPROM_OUTPUT
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-#    include "timer.h"
 #    include "debug.h"
 #endif // DEBUG_EEPROM_OUTPUT
 
-static inline void fill_target_address(uint8_t *buffer, const void *addr) {
-    uintptr_t p = (uintptr_t)addr;
+/*
+    Pages written through eeprom_write_block() are kept here and written back
+    to the device from housekeeping_task(), so that byte-sized updates to the
+    same page end up as a single page write. Pages held here are also known
+    to match what is (or is about to be) on the device, so writing identical
+    data to them is skipped.
+*/
+typedef struct {
+    uint32_t address; // of the first byte of the page
+    uint16_t used;
+    uint8_t  state;
+    uint8_t  data[EXTERNAL_EEPROM_PAGE_SIZE];
+} eeprom_i2c_page_t;
+
+enum {
+    EEPROM_I2C_PAGE_EMPTY,
+    EEPROM_I2C_PAGE_CLEAN,
+    EEPROM_I2C_PAGE_DIRTY,
+};
+
+static eeprom_i2c_page_t eeprom_i2c_cache[EXTERNAL_EEPROM_CACHE_PAGES];
+static uint16_t          eeprom_i2c_cache_clock = 0;
+static uint16_t          eeprom_i2c_last_write  = 0;
+static bool              eeprom_i2c_write_cycle = false;
+static uint16_t          eeprom_i2c_write_timer = 0;
+static uint16_t          eeprom_i2c_poll_time   = 0;
+
+static inline void fill_target_address(uint8_t *buffer, uint32_t addr) {
     for (int i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE; ++i) {
-        buffer[EXTERNAL_EEPROM_ADDRESS_SIZE - 1 - i] = p & 0xFF;
-        p >>= 8;
+        buffer[EXTERNAL_EEPROM_ADDRESS_SIZE - 1 - i] = addr & 0xFF;
+        addr >>= 8;
+    }
+}
+
+/*
+    While a write cycle is in progress the device does not acknowledge its
+    address. Rather than always waiting EXTERNAL_EEPROM_WRITE_TIME, a transfer
+    that is not acknowledged is retried until the device answers or that time
+    has passed.
+*/
+static i2c_status_t eeprom_i2c_transmit(uint32_t addr, const uint8_t *data, uint16_t length, bool wait) {
+    i2c_status_t status;
+    do {
+        status = i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS(addr), data, length, 100);
+    } while (status != I2C_STATUS_SUCCESS && wait && eeprom_i2c_write_cycle && timer_elapsed(eeprom_i2c_write_timer) <= EXTERNAL_EEPROM_WRITE_TIME);
+
+    if (status == I2C_STATUS_SUCCESS || wait) {
+        eeprom_i2c_write_cycle = false;
+    }
+    return status;
+}
+
+static i2c_status_t eeprom_i2c_read(uint32_t addr, uint8_t *buf, size_t len) {
+    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
+    fill_target_address(complete_packet, addr);
+
+    i2c_status_t status = eeprom_i2c_transmit(addr, complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, true);
+    if (status == I2C_STATUS_SUCCESS) {
+        status = i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS(addr), buf, len, 100);
+    }
+    return status;
+}
+
+// Writes within a single page, which starts a write cycle on the device
+static i2c_status_t eeprom_i2c_write(uint32_t addr, const uint8_t *data, uint16_t length, bool wait) {
+    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE];
+    fill_target_address(complete_packet, addr);
+    memcpy(&complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE], data, length);
+
+#if defined(EXTERNAL_EEPROM_WP_PIN)
+    gpio_set_pin_output(EXTERNAL_EEPROM_WP_PIN);
+    gpio_write_pin(EXTERNAL_EEPROM_WP_PIN, 0);
+#endif
+
+    i2c_status_t status = eeprom_i2c_transmit(addr, complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + length, wait);
+
+#if defined(EXTERNAL_EEPROM_WP_PIN)
+    /* We are setting the WP pin to high in a way that requires at least two bit-flips to change back to 0 */
+    gpio_write_pin(EXTERNAL_EEPROM_WP_PIN, 1);
+    gpio_set_pin_input_high(EXTERNAL_EEPROM_WP_PIN);
+#endif
+
+    if (status == I2C_STATUS_SUCCESS) {
+        eeprom_i2c_write_cycle = true;
+        eeprom_i2c_write_timer = timer_read();
+    }
+    return status;
+}
+
+static bool eeprom_i2c_write_back(eeprom_i2c_page_t *page, bool wait) {
+    if (eeprom_i2c_write(page->address, page->data, EXTERNAL_EEPROM_PAGE_SIZE, wait) != I2C_STATUS_SUCCESS && !wait) {
+        return false;
+    }
+    // A page the device still refuses after waiting is given up on, rather than retried forever
+    page->state = EEPROM_I2C_PAGE_CLEAN;
+    return true;
+}
+
+static eeprom_i2c_page_t *eeprom_i2c_cache_find(uint32_t page_addr) {
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_CACHE_PAGES; i++) {
+        if (eeprom_i2c_cache[i].state != EEPROM_I2C_PAGE_EMPTY && eeprom_i2c_cache[i].address == page_addr) {
+            return &eeprom_i2c_cache[i];
+        }
+    }
+    return NULL;
+}
+
+// Returns the cached page, making room for it if needed. Unless load is set, the caller is expected to fill in the whole page.
+// Returns NULL if the page could not be read, as its data would be written back over the device's.
+static eeprom_i2c_page_t *eeprom_i2c_cache_get(uint32_t page_addr, bool load) {
+    eeprom_i2c_page_t *page = eeprom_i2c_cache_find(page_addr);
+    if (!page) {
+        page = &eeprom_i2c_cache[0];
+        for (uint8_t i = 1; i < EXTERNAL_EEPROM_CACHE_PAGES && page->state != EEPROM_I2C_PAGE_EMPTY; i++) {
+            if (eeprom_i2c_cache[i].state == EEPROM_I2C_PAGE_EMPTY || (int16_t)(eeprom_i2c_cache[i].used - page->used) < 0) {
+                page = &eeprom_i2c_cache[i];
+            }
+        }
+        if (page->state == EEPROM_I2C_PAGE_DIRTY) {
+            eeprom_i2c_write_back(page, true);
+        }
+        page->address = page_addr;
+        page->state   = EEPROM_I2C_PAGE_EMPTY;
+        if (load) {
+            if (eeprom_i2c_read(page_addr, page->data, EXTERNAL_EEPROM_PAGE_SIZE) != I2C_STATUS_SUCCESS) {
+                return NULL;
+            }
+            page->state = EEPROM_I2C_PAGE_CLEAN;
+        }
     }
+    page->used = eeprom_i2c_cache_clock++;
+    return page;
 }
 
 void eeprom_driver_init(void) {
@@ -67,27 +195,96 @@ void eeprom_driver_erase(void) {
     uint32_t start = timer_read32();
 #endif
 
-    uint8_t buf[EXTERNAL_EEPROM_PAGE_SIZE];
-    memset(buf, 0x00, EXTERNAL_EEPROM_PAGE_SIZE);
+    // Everything is about to be cleared, including whatever was waiting to be written back
+    memset(eeprom_i2c_cache, 0, sizeof(eeprom_i2c_cache));
+
+    /*
+        Pages are read back and only written when they are not already clear.
+        Data tends to come in runs, so a page found to need writing is taken
+        as a hint for the next one, which is written without reading it first.
+        The page after that is read again.
+    */
+    eeprom_i2c_page_t *page  = &eeprom_i2c_cache[0];
+    bool               blind = false;
     for (uint32_t addr = 0; addr < EXTERNAL_EEPROM_BYTE_COUNT; addr += EXTERNAL_EEPROM_PAGE_SIZE) {
-        eeprom_write_block(buf, (void *)(uintptr_t)addr, EXTERNAL_EEPROM_PAGE_SIZE);
+        bool write = blind;
+        if (!blind) {
+            // A page that cannot be read is cleared regardless
+            write = eeprom_i2c_read(addr, page->data, EXTERNAL_EEPROM_PAGE_SIZE) != I2C_STATUS_SUCCESS;
+            for (uint16_t i = 0; i < EXTERNAL_EEPROM_PAGE_SIZE && !write; i++) {
+                write = page->data[i] != 0x00;
+            }
+        }
+        if (write) {
+            memset(page->data, 0x00, EXTERNAL_EEPROM_PAGE_SIZE);
+            page->address = addr;
+            eeprom_i2c_write_back(page, true);
+        }
+        blind = write && !blind;
     }
+    page->state = EEPROM_I2C_PAGE_EMPTY;
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("EEPROM erase took %ldms to complete\n", ((long)(timer_read32() - start)));
 #endif
 }
 
+void eeprom_driver_flush(void) {
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_CACHE_PAGES; i++) {
+        if (eeprom_i2c_cache[i].state == EEPROM_I2C_PAGE_DIRTY) {
+            eeprom_i2c_write_back(&eeprom_i2c_cache[i], true);
+        }
+    }
+}
+
+/*
+    Writes back one page at a time, once writes have paused for
+    EXTERNAL_EEPROM_WRITE_BACK_DELAY. The device is asked at most once per
+    millisecond whether its previous write cycle is over, and nothing here
+    waits for it.
+*/
+void eeprom_driver_task(void) {
+    eeprom_i2c_page_t *oldest = NULL;
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_CACHE_PAGES; i++) {
+        if (eeprom_i2c_cache[i].state == EEPROM_I2C_PAGE_DIRTY && (!oldest || (int16_t)(eeprom_i2c_cache[i].used - oldest->used) < 0)) {
+            oldest = &eeprom_i2c_cache[i];
+        }
+    }
+    if (!oldest || timer_elapsed(eeprom_i2c_last_write) < EXTERNAL_EEPROM_WRITE_BACK_DELAY) {
+        return;
+    }
+    if (eeprom_i2c_write_cycle) {
+        if (timer_read() == eeprom_i2c_poll_time) {
+            return;
+        }
+        eeprom_i2c_poll_time = timer_read();
+    }
+    eeprom_i2c_write_back(oldest, false);
+}
+
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
-    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
-    fill_target_address(complete_packet, addr);
+    uint8_t * read_buf    = (uint8_t *)buf;
+    uintptr_t target_addr = (uintptr_t)addr;
 
-    i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
-    i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), buf, len, 100);
+    while (len > 0) {
+        uintptr_t page_offset = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
+        size_t    read_length = MIN(EXTERNAL_EEPROM_PAGE_SIZE - page_offset, len);
+
+        eeprom_i2c_page_t *page = eeprom_i2c_cache_find(target_addr - page_offset);
+        if (page) {
+            memcpy(read_buf, &page->data[page_offset], read_length);
+        } else {
+            eeprom_i2c_read(target_addr, read_buf, read_length);
+        }
+
+        read_buf += read_length;
+        target_addr += read_length;
+        len -= read_length;
+    }
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("[EEPROM R] 0x%04X: ", ((int)addr));
-    for (size_t i = 0; i < len; ++i) {
+    for (size_t i = 0; i < (size_t)(read_buf - (uint8_t *)buf); ++i) {
         dprintf(" %02X", (int)(((uint8_t *)buf)[i]));
     }
     dprintf("\n");
@@ -95,46 +292,34 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    uint8_t   complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE];
-    uint8_t * read_buf    = (uint8_t *)buf;
-    uintptr_t target_addr = (uintptr_t)addr;
-
-#if defined(EXTERNAL_EEPROM_WP_PIN)
-    gpio_set_pin_output(EXTERNAL_EEPROM_WP_PIN);
-    gpio_write_pin(EXTERNAL_EEPROM_WP_PIN, 0);
-#endif
+    const uint8_t *write_buf   = (const uint8_t *)buf;
+    uintptr_t      target_addr = (uintptr_t)addr;
 
     while (len > 0) {
         uintptr_t page_offset  = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
-        int       write_length = EXTERNAL_EEPROM_PAGE_SIZE - page_offset;
-        if (write_length > len) {
-            write_length = len;
-        }
-
-        fill_target_address(complete_packet, (const void *)target_addr);
-        for (uint8_t i = 0; i < write_length; i++) {
-            complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + i] = read_buf[i];
-        }
+        size_t    write_length = MIN(EXTERNAL_EEPROM_PAGE_SIZE - page_offset, len);
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
         dprintf("[EEPROM W] 0x%04X: ", ((int)target_addr));
         for (uint8_t i = 0; i < write_length; i++) {
-            dprintf(" %02X", (int)(read_buf[i]));
+            dprintf(" %02X", (int)(write_buf[i]));
         }
         dprintf("\n");
 #endif // DEBUG_EEPROM_OUTPUT
 
-        i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
-        wait_ms(EXTERNAL_EEPROM_WRITE_TIME);
+        // Only a partial page needs the rest of its contents from the device
+        eeprom_i2c_page_t *page = eeprom_i2c_cache_get(target_addr - page_offset, write_length < EXTERNAL_EEPROM_PAGE_SIZE);
+        if (!page) {
+            // Without the rest of the page, only the bytes given are written, straight away
+            eeprom_i2c_write(target_addr, write_buf, write_length, true);
+        } else if (page->state == EEPROM_I2C_PAGE_EMPTY || memcmp(&page->data[page_offset], write_buf, write_length) != 0) {
+            memcpy(&page->data[page_offset], write_buf, write_length);
+            page->state           = EEPROM_I2C_PAGE_DIRTY;
+            eeprom_i2c_last_write = timer_read();
+        }
 
-        read_buf += write_length;
+        write_buf += write_length;
         target_addr += write_length;
         len -= write_length;
     }
-
-#if defined(EXTERNAL_EEPROM_WP_PIN)
-    /* We are setting the WP pin to high in a way that requires at least two bit-flips to change back to 0 */
-    gpio_write_pin(EXTERNAL_EEPROM_WP_PIN, 1);
-    gpio_set_pin_input_high(EXTERNAL_EEPROM_WP_PIN);
-#endif
 }
@@ -123,3 +123,25 @@
 #ifndef EXTERNAL_EEPROM_WRITE_TIME
 #    define EXTERNAL_EEPROM_WRITE_TIME 5
 #endif
+
+/*
+    The number of pages kept in RAM. Writes land in these pages first and are
+    written back to the EEPROM from housekeeping_task(), or straight away when
+    a page has to make room for another one.
+*/
+#ifndef EXTERNAL_EEPROM_CACHE_PAGES
+#    if defined(__AVR__)
+#        define EXTERNAL_EEPROM_CACHE_PAGES 1
+#    else
+#        define EXTERNAL_EEPROM_CACHE_PAGES 4
+#    endif
+#endif
+
+/*
+    How long in milliseconds writes have to pause before pages are written
+    back, so that a burst of small writes to the same page results in a single
+    write cycle.
+*/
+#ifndef EXTERNAL_EEPROM_WRITE_BACK_DELAY
+#    define EXTERNAL_EEPROM_WRITE_BACK_DELAY 10
+#endif
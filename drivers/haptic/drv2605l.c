@@ -17,6 +17,7 @@
 
 #include "drv2605l.h"
 #include "i2c_master.h"
+#include "i2c_async.h"
 #include <math.h>
 
 uint8_t drv2605l_write_buffer[2];
@@ -124,3 +125,31 @@ void drv2605l_pulse(uint8_t sequence) {
     drv2605l_write(DRV2605L_REG_WAVEFORM_SEQUENCER_1, sequence);
     drv2605l_write(DRV2605L_REG_GO, 0x01);
 }
+
+static const uint8_t           drv2605l_go_stop  = 0x00;
+static const uint8_t           drv2605l_go_start = 0x01;
+static uint8_t                 drv2605l_pulse_sequence;
+static const i2c_async_write_t drv2605l_pulse_writes[] = {
+    {DRV2605L_REG_GO, 1, &drv2605l_go_stop},
+    {DRV2605L_REG_WAVEFORM_SEQUENCER_1, 1, &drv2605l_pulse_sequence},
+    {DRV2605L_REG_GO, 1, &drv2605l_go_start},
+};
+static i2c_async_job_t drv2605l_pulse_job = {
+    .address  = DRV2605L_I2C_ADDRESS << 1,
+    .priority = DRV2605L_I2C_PRIORITY,
+    .timeout  = 100,
+    .writes   = drv2605l_pulse_writes,
+    .count    = sizeof(drv2605l_pulse_writes) / sizeof(drv2605l_pulse_writes[0]),
+};
+
+bool drv2605l_pulse_async(uint8_t sequence) {
+    if (i2c_async_busy(&drv2605l_pulse_job)) {
+        return false;
+    }
+    drv2605l_pulse_sequence = sequence;
+    return i2c_async_submit(&drv2605l_pulse_job);
+}
+
+bool drv2605l_pulse_busy(void) {
+    return i2c_async_busy(&drv2605l_pulse_job);
+}
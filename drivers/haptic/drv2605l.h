@@ -18,6 +18,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /* Initialization settings
 
@@ -131,6 +132,9 @@
 #endif
 
 #define DRV2605L_I2C_ADDRESS 0x5A
+#ifndef DRV2605L_I2C_PRIORITY
+#    define DRV2605L_I2C_PRIORITY 1
+#endif
 
 #define DRV2605L_REG_STATUS 0x00
 #define DRV2605L_REG_MODE 0x01
@@ -174,6 +178,9 @@ uint8_t drv2605l_read(const uint8_t reg_addr);
 void    drv2605l_rtp_init(void);
 void    drv2605l_amplitude(const uint8_t amplitude);
 void    drv2605l_pulse(const uint8_t sequence);
+// Same as drv2605l_pulse(), but the register writes are queued for i2c_async_task(). Returns false while the previous pulse is still being sent.
+bool    drv2605l_pulse_async(const uint8_t sequence);
+bool    drv2605l_pulse_busy(void);
 
 typedef enum drv2605l_effect_t {
     DRV2605L_EFFECT_CLEAR_SEQUENCE,
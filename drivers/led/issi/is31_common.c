@@ -0,0 +1,95 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "is31_common.h"
+#include "i2c_master.h"
+
+static bool is31_changed(const uint8_t *buffer, const uint8_t *shadow, uint16_t i) {
+    return !shadow || buffer[i] != shadow[i];
+}
+
+// End of a burst starting at the changed register start, taking in later changes no more than gap apart
+static uint16_t is31_burst_end(const uint8_t *buffer, const uint8_t *shadow, uint16_t start, uint16_t count, uint16_t gap) {
+    uint16_t end   = start + 1;
+    uint16_t limit = count - start < IS31_I2C_BURST_LENGTH ? count : start + IS31_I2C_BURST_LENGTH;
+    for (uint16_t j = end; j < limit && j - end <= gap; j++) {
+        if (is31_changed(buffer, shadow, j)) {
+            end = j + 1;
+        }
+    }
+    return end;
+}
+
+/** \brief Writes count registers from reg onwards, skipping those that match shadow
+ *
+ * Changed registers go out in as few bursts as IS31_I2C_BURST_LENGTH and
+ * IS31_I2C_BURST_GAP allow, and are copied into shadow once written. Without
+ * a shadow every register is written. address is already shifted, as for
+ * i2c_write_register(), and a persistence of 0 tries each burst once.
+ */
+void is31_write_registers(uint8_t address, uint8_t reg, const uint8_t *buffer, uint8_t *shadow, uint16_t count, uint16_t timeout, uint8_t persistence) {
+    uint16_t i = 0;
+    while (i < count) {
+        if (!is31_changed(buffer, shadow, i)) {
+            i++;
+            continue;
+        }
+
+        uint16_t start = i, end = is31_burst_end(buffer, shadow, start, count, IS31_I2C_BURST_GAP);
+        uint8_t  tries = persistence > 0 ? persistence : 1;
+        for (uint8_t t = 0; t < tries; t++) {
+            if (i2c_write_register(address, reg + start, buffer + start, end - start, timeout) == I2C_STATUS_SUCCESS) {
+                // A burst that failed keeps its old shadow, so the next write sends it again
+                if (shadow) {
+                    memcpy(shadow + start, buffer + start, end - start);
+                }
+                break;
+            }
+        }
+        i = end;
+    }
+}
+
+#ifdef I2C_ASYNC_ENABLE
+/** \brief Fills writes with bursts of the registers that differ from shadow, returns how many
+ *
+ * The changed registers are copied into shadow and the writes send them from
+ * there, so buffer may change while the writes are queued. The last of max
+ * writes takes in every change left that fits in a burst. Changes that still
+ * don't fit stay different from shadow for the next call, which can only
+ * happen when max writes were used. With all set, every register is sent.
+ */
+uint8_t is31_queue_registers(i2c_async_write_t *writes, uint8_t max, uint8_t reg, const uint8_t *buffer, uint8_t *shadow, uint16_t count, bool all) {
+    const uint8_t *compare = all ? NULL : shadow;
+    uint8_t        queued  = 0;
+    uint16_t       i       = 0;
+    while (i < count && queued < max) {
+        if (!is31_changed(buffer, compare, i)) {
+            i++;
+            continue;
+        }
+
+        uint16_t start = i, end = is31_burst_end(buffer, compare, start, count, queued + 1 < max ? IS31_I2C_BURST_GAP : IS31_I2C_BURST_LENGTH);
+        memcpy(shadow + start, buffer + start, end - start);
+        writes[queued].reg    = reg + start;
+        writes[queued].length = end - start;
+        writes[queued].data   = shadow + start;
+        queued++;
+        i = end;
+    }
+    return queued;
+}
+#endif
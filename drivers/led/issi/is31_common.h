@@ -0,0 +1,64 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Register writes shared by the ISSI drivers.
+//
+// The PWM registers of every part auto-increment across the whole page, so a
+// page can go out in a single transfer. A shadow copy of what the part holds
+// lets a flush send only the registers that changed since the last one.
+
+// Longest single register write, for I2C drivers that cannot send a whole page at once
+#ifndef IS31_I2C_BURST_LENGTH
+#    define IS31_I2C_BURST_LENGTH 255
+#endif
+
+// Unchanged registers between two changed ones that are sent anyway, as a
+// new transfer costs about as much as this many bytes of address and register
+#ifndef IS31_I2C_BURST_GAP
+#    define IS31_I2C_BURST_GAP 2
+#endif
+
+// The shadow costs a second copy of the PWM buffers, which is too much RAM on AVR
+#ifndef IS31_PWM_SHADOW
+#    ifdef __AVR__
+#        define IS31_PWM_SHADOW 0
+#    else
+#        define IS31_PWM_SHADOW 1
+#    endif
+#endif
+
+#if IS31_PWM_SHADOW
+#    define IS31_PWM_SHADOW_OF(shadow) (shadow)
+// For after the part's PWM registers have been cleared
+#    define IS31_PWM_SHADOW_CLEAR(shadow) memset((shadow), 0, sizeof(shadow))
+#else
+#    define IS31_PWM_SHADOW_OF(shadow) NULL
+#    define IS31_PWM_SHADOW_CLEAR(shadow)
+#endif
+
+void is31_write_registers(uint8_t address, uint8_t reg, const uint8_t *buffer, uint8_t *shadow, uint16_t count, uint16_t timeout, uint8_t persistence);
+
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+
+uint8_t is31_queue_registers(i2c_async_write_t *writes, uint8_t max, uint8_t reg, const uint8_t *buffer, uint8_t *shadow, uint16_t count, bool all);
+#endif
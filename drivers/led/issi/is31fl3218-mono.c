@@ -16,6 +16,7 @@
 
 #include "is31fl3218-mono.h"
 #include "i2c_master.h"
+#include "is31_common.h"
 #include "gpio.h"
 
 #define IS31FL3218_PWM_REGISTER_COUNT 18
@@ -31,6 +32,9 @@
 
 typedef struct is31fl3218_driver_t {
     uint8_t pwm_buffer[IS31FL3218_PWM_REGISTER_COUNT];
+#if IS31_PWM_SHADOW
+    uint8_t pwm_shadow[IS31FL3218_PWM_REGISTER_COUNT];
+#endif
     bool    pwm_buffer_dirty;
     uint8_t led_control_buffer[IS31FL3218_LED_CONTROL_REGISTER_COUNT];
     bool    led_control_buffer_dirty;
@@ -55,13 +59,7 @@ void is31fl3218_write_register(uint8_t reg, uint8_t data) {
 }
 
 void is31fl3218_write_pwm_buffer(void) {
-#if IS31FL3218_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3218_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, IS31FL3218_REG_PWM, driver_buffers.pwm_buffer, 18, IS31FL3218_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, IS31FL3218_REG_PWM, driver_buffers.pwm_buffer, 18, IS31FL3218_I2C_TIMEOUT);
-#endif
+    is31_write_registers(IS31FL3218_I2C_ADDRESS << 1, IS31FL3218_REG_PWM, driver_buffers.pwm_buffer, IS31_PWM_SHADOW_OF(driver_buffers.pwm_shadow), IS31FL3218_PWM_REGISTER_COUNT, IS31FL3218_I2C_TIMEOUT, IS31FL3218_I2C_PERSISTENCE);
 }
 
 void is31fl3218_init(void) {
@@ -82,6 +80,7 @@ void is31fl3218_init(void) {
     for (uint8_t i = 0; i < IS31FL3218_PWM_REGISTER_COUNT; i++) {
         is31fl3218_write_register(IS31FL3218_REG_PWM + i, 0x00);
     }
+    IS31_PWM_SHADOW_CLEAR(driver_buffers.pwm_shadow);
 
     // turn off all LEDs in the LED control register
     for (uint8_t i = 0; i < IS31FL3218_LED_CONTROL_REGISTER_COUNT; i++) {
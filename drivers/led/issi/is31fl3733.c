@@ -19,6 +19,7 @@
 
 #include "is31fl3733.h"
 #include "i2c_master.h"
+#include "is31_common.h"
 #include "gpio.h"
 #include "wait.h"
 
@@ -49,6 +50,19 @@
 #    define IS31FL3733_GLOBAL_CURRENT 0xFF
 #endif
 
+#ifdef IS31FL3733_I2C_ASYNC
+#    if !IS31_PWM_SHADOW
+#        error "IS31FL3733_I2C_ASYNC sends the PWM registers from their shadow, IS31_PWM_SHADOW must be enabled"
+#    endif
+#    ifndef IS31FL3733_I2C_PRIORITY
+#        define IS31FL3733_I2C_PRIORITY 0
+#    endif
+// Most PWM bursts queued per driver and flush, the last one takes in whatever is left
+#    ifndef IS31FL3733_I2C_ASYNC_WRITES
+#        define IS31FL3733_I2C_ASYNC_WRITES 8
+#    endif
+#endif
+
 #ifndef IS31FL3733_SYNC_1
 #    define IS31FL3733_SYNC_1 IS31FL3733_SYNC_NONE
 #endif
@@ -96,7 +110,13 @@ const uint8_t driver_sync[IS31FL3733_DRIVER_COUNT] = {
 // probably not worth the extra complexity.
 typedef struct is31fl3733_driver_t {
     uint8_t pwm_buffer[IS31FL3733_PWM_REGISTER_COUNT];
+#if IS31_PWM_SHADOW
+    uint8_t pwm_shadow[IS31FL3733_PWM_REGISTER_COUNT];
+#endif
     bool    pwm_buffer_dirty;
+#ifdef IS31FL3733_I2C_ASYNC
+    bool    pwm_resend;
+#endif
     uint8_t led_control_buffer[IS31FL3733_LED_CONTROL_REGISTER_COUNT];
     bool    led_control_buffer_dirty;
 } PACKED is31fl3733_driver_t;
@@ -108,6 +128,31 @@ is31fl3733_driver_t driver_buffers[IS31FL3733_DRIVER_COUNT] = {{
     .led_control_buffer_dirty = false,
 }};
 
+#ifdef IS31FL3733_I2C_ASYNC
+static const uint8_t is31fl3733_write_lock_magic = IS31FL3733_COMMAND_WRITE_LOCK_MAGIC;
+static const uint8_t is31fl3733_page_pwm         = IS31FL3733_COMMAND_PWM;
+
+// The page select and the PWM bursts of each driver's queued update
+static i2c_async_write_t is31fl3733_pwm_writes[IS31FL3733_DRIVER_COUNT][2 + IS31FL3733_I2C_ASYNC_WRITES];
+static i2c_async_job_t   is31fl3733_pwm_jobs[IS31FL3733_DRIVER_COUNT];
+
+static void is31fl3733_pwm_job_done(i2c_async_job_t *job, i2c_status_t status) {
+    if (status != I2C_STATUS_SUCCESS) {
+        // The shadow already holds what was queued, so there is no telling which registers made it
+        uint8_t index                          = job - is31fl3733_pwm_jobs;
+        driver_buffers[index].pwm_resend       = true;
+        driver_buffers[index].pwm_buffer_dirty = true;
+    }
+}
+
+// Sends whatever is still queued for a driver, before its page is changed from here
+static void is31fl3733_wait_pwm_job(uint8_t index) {
+    while (i2c_async_busy(&is31fl3733_pwm_jobs[index])) {
+        i2c_async_task();
+    }
+}
+#endif
+
 void is31fl3733_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 #if IS31FL3733_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3733_I2C_PERSISTENCE; i++) {
@@ -119,24 +164,17 @@ void is31fl3733_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 }
 
 void is31fl3733_select_page(uint8_t index, uint8_t page) {
+#ifdef IS31FL3733_I2C_ASYNC
+    is31fl3733_wait_pwm_job(index);
+#endif
     is31fl3733_write_register(index, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC);
     is31fl3733_write_register(index, IS31FL3733_REG_COMMAND, page);
 }
 
 void is31fl3733_write_pwm_buffer(uint8_t index) {
     // Assumes page 1 is already selected.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
-
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3733_PWM_REGISTER_COUNT; i += 16) {
-#if IS31FL3733_I2C_PERSISTENCE > 0
-        for (uint8_t j = 0; j < IS31FL3733_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3733_I2C_TIMEOUT);
-#endif
-    }
+    // Transmit the PWM registers that changed since the last write, in as few transfers as possible.
+    is31_write_registers(i2c_addresses[index] << 1, 0, driver_buffers[index].pwm_buffer, IS31_PWM_SHADOW_OF(driver_buffers[index].pwm_shadow), IS31FL3733_PWM_REGISTER_COUNT, IS31FL3733_I2C_TIMEOUT, IS31FL3733_I2C_PERSISTENCE);
 }
 
 void is31fl3733_init_drivers(void) {
@@ -180,6 +218,7 @@ void is31fl3733_init(uint8_t index) {
     for (uint8_t i = 0; i < IS31FL3733_PWM_REGISTER_COUNT; i++) {
         is31fl3733_write_register(index, i, 0x00);
     }
+    IS31_PWM_SHADOW_CLEAR(driver_buffers[index].pwm_shadow);
 
     is31fl3733_select_page(index, IS31FL3733_COMMAND_FUNCTION);
 
@@ -251,6 +290,35 @@ void is31fl3733_set_led_control_register(uint8_t index, bool red, bool green, bo
     driver_buffers[led.driver].led_control_buffer_dirty = true;
 }
 
+#ifdef IS31FL3733_I2C_ASYNC
+void is31fl3733_update_pwm_buffers(uint8_t index) {
+    i2c_async_job_t *job = &is31fl3733_pwm_jobs[index];
+    // The previous update is still going out, this one is sent by a later flush
+    if (!driver_buffers[index].pwm_buffer_dirty || i2c_async_busy(job)) {
+        return;
+    }
+
+    i2c_async_write_t *writes = is31fl3733_pwm_writes[index];
+    writes[0]                 = (i2c_async_write_t){IS31FL3733_REG_COMMAND_WRITE_LOCK, 1, &is31fl3733_write_lock_magic};
+    writes[1]                 = (i2c_async_write_t){IS31FL3733_REG_COMMAND, 1, &is31fl3733_page_pwm};
+    uint8_t bursts            = is31_queue_registers(&writes[2], IS31FL3733_I2C_ASYNC_WRITES, 0, driver_buffers[index].pwm_buffer, driver_buffers[index].pwm_shadow, IS31FL3733_PWM_REGISTER_COUNT, driver_buffers[index].pwm_resend);
+
+    // Only a full list of bursts can have left changes behind
+    driver_buffers[index].pwm_buffer_dirty = bursts == IS31FL3733_I2C_ASYNC_WRITES;
+    driver_buffers[index].pwm_resend       = false;
+    if (bursts == 0) {
+        return;
+    }
+
+    job->address  = i2c_addresses[index] << 1;
+    job->priority = IS31FL3733_I2C_PRIORITY;
+    job->timeout  = IS31FL3733_I2C_TIMEOUT;
+    job->writes   = writes;
+    job->count    = 2 + bursts;
+    job->callback = is31fl3733_pwm_job_done;
+    i2c_async_submit(job);
+}
+#else
 void is31fl3733_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
         is31fl3733_select_page(index, IS31FL3733_COMMAND_PWM);
@@ -260,6 +328,7 @@ void is31fl3733_update_pwm_buffers(uint8_t index) {
         driver_buffers[index].pwm_buffer_dirty = false;
     }
 }
+#endif
 
 void is31fl3733_update_led_control_registers(uint8_t index) {
     if (driver_buffers[index].led_control_buffer_dirty) {
@@ -19,6 +19,7 @@
 
 #include "is31fl3741-mono.h"
 #include "i2c_master.h"
+#include "is31_common.h"
 #include "gpio.h"
 #include "wait.h"
 
@@ -76,7 +77,13 @@ const uint8_t i2c_addresses[IS31FL3741_DRIVER_COUNT] = {
 // probably not worth the extra complexity.
 typedef struct is31fl3741_driver_t {
     uint8_t pwm_buffer_0[IS31FL3741_PWM_0_REGISTER_COUNT];
+#if IS31_PWM_SHADOW
+    uint8_t pwm_shadow_0[IS31FL3741_PWM_0_REGISTER_COUNT];
+#endif
     uint8_t pwm_buffer_1[IS31FL3741_PWM_1_REGISTER_COUNT];
+#if IS31_PWM_SHADOW
+    uint8_t pwm_shadow_1[IS31FL3741_PWM_1_REGISTER_COUNT];
+#endif
     bool    pwm_buffer_dirty;
     uint8_t scaling_buffer_0[IS31FL3741_SCALING_0_REGISTER_COUNT];
     uint8_t scaling_buffer_1[IS31FL3741_SCALING_1_REGISTER_COUNT];
@@ -110,33 +117,13 @@ void is31fl3741_select_page(uint8_t index, uint8_t page) {
 void is31fl3741_write_pwm_buffer(uint8_t index) {
     is31fl3741_select_page(index, IS31FL3741_COMMAND_PWM_0);
 
-    // Transmit PWM0 registers in 6 transfers of 30 bytes.
-
-    // Iterate over the pwm_buffer_0 contents at 30 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3741_PWM_0_REGISTER_COUNT; i += 30) {
-#if IS31FL3741_I2C_PERSISTENCE > 0
-        for (uint8_t j = 0; j < IS31FL3741_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_0 + i, 30, IS31FL3741_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_0 + i, 30, IS31FL3741_I2C_TIMEOUT);
-#endif
-    }
+    // Transmit the PWM0 registers that changed since the last write, in as few transfers as possible.
+    is31_write_registers(i2c_addresses[index] << 1, 0, driver_buffers[index].pwm_buffer_0, IS31_PWM_SHADOW_OF(driver_buffers[index].pwm_shadow_0), IS31FL3741_PWM_0_REGISTER_COUNT, IS31FL3741_I2C_TIMEOUT, IS31FL3741_I2C_PERSISTENCE);
 
     is31fl3741_select_page(index, IS31FL3741_COMMAND_PWM_1);
 
-    // Transmit PWM1 registers in 9 transfers of 19 bytes.
-
-    // Iterate over the pwm_buffer_1 contents at 19 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3741_PWM_1_REGISTER_COUNT; i += 19) {
-#if IS31FL3741_I2C_PERSISTENCE > 0
-        for (uint8_t i = 0; i < IS31FL3741_I2C_PERSISTENCE; i++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_1 + i, 19, IS31FL3741_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_1 + i, 19, IS31FL3741_I2C_TIMEOUT);
-#endif
-    }
+    // Transmit the PWM1 registers that changed since the last write, in as few transfers as possible.
+    is31_write_registers(i2c_addresses[index] << 1, 0, driver_buffers[index].pwm_buffer_1, IS31_PWM_SHADOW_OF(driver_buffers[index].pwm_shadow_1), IS31FL3741_PWM_1_REGISTER_COUNT, IS31FL3741_I2C_TIMEOUT, IS31FL3741_I2C_PERSISTENCE);
 }
 
 void is31fl3741_init_drivers(void) {
@@ -165,6 +165,12 @@ uint32_t oled_scroll_timeout;
 #if OLED_UPDATE_INTERVAL > 0
 uint16_t oled_update_timeout;
 #endif
+#ifdef OLED_SHADOW_BUFFER
+// Copy of what was last sent to the display, so unchanged bytes are never resent
+static uint8_t oled_shadow[OLED_MATRIX_SIZE];
+// Blocks where the shadow copy is not known to match the display memory
+static OLED_BLOCK_TYPE oled_shadow_stale = OLED_ALL_BLOCKS_MASK;
+#endif
 
 #if defined(OLED_TRANSPORT_SPI)
 #    ifndef OLED_DC_PIN
@@ -363,6 +369,9 @@ bool oled_init(oled_rotation_t rotation) {
 #endif
 
     oled_clear();
+#ifdef OLED_SHADOW_BUFFER
+    oled_shadow_stale = OLED_ALL_BLOCKS_MASK;
+#endif
     oled_initialized = true;
     oled_active      = true;
     oled_scrolling   = false;
@@ -438,6 +447,15 @@ uint8_t crot(uint8_t a, int8_t n) {
 }
 
 static void rotate_90(const uint8_t *src, uint8_t *dest) {
+    // Blank 8x8 tiles are common, and rotate to nothing
+    uint8_t any = 0;
+    for (uint8_t j = 0; j < 8; ++j) {
+        any |= src[j];
+    }
+    if (!any) {
+        return;
+    }
+
     for (uint8_t i = 0, shift = 7; i < 8; ++i, --shift) {
         uint8_t selector = (1 << i);
         for (uint8_t j = 0; j < 8; ++j) {
@@ -446,6 +464,156 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
     }
 }
 
+// Sends a single block to the display, rotating if required
+static bool oled_render_block(uint8_t update_start) {
+    // Set column & page position
+#if OLED_IC_HAS_HORIZONTAL_MODE
+    static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
+#else
+    static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
+#endif
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+    } else {
+        calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+    }
+
+    // Send column & page position
+    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        print("oled_render offset command failed\n");
+        return false;
+    }
+
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        // Send render data chunk as is
+        if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            print("oled_render data failed\n");
+            return false;
+        }
+    } else {
+        // Rotate the render chunks
+        const static uint8_t source_map[] = OLED_SOURCE_MAP;
+        const static uint8_t target_map[] = OLED_TARGET_MAP;
+
+        static uint8_t temp_buffer[OLED_BLOCK_SIZE];
+        memset(temp_buffer, 0, sizeof(temp_buffer));
+        for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+            rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
+        }
+
+#if OLED_IC_HAS_HORIZONTAL_MODE
+        // Send render data chunk after rotating
+        if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
+            print("oled_render90 data failed\n");
+            return false;
+        }
+#else
+        // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
+        const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
+        const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
+        for (uint8_t i = 0; i < num_pages; ++i) {
+            // Send column & page position for all pages except the first one
+            if (i > 0) {
+                display_start[1]++;
+                if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                    print("oled_render offset command failed\n");
+                    return false;
+                }
+            }
+            // Send data for the page
+            if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
+                print("oled_render90 data failed\n");
+                return false;
+            }
+        }
+#endif
+    }
+
+    return true;
+}
+
+#ifdef OLED_SHADOW_BUFFER
+// Marks the blocks covering the given byte range as needing a full resend
+static void oled_mark_stale(uint16_t start, uint16_t end) {
+    for (uint16_t block = start / OLED_BLOCK_SIZE; block <= end / OLED_BLOCK_SIZE; ++block) {
+        oled_dirty |= ((OLED_BLOCK_TYPE)1 << block);
+        oled_shadow_stale |= ((OLED_BLOCK_TYPE)1 << block);
+    }
+}
+
+// Sends an unrotated span of bytes, which must all lie within the same page
+static bool oled_render_span(uint16_t start, uint16_t end) {
+    uint8_t page         = start / OLED_DISPLAY_WIDTH;
+    uint8_t start_column = start % OLED_DISPLAY_WIDTH + OLED_COLUMN_OFFSET;
+#    if OLED_IC_HAS_HORIZONTAL_MODE
+    uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, start_column, end % OLED_DISPLAY_WIDTH + OLED_COLUMN_OFFSET, PAGE_ADDR, page, page};
+#    else
+    uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR | page, PAM_SETCOLUMN_LSB | (start_column & 0x0f), PAM_SETCOLUMN_MSB | (start_column >> 4 & 0x0f)};
+#    endif
+
+    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        print("oled_render offset command failed\n");
+        oled_mark_stale(start, end);
+        return false;
+    }
+
+    if (!oled_send_data(&oled_buffer[start], end - start + 1)) {
+        print("oled_render data failed\n");
+        oled_mark_stale(start, end);
+        return false;
+    }
+
+    memcpy(&oled_shadow[start], &oled_buffer[start], end - start + 1);
+    return true;
+}
+
+// Renders only the bytes of the dirty blocks that differ from the shadow copy, merging nearby changes on the same
+// page into a single transfer
+static void oled_render_dirty_spans(bool all) {
+    uint16_t span_start    = 0;
+    uint16_t span_end      = 0;
+    bool     span_open     = false;
+    uint8_t  num_processed = 0;
+
+    for (uint8_t block = 0; block < OLED_BLOCK_COUNT && oled_dirty; ++block) {
+        const OLED_BLOCK_TYPE mask = (OLED_BLOCK_TYPE)1 << block;
+        if (!(oled_dirty & mask)) {
+            continue;
+        }
+        if (num_processed++ >= OLED_UPDATE_PROCESS_LIMIT && !all) {
+            break;
+        }
+
+        const bool stale = (oled_shadow_stale & mask);
+        for (uint16_t i = OLED_BLOCK_SIZE * block; i < OLED_BLOCK_SIZE * (block + 1); ++i) {
+            if (!stale && oled_buffer[i] == oled_shadow[i]) {
+                continue;
+            }
+
+            // Extend the current span if this byte is nearby and on the same page, otherwise send it and start anew
+            if (span_open && (i / OLED_DISPLAY_WIDTH) == (span_start / OLED_DISPLAY_WIDTH) && (i - span_end - 1) <= OLED_SHADOW_MAX_GAP) {
+                span_end = i;
+                continue;
+            }
+            if (span_open && !oled_render_span(span_start, span_end)) {
+                return;
+            }
+            span_start = i;
+            span_end   = i;
+            span_open  = true;
+        }
+
+        // Clear dirty flag of just processed block, any failed sends will mark it dirty again
+        oled_dirty &= ~mask;
+        oled_shadow_stale &= ~mask;
+    }
+
+    if (span_open) {
+        oled_render_span(span_start, span_end);
+    }
+}
+#endif // OLED_SHADOW_BUFFER
+
 void oled_render_dirty(bool all) {
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
@@ -456,76 +624,39 @@ void oled_render_dirty(bool all) {
     // Turn on display if it is off
     oled_on();
 
+#ifdef OLED_SHADOW_BUFFER
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        oled_render_dirty_spans(all);
+        return;
+    }
+#endif
+
     uint8_t update_start  = 0;
     uint8_t num_processed = 0;
-    while (oled_dirty && (num_processed++ < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
+    while (oled_dirty && (num_processed < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
         // Find next dirty block
         while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
             ++update_start;
         }
 
-        // Set column & page position
-#if OLED_IC_HAS_HORIZONTAL_MODE
-        static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
-#else
-        static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
-#endif
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        } else {
-            calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+#ifdef OLED_SHADOW_BUFFER
+        // Rotated blocks are sent whole, skip those the display already shows
+        const OLED_BLOCK_TYPE mask = (OLED_BLOCK_TYPE)1 << update_start;
+        if (!(oled_shadow_stale & mask) && !memcmp(&oled_buffer[OLED_BLOCK_SIZE * update_start], &oled_shadow[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            oled_dirty &= ~mask;
+            continue;
         }
+#endif
 
-        // Send column & page position
-        if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
-            print("oled_render offset command failed\n");
+        if (!oled_render_block(update_start)) {
             return;
         }
+        ++num_processed;
 
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
-                print("oled_render data failed\n");
-                return;
-            }
-        } else {
-            // Rotate the render chunks
-            const static uint8_t source_map[] = OLED_SOURCE_MAP;
-            const static uint8_t target_map[] = OLED_TARGET_MAP;
-
-            static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-            memset(temp_buffer, 0, sizeof(temp_buffer));
-            for (uint8_t i = 0; i < sizeof(source_map); ++i) {
-                rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
-            }
-
-#if OLED_IC_HAS_HORIZONTAL_MODE
-            // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
-                print("oled_render90 data failed\n");
-                return;
-            }
-#else
-            // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
-            const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
-            const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
-            for (uint8_t i = 0; i < num_pages; ++i) {
-                // Send column & page position for all pages except the first one
-                if (i > 0) {
-                    display_start[1]++;
-                    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
-                        print("oled_render offset command failed\n");
-                        return;
-                    }
-                }
-                // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
-                    print("oled_render90 data failed\n");
-                    return;
-                }
-            }
+#ifdef OLED_SHADOW_BUFFER
+        memcpy(&oled_shadow[OLED_BLOCK_SIZE * update_start], &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE);
+        oled_shadow_stale &= ~mask;
 #endif
-        }
 
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
@@ -878,6 +1009,10 @@ bool oled_scroll_off(void) {
         }
         oled_scrolling = false;
         oled_dirty     = OLED_ALL_BLOCKS_MASK;
+#ifdef OLED_SHADOW_BUFFER
+        // Scrolling moves the display memory, so its contents are no longer known
+        oled_shadow_stale = OLED_ALL_BLOCKS_MASK;
+#endif
     }
     return !oled_scrolling;
 }
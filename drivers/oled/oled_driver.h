@@ -321,6 +321,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define OLED_UPDATE_PROCESS_LIMIT 1
 #endif
 
+// Largest run of unchanged bytes sent rather than starting a new transfer, when OLED_SHADOW_BUFFER is enabled
+#if !defined(OLED_SHADOW_MAX_GAP)
+#    define OLED_SHADOW_MAX_GAP 8
+#endif
+
 typedef struct __attribute__((__packed__)) {
     uint8_t *current_element;
     uint16_t remaining_element_count;
@@ -91,6 +91,17 @@ uint8_t ps2_host_recv(void);
 void    ps2_host_set_led(uint8_t usb_led);
 bool    pbuf_has_data(void);
 
+#ifdef PS2_DRIVER_INTERRUPT
+/* Whole packets put together by the interrupt handler, see ps2_interrupt.c */
+#    define PS2_PACKET_MAX_SIZE 4
+#    ifndef PS2_PACKET_BUFFER_SIZE
+#        define PS2_PACKET_BUFFER_SIZE 8
+#    endif
+
+void    ps2_host_set_packet_size(uint8_t size);
+uint8_t ps2_host_recv_packet(uint8_t *packet);
+#endif
+
 /*--------------------------------------------------------------------
  * static functions
  *------------------------------------------------------------------*/
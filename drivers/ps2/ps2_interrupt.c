@@ -69,6 +69,9 @@ static inline uint8_t pbuf_dequeue(void);
 static inline void    pbuf_enqueue(uint8_t data);
 static inline void    pbuf_clear(void);
 bool                  pbuf_has_data(void);
+static inline void    packet_receive(uint8_t data);
+static inline void    packet_abort(void);
+static inline uint8_t packet_get_size(void);
 
 #if defined(PROTOCOL_CHIBIOS)
 void ps2_interrupt_service_routine(void);
@@ -100,8 +103,14 @@ void ps2_host_init(void) {
 }
 
 uint8_t ps2_host_send(uint8_t data) {
-    bool parity = true;
-    ps2_error   = PS2_ERR_NONE;
+    bool    parity      = true;
+    uint8_t packet_mode = packet_get_size();
+    ps2_error           = PS2_ERR_NONE;
+
+    /* the response is a single byte, not part of a packet */
+    if (packet_mode) {
+        ps2_host_set_packet_size(0);
+    }
 
     PS2_INT_OFF();
 
@@ -150,10 +159,17 @@ uint8_t ps2_host_send(uint8_t data) {
 
     idle();
     PS2_INT_ON();
-    return ps2_host_recv_response();
+    data = ps2_host_recv_response();
+    if (packet_mode) {
+        ps2_host_set_packet_size(packet_mode);
+    }
+    return data;
 ERROR:
     idle();
     PS2_INT_ON();
+    if (packet_mode) {
+        ps2_host_set_packet_size(packet_mode);
+    }
     return 0;
 }
 
@@ -230,7 +246,7 @@ void ps2_interrupt_service_routine(void) {
             break;
         case STOP:
             if (!data_in()) goto ERROR;
-            pbuf_enqueue(data);
+            packet_receive(data);
             goto DONE;
             break;
         default:
@@ -239,6 +255,7 @@ void ps2_interrupt_service_routine(void) {
     goto RETURN;
 ERROR:
     ps2_error = state;
+    packet_abort();
 DONE:
     state  = INIT;
     data   = 0;
@@ -344,3 +361,132 @@ static inline void pbuf_clear(void) {
     chSysUnlock();
 #endif
 }
+
+/*--------------------------------------------------------------------
+ * Ring buffer to store whole packets from mouse
+ *
+ * With a packet size set, the interrupt handler puts the bytes together
+ * into packets, and only complete packets are queued.  The main loop then
+ * never has to wait for the rest of a packet, and a full buffer drops a
+ * whole packet rather than a byte in the middle of one.
+ *------------------------------------------------------------------*/
+static uint8_t packet_size = 0;
+static uint8_t packet_pos  = 0;
+static uint8_t packet[PS2_PACKET_MAX_SIZE];
+static uint8_t packet_buf[PS2_PACKET_BUFFER_SIZE][PS2_PACKET_MAX_SIZE];
+static uint8_t packet_buf_size = 0;
+static uint8_t packet_head     = 0;
+static uint8_t packet_tail     = 0;
+static uint8_t packet_dropped  = 0; // since the last ps2_host_recv_packet(), reported from there rather than the interrupt handler
+
+/* set bytes per packet, 3 or 4 for a mouse; 0 queues single bytes again, but keeps the packets queued so far */
+void ps2_host_set_packet_size(uint8_t size) {
+    if (size > PS2_PACKET_MAX_SIZE) {
+        size = PS2_PACKET_MAX_SIZE;
+    }
+
+#if defined(__AVR__)
+    uint8_t sreg = SREG;
+    cli();
+#elif defined(PROTOCOL_CHIBIOS)
+    chSysLock();
+#endif
+
+    packet_size = size;
+    packet_pos  = 0;
+    if (size && size != packet_buf_size) {
+        packet_buf_size = size;
+        packet_head = packet_tail = 0;
+    }
+    pbuf_head = pbuf_tail = 0;
+
+#if defined(__AVR__)
+    SREG = sreg;
+#elif defined(PROTOCOL_CHIBIOS)
+    chSysUnlock();
+#endif
+}
+
+/* get a packet received by interrupt, returns its size or 0 if there is none */
+uint8_t ps2_host_recv_packet(uint8_t *data) {
+    uint8_t size    = 0;
+    uint8_t dropped = 0;
+
+#if defined(__AVR__)
+    uint8_t sreg = SREG;
+    cli();
+#elif defined(PROTOCOL_CHIBIOS)
+    chSysLock();
+#endif
+
+    if (packet_head != packet_tail) {
+        size = packet_buf_size;
+        for (uint8_t i = 0; i < size; i++) {
+            data[i] = packet_buf[packet_tail][i];
+        }
+        packet_tail = (packet_tail + 1) % PS2_PACKET_BUFFER_SIZE;
+    }
+    dropped        = packet_dropped;
+    packet_dropped = 0;
+
+#if defined(__AVR__)
+    SREG = sreg;
+#elif defined(PROTOCOL_CHIBIOS)
+    chSysUnlock();
+#endif
+
+    if (dropped) {
+        xprintf("packet_buf: full, %u packets dropped\n", dropped);
+    }
+    return size;
+}
+
+static inline uint8_t packet_get_size(void) {
+    return packet_size;
+}
+
+/* called from the interrupt handler for every byte received */
+static inline void packet_receive(uint8_t data) {
+    if (!packet_size) {
+        pbuf_enqueue(data);
+        return;
+    }
+
+    // Bit 3 of the first byte is always set([1]), which finds the start of a packet again after a lost byte
+    if (packet_pos == 0 && !(data & 0x08)) {
+        return;
+    }
+    packet[packet_pos++] = data;
+    if (packet_pos < packet_size) {
+        return;
+    }
+    packet_pos = 0;
+
+#if defined(__AVR__)
+    uint8_t sreg = SREG;
+    cli();
+#elif defined(PROTOCOL_CHIBIOS)
+    chSysLockFromISR();
+#endif
+
+    uint8_t next = (packet_head + 1) % PS2_PACKET_BUFFER_SIZE;
+    if (next != packet_tail) {
+        for (uint8_t i = 0; i < packet_size; i++) {
+            packet_buf[packet_head][i] = packet[i];
+        }
+        packet_head = next;
+    } else if (packet_dropped < UINT8_MAX) {
+        packet_dropped++;
+    }
+
+#if defined(__AVR__)
+    SREG = sreg;
+#elif defined(PROTOCOL_CHIBIOS)
+    chSysUnlockFromISR();
+#endif
+}
+
+/* called from the interrupt handler on a framing error, the rest of the packet is unusable */
+static inline void packet_abort(void) {
+    packet_pos = 0;
+}
@@ -28,6 +28,17 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 /* ============================= MACROS ============================ */
 
+/* the interrupt driver puts the stream mode packets together itself */
+#if defined(PS2_DRIVER_INTERRUPT) && !defined(PS2_MOUSE_USE_REMOTE_MODE)
+#    define PS2_MOUSE_USE_PACKETS
+#endif
+
+#ifdef PS2_MOUSE_ENABLE_SCROLLING
+#    define PS2_MOUSE_PACKET_SIZE 4
+#else
+#    define PS2_MOUSE_PACKET_SIZE 3
+#endif
+
 static report_mouse_t mouse_report = {};
 
 static inline void ps2_mouse_print_report(report_mouse_t *mouse_report);
@@ -35,6 +46,10 @@ static inline void ps2_mouse_convert_report_to_hid(report_mouse_t *mouse_report)
 static inline void ps2_mouse_clear_report(report_mouse_t *mouse_report);
 static inline void ps2_mouse_enable_scrolling(void);
 static inline void ps2_mouse_scroll_button_task(report_mouse_t *mouse_report);
+static inline void ps2_mouse_process_report(report_mouse_t *mouse_report);
+#ifdef PS2_MOUSE_USE_PACKETS
+static inline void ps2_mouse_add_packet(report_mouse_t *mouse_report, const uint8_t *packet);
+#endif
 
 /* ============================= IMPLEMENTATION ============================ */
 
@@ -65,6 +80,10 @@ void ps2_mouse_init(void) {
 #endif
 
     ps2_mouse_init_user();
+
+#ifdef PS2_MOUSE_USE_PACKETS
+    ps2_host_set_packet_size(PS2_MOUSE_PACKET_SIZE);
+#endif
 }
 
 __attribute__((weak)) void ps2_mouse_init_user(void) {}
@@ -72,9 +91,6 @@ __attribute__((weak)) void ps2_mouse_init_user(void) {}
 __attribute__((weak)) void ps2_mouse_moved_user(report_mouse_t *mouse_report) {}
 
 void ps2_mouse_task(void) {
-    static uint8_t buttons_prev = 0;
-    extern int     tp_buttons;
-
     /* receives packet from mouse */
 #ifdef PS2_MOUSE_USE_REMOTE_MODE
     uint8_t rcv;
@@ -89,6 +105,18 @@ void ps2_mouse_task(void) {
     } else {
         if (debug_mouse) print("ps2_mouse: fail to get mouse packet\n");
     }
+#elif defined(PS2_MOUSE_USE_PACKETS)
+    /* drains whatever the interrupt handler has queued, without waiting for more */
+    uint8_t packet[PS2_PACKET_MAX_SIZE];
+    bool    pending = false;
+    while (ps2_host_recv_packet(packet)) {
+        // Button changes are reported one by one, the movement in between adds up
+        if (pending && ((packet[0] ^ mouse_report.buttons) & PS2_MOUSE_BTN_MASK)) {
+            ps2_mouse_process_report(&mouse_report);
+        }
+        ps2_mouse_add_packet(&mouse_report, packet);
+        pending = true;
+    }
 #else
     if (pbuf_has_data()) {
         mouse_report.buttons = ps2_host_recv_response();
@@ -102,29 +130,7 @@ void ps2_mouse_task(void) {
     }
 #endif
 
-    mouse_report.buttons |= tp_buttons;
-    /* if mouse moves or buttons state changes */
-    if (mouse_report.x || mouse_report.y || mouse_report.v || ((mouse_report.buttons ^ buttons_prev) & PS2_MOUSE_BTN_MASK)) {
-#ifdef PS2_MOUSE_DEBUG_RAW
-        // Used to debug raw ps2 bytes from mouse
-        ps2_mouse_print_report(&mouse_report);
-#endif
-        buttons_prev = mouse_report.buttons;
-        ps2_mouse_convert_report_to_hid(&mouse_report);
-#if PS2_MOUSE_SCROLL_BTN_MASK
-        ps2_mouse_scroll_button_task(&mouse_report);
-#endif
-        if (mouse_report.x || mouse_report.y || mouse_report.v) {
-            ps2_mouse_moved_user(&mouse_report);
-        }
-#ifdef PS2_MOUSE_DEBUG_HID
-        // Used to debug the bytes sent to the host
-        ps2_mouse_print_report(&mouse_report);
-#endif
-        host_mouse_send(&mouse_report);
-    }
-
-    ps2_mouse_clear_report(&mouse_report);
+    ps2_mouse_process_report(&mouse_report);
 }
 
 void ps2_mouse_disable_data_reporting(void) {
@@ -163,6 +169,69 @@ void ps2_mouse_set_sample_rate(ps2_mouse_sample_rate_t sample_rate) {
 
 /* ============================= HELPERS ============================ */
 
+static inline void ps2_mouse_process_report(report_mouse_t *mouse_report) {
+    static uint8_t buttons_prev = 0;
+    extern int     tp_buttons;
+
+    mouse_report->buttons |= tp_buttons;
+    /* if mouse moves or buttons state changes */
+    if (mouse_report->x || mouse_report->y || mouse_report->v || ((mouse_report->buttons ^ buttons_prev) & PS2_MOUSE_BTN_MASK)) {
+#ifdef PS2_MOUSE_DEBUG_RAW
+        // Used to debug raw ps2 bytes from mouse
+        ps2_mouse_print_report(mouse_report);
+#endif
+        buttons_prev = mouse_report->buttons;
+        ps2_mouse_convert_report_to_hid(mouse_report);
+#if PS2_MOUSE_SCROLL_BTN_MASK
+        ps2_mouse_scroll_button_task(mouse_report);
+#endif
+        if (mouse_report->x || mouse_report->y || mouse_report->v) {
+            ps2_mouse_moved_user(mouse_report);
+        }
+#ifdef PS2_MOUSE_DEBUG_HID
+        // Used to debug the bytes sent to the host
+        ps2_mouse_print_report(mouse_report);
+#endif
+        host_mouse_send(mouse_report);
+    }
+
+    ps2_mouse_clear_report(mouse_report);
+}
+
+#ifdef PS2_MOUSE_USE_PACKETS
+/* PS/2 movement is a 9-bit integer, the sign bit is in the first byte of the packet */
+static inline int16_t ps2_mouse_packet_value(uint8_t flags, uint8_t sign, uint8_t value) {
+    return (flags & (1 << sign)) ? value - 256 : value;
+}
+
+/* -256 would look like no movement at all */
+static inline int16_t ps2_mouse_packet_limit(int16_t value, uint8_t *flags, uint8_t sign, uint8_t overflow) {
+    if (value < -255 || value > 255) {
+        *flags |= (1 << overflow);
+        value = value < 0 ? -255 : 255;
+    }
+    if (value < 0) {
+        *flags |= (1 << sign);
+    }
+    return value;
+}
+
+/* Adds a packet to the movement in mouse_report, which is kept in the PS/2 format */
+static inline void ps2_mouse_add_packet(report_mouse_t *mouse_report, const uint8_t *packet) {
+    int16_t x     = ps2_mouse_packet_value(mouse_report->buttons, PS2_MOUSE_X_SIGN, mouse_report->x) + ps2_mouse_packet_value(packet[0], PS2_MOUSE_X_SIGN, packet[1]);
+    int16_t y     = ps2_mouse_packet_value(mouse_report->buttons, PS2_MOUSE_Y_SIGN, mouse_report->y) + ps2_mouse_packet_value(packet[0], PS2_MOUSE_Y_SIGN, packet[2]);
+    uint8_t flags = (packet[0] & ~((1 << PS2_MOUSE_X_SIGN) | (1 << PS2_MOUSE_Y_SIGN))) | (mouse_report->buttons & ((1 << PS2_MOUSE_X_OVFLW) | (1 << PS2_MOUSE_Y_OVFLW)));
+
+    mouse_report->x       = (uint8_t)ps2_mouse_packet_limit(x, &flags, PS2_MOUSE_X_SIGN, PS2_MOUSE_X_OVFLW);
+    mouse_report->y       = (uint8_t)ps2_mouse_packet_limit(y, &flags, PS2_MOUSE_Y_SIGN, PS2_MOUSE_Y_OVFLW);
+    mouse_report->buttons = flags;
+#    ifdef PS2_MOUSE_ENABLE_SCROLLING
+    int16_t v       = mouse_report->v + (int8_t)(-(packet[3] & PS2_MOUSE_SCROLL_MASK));
+    mouse_report->v = v < -127 ? -127 : (v > 127 ? 127 : v);
+#    endif
+}
+#endif
+
 #define X_IS_NEG (mouse_report->buttons & (1 << PS2_MOUSE_X_SIGN))
 #define Y_IS_NEG (mouse_report->buttons & (1 << PS2_MOUSE_Y_SIGN))
 #define X_IS_OVF (mouse_report->buttons & (1 << PS2_MOUSE_X_OVFLW))
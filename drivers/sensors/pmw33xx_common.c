@@ -12,6 +12,7 @@
 #include "pmw33xx_common.h"
 #include "string.h"
 #include "wait.h"
+#include "gpio.h"
 #include "spi_master.h"
 #include "progmem.h"
 
@@ -24,6 +25,14 @@ static const pin_t cs_pins_right[] = PMW33XX_CS_PINS_RIGHT;
 static bool in_burst_left[ARRAY_SIZE(cs_pins_left)]   = {0};
 static bool in_burst_right[ARRAY_SIZE(cs_pins_right)] = {0};
 
+#ifdef PMW33XX_MOTION_PINS
+static const pin_t motion_pins_left[]  = PMW33XX_MOTION_PINS;
+static const pin_t motion_pins_right[] = PMW33XX_MOTION_PINS_RIGHT;
+
+_Static_assert(ARRAY_SIZE(motion_pins_left) == ARRAY_SIZE(cs_pins_left), "PMW33XX_MOTION_PINS must have one pin per sensor");
+_Static_assert(ARRAY_SIZE(motion_pins_right) == ARRAY_SIZE(cs_pins_right), "PMW33XX_MOTION_PINS_RIGHT must have one pin per sensor");
+#endif
+
 bool __attribute__((cold)) pmw33xx_upload_firmware(uint8_t sensor);
 bool __attribute__((cold)) pmw33xx_check_signature(uint8_t sensor);
 
@@ -132,6 +141,9 @@ bool pmw33xx_init(uint8_t sensor) {
         return false;
     }
     spi_init();
+#ifdef PMW33XX_MOTION_PINS
+    gpio_set_pin_input_high(motion_pins[sensor]);
+#endif
 
     // power up, need to first drive NCS high then low. the datasheet does not
     // say for how long, 40us works well in practice.
@@ -185,6 +197,14 @@ pmw33xx_report_t pmw33xx_read_burst(uint8_t sensor) {
         return report;
     }
 
+#ifdef PMW33XX_MOTION_PINS
+    // MOTION stays asserted until the burst read below, so an idle sensor
+    // never has to be selected and the bus stays free for other devices.
+    if (gpio_read_pin(motion_pins[sensor])) {
+        return report;
+    }
+#endif
+
     if (!in_burst[sensor]) {
         pd_dprintf("PMW33XX (%d): burst\n", sensor);
         if (!pmw33xx_write(sensor, REG_Motion_Burst, 0x00)) {
@@ -202,8 +222,10 @@ pmw33xx_report_t pmw33xx_read_burst(uint8_t sensor) {
 
     spi_receive((uint8_t*)&report, sizeof(report));
 
-    // panic recovery, sometimes burst mode works weird.
-    if (report.motion.w & 0b111) {
+    // panic recovery, sometimes burst mode works weird. OP_MODE is left out
+    // as it is non-zero whenever the sensor is resting, which is not an error
+    // and would otherwise re-arm burst mode on every idle poll.
+    if (report.motion.b.capture_from_raw_data) {
         in_burst[sensor] = false;
     }
 
@@ -90,8 +90,28 @@ _Static_assert(sizeof((pmw33xx_report_t){0}.motion) == 1, "pmw33xx_report_t.moti
         { PMW33XX_CS_PIN_RIGHT }
 #endif
 
+// Optional MOTION pins, one per sensor. The sensor pulls MOTION low until the
+// motion registers are read, so reads are skipped entirely while it is high.
+#if !defined(PMW33XX_MOTION_PINS) && defined(PMW33XX_MOTION_PIN)
+#    define PMW33XX_MOTION_PINS \
+        { PMW33XX_MOTION_PIN }
+#endif
+
+#if defined(PMW33XX_MOTION_PINS) && !defined(PMW33XX_MOTION_PINS_RIGHT)
+#    if !defined(PMW33XX_MOTION_PIN_RIGHT) && defined(PMW33XX_MOTION_PIN)
+#        define PMW33XX_MOTION_PIN_RIGHT PMW33XX_MOTION_PIN
+#    endif
+#    if defined(PMW33XX_MOTION_PIN_RIGHT)
+#        define PMW33XX_MOTION_PINS_RIGHT \
+            { PMW33XX_MOTION_PIN_RIGHT }
+#    else
+#        define PMW33XX_MOTION_PINS_RIGHT PMW33XX_MOTION_PINS
+#    endif
+#endif
+
 // Defines so the old variable names are swapped by the appropiate value on each half
 #define cs_pins (is_keyboard_left() ? cs_pins_left : cs_pins_right)
+#define motion_pins (is_keyboard_left() ? motion_pins_left : motion_pins_right)
 #define in_burst (is_keyboard_left() ? in_burst_left : in_burst_right)
 #define pmw33xx_number_of_sensors (is_keyboard_left() ? ARRAY_SIZE((pin_t[])PMW33XX_CS_PINS) : ARRAY_SIZE((pin_t[])PMW33XX_CS_PINS_RIGHT))
 
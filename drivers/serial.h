@@ -28,6 +28,9 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+// target side work that can't be done from an interrupt, called from the main loop
+void soft_serial_target_task(void);
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -44,7 +44,7 @@ void dance_cln_finished(tap_dance_state_t *state, void *user_data) {
 }
 
 /* All tap dance functions would go here. Only showing this one. */
-tap_dance_action_t tap_dance_actions[] = {
+const tap_dance_action_t PROGMEM tap_dance_actions[] = {
     [TD_PLAY_FORWARD_BACK] = ACTION_TAP_DANCE_FN_ADVANCED(NULL, dance_cln_finished, NULL),
 };
 
@@ -147,6 +147,17 @@ class QGFFrameDescriptorV1:
         else:
             self.flags &= ~0x02
 
+    @property
+    def is_tiled(self):
+        return (self.flags & 0x04) == 0x04
+
+    @is_tiled.setter
+    def is_tiled(self, val):
+        if val:
+            self.flags |= 0x04
+        else:
+            self.flags &= ~0x04
+
 
 ########################################################################################################################
 
@@ -208,6 +219,30 @@ class QGFFrameDeltaDescriptorV1:
 ########################################################################################################################
 
 
+class QGFFrameDeltaTilesDescriptorV1:
+    type_id = 0x06
+    tile_length = 8
+
+    def __init__(self):
+        self.header = QGFBlockHeader()
+        self.header.type_id = QGFFrameDeltaTilesDescriptorV1.type_id
+        self.tiles = []
+
+    def write(self, fp):
+        self.header.length = len(self.tiles) * QGFFrameDeltaTilesDescriptorV1.tile_length
+        self.header.write(fp)
+        for tile in self.tiles:
+            fp.write(b''  # start off with empty bytes...
+                     + o16(tile[0])  # left
+                     + o16(tile[1])  # top
+                     + o16(tile[2])  # right
+                     + o16(tile[3])  # bottom
+                     )
+
+
+########################################################################################################################
+
+
 class QGFFrameDataDescriptorV1:
     type_id = 0x05
 
@@ -260,7 +295,55 @@ def _for_all_frames(x: FunctionType, /, images):
             frame_num += 1
 
 
-def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwargs):
+# Tile sizes tried when splitting a delta frame into tiles, the smallest output wins
+_DELTA_TILE_SIZES = (8, 16, 32, 64)
+
+
+def _find_delta_tiles(diff, tile_size):
+    """Splits the changed area of a frame into tiles.
+
+    The frame is walked as a grid of `tile_size` squares; horizontally-adjacent changed squares are merged into a single
+    tile, which is then shrunk to the bounding box of the changes it contains. Returned boxes use PIL's exclusive
+    right/bottom convention.
+    """
+    width, height = diff.size
+    tiles = []
+    for top in range(0, height, tile_size):
+        bottom = min(top + tile_size, height)
+        run_left = None
+        for left in range(0, width, tile_size):
+            right = min(left + tile_size, width)
+            changed = diff.crop((left, top, right, bottom)).getbbox() is not None
+            if changed and run_left is None:
+                run_left = left
+            if run_left is not None and (not changed or right == width):
+                run_right = right if changed else left
+                bbox = diff.crop((run_left, top, run_right, bottom)).getbbox()
+                tiles.append((run_left + bbox[0], top + bbox[1], run_left + bbox[2], top + bbox[3]))
+                run_left = None
+    return tiles
+
+
+def _compress_tiles(converted, tiles, *, use_rle, format_):
+    """Encodes each tile of an already-converted frame, so that all tiles share the frame's palette.
+
+    Returns the per-tile data, whether it is raw (as opposed to RLE), and the total number of bytes including block
+    headers.
+    """
+    raw_tiles = [qmk.painter.convert_image_bytes(converted.crop(tile), format_)[1] for tile in tiles]
+    tile_data = raw_tiles
+    use_raw = True
+    if use_rle:
+        rle_tiles = [qmk.painter.compress_bytes_qmk_rle(data) for data in raw_tiles]
+        if sum(map(len, rle_tiles)) < sum(map(len, raw_tiles)):
+            tile_data = rle_tiles
+            use_raw = False
+
+    total_size = QGFBlockHeader.block_size + len(tiles) * (QGFFrameDeltaTilesDescriptorV1.tile_length + QGFBlockHeader.block_size) + sum(map(len, tile_data))
+    return tile_data, use_raw, total_size
+
+
+def _compress_image(frame, last_frame, *, use_rle, use_deltas, use_tiles, format_, **_kwargs):
     # Convert the original frame so we can do comparisons
     converted = qmk.painter.convert_requested_format(frame, format_)
     graphic_data = qmk.painter.convert_image_bytes(converted, format_)
@@ -272,8 +355,13 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
     use_raw_this_frame = not use_rle or len(raw_data) <= len(rle_data)
     image_data = raw_data if use_raw_this_frame else rle_data
 
+    # Tiles are cropped from the whole converted frame, so keep hold of its palette
+    frame_graphic_data = graphic_data
+
     # Work out if a delta frame is smaller than injecting it directly
     use_delta_this_frame = False
+    use_tiles_this_frame = False
+    tiles = None
     bbox = None
     if use_deltas and last_frame is not None:
         # If we want to use deltas, then find the difference
@@ -282,6 +370,17 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
         # Get the bounding box of those differences
         bbox = diff.getbbox()
 
+        # Work out the smallest tiled encoding, if requested
+        if use_tiles:
+            best_size = QGFBlockHeader.block_size + len(image_data)
+            for tile_size in _DELTA_TILE_SIZES:
+                candidate_tiles = _find_delta_tiles(diff, tile_size)
+                candidate_data, candidate_raw, candidate_size = _compress_tiles(converted, candidate_tiles, use_rle=use_rle, format_=format_)
+                if candidate_size < best_size:
+                    best_size = candidate_size
+                    tiles = [((t[0], t[1], t[2] - 1, t[3] - 1), data) for t, data in zip(candidate_tiles, candidate_data)]
+                    tiles_raw = candidate_raw
+
         # If we have a valid bounding box...
         if bbox:
             # ...create the delta frame by cropping the original.
@@ -310,6 +409,15 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
                 image_data = delta_image_data
                 use_delta_this_frame = True
 
+        # Prefer tiles if they end up smaller than the single delta frame (plus delta and data blocks) or whole frame
+        if tiles is not None:
+            delta_size = (QGFBlockHeader.block_size + QGFFrameDeltaDescriptorV1.length if use_delta_this_frame else 0) + QGFBlockHeader.block_size + len(image_data)
+            if best_size < delta_size:
+                use_delta_this_frame = False
+                use_tiles_this_frame = True
+                use_raw_this_frame = tiles_raw
+                graphic_data = frame_graphic_data
+
         # Default to whole image
         bbox = bbox or [0, 0, *frame.size]
         # Fix sze (as per #20296), we need to cast first as tuples are inmutable
@@ -321,7 +429,9 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
         "bbox": bbox,
         "graphic_data": graphic_data,
         "image_data": image_data,
+        "tiles": tiles,
         "use_delta_this_frame": use_delta_this_frame,
+        "use_tiles_this_frame": use_tiles_this_frame,
         "use_raw_this_frame": use_raw_this_frame,
     }
 
@@ -337,6 +447,7 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, **kwargs):
     graphic_data = outputs["graphic_data"]
     image_data = outputs["image_data"]
     use_delta_this_frame = outputs["use_delta_this_frame"]
+    use_tiles_this_frame = outputs["use_tiles_this_frame"]
     use_raw_this_frame = outputs["use_raw_this_frame"]
 
     # Write out the frame descriptor
@@ -344,6 +455,7 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, **kwargs):
     vprint(f'{f"Frame {idx:3d} base":26s} {fp.tell():5d}d / {fp.tell():04X}h')
     frame_descriptor = QGFFrameDescriptorV1()
     frame_descriptor.is_delta = use_delta_this_frame
+    frame_descriptor.is_tiled = use_tiles_this_frame
     frame_descriptor.is_transparent = False
     frame_descriptor.format = format_['image_format_byte']
     frame_descriptor.compression = 0x00 if use_raw_this_frame else 0x01  # See qp.h, painter_compression_t
@@ -370,6 +482,21 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, **kwargs):
         vprint(f'{f"Frame {idx:3d} delta":26s} {fp.tell():5d}d / {fp.tell():04X}h')
         delta_descriptor.write(fp)
 
+    # Write out the tile locations, followed by each tile's data, if required
+    if use_tiles_this_frame:
+        tiles = outputs["tiles"]
+        tiles_descriptor = QGFFrameDeltaTilesDescriptorV1()
+        tiles_descriptor.tiles = [tile for tile, _ in tiles]
+        vprint(f'{f"Frame {idx:3d} tiles ({len(tiles)})":26s} {fp.tell():5d}d / {fp.tell():04X}h')
+        tiles_descriptor.write(fp)
+
+        for tile_idx, (_, tile_data) in enumerate(tiles):
+            data_descriptor = QGFFrameDataDescriptorV1()
+            data_descriptor.data = tile_data
+            vprint(f'{f"Frame {idx:3d} tile {tile_idx:3d} data":26s} {fp.tell():5d}d / {fp.tell():04X}h')
+            data_descriptor.write(fp)
+        return
+
     # Write out the data for this frame to the output
     data_descriptor = QGFFrameDataDescriptorV1()
     data_descriptor.data = image_data
@@ -417,7 +544,7 @@ def _save(im, fp, _filename):
     frame_offsets.write(fp)
 
     # Iterate over each if the input frames, writing it to the output in the process
-    write_frame = functools.partial(_write_frame, format_=encoderinfo["qmk_format"], fp=fp, use_deltas=encoderinfo.get("use_deltas", True), use_rle=encoderinfo.get("use_rle", True), frame_offsets=frame_offsets)
+    write_frame = functools.partial(_write_frame, format_=encoderinfo["qmk_format"], fp=fp, use_deltas=encoderinfo.get("use_deltas", True), use_tiles=encoderinfo.get("use_tiles", True), use_rle=encoderinfo.get("use_rle", True), frame_offsets=frame_offsets)
     for_all_frames(write_frame)
 
     # Go back and update the graphics descriptor now that we can determine the final file size
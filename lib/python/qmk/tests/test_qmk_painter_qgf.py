@@ -0,0 +1,102 @@
+import re
+from io import BytesIO
+from pathlib import Path
+
+from PIL import Image, ImageChops
+
+import qmk.painter_qgf  # noqa: F401 -- registers the QGF format with PIL
+from qmk.painter import valid_formats
+
+# Animation also decoded by the Quantum Painter tests, whose frames only change a few small areas
+TILED_ANIMATION = Path('quantum/painter/tests/tiled_animation.gif')
+
+QGF_FRAME_FLAG_DELTA = 0x02
+QGF_FRAME_FLAG_TILED = 0x04
+
+
+def _encode(image, **kwargs):
+    out = BytesIO()
+    image.save(out, 'QGF', qmk_format=valid_formats['rgb565'], **kwargs)
+    return out.getvalue()
+
+
+def _u16(data, offset):
+    return int.from_bytes(data[offset:offset + 2], 'little')
+
+
+def _block(data, offset, type_id):
+    """Checks the block header at `offset`, returning the offset of its contents and their length.
+    """
+    assert data[offset] == type_id
+    assert data[offset + 1] == (~type_id & 0xFF)
+    return offset + 5, int.from_bytes(data[offset + 2:offset + 5], 'little')
+
+
+def _read_frames(data):
+    """Walks the frames of a QGF file, returning the flags, tile locations and data lengths of each.
+    """
+    frame_count = _u16(data, 21)
+    offsets, _ = _block(data, 23, 0x01)
+    frames = []
+    for idx in range(frame_count):
+        offset, _ = _block(data, int.from_bytes(data[offsets + idx * 4:offsets + idx * 4 + 4], 'little'), 0x02)
+        frame = {'flags': data[offset + 1], 'compression': data[offset + 2], 'tiles': [], 'data': []}
+        offset += 6
+
+        if frame['flags'] & QGF_FRAME_FLAG_DELTA:
+            offset, length = _block(data, offset, 0x04)
+            offset += length
+
+        if frame['flags'] & QGF_FRAME_FLAG_TILED:
+            offset, length = _block(data, offset, 0x06)
+            frame['tiles'] = [tuple(_u16(data, offset + i * 8 + j * 2) for j in range(4)) for i in range(length // 8)]
+            offset += length
+
+        for _ in range(max(len(frame['tiles']), 1)):
+            offset, length = _block(data, offset, 0x05)
+            frame['data'].append(length)
+            offset += length
+
+        frames.append(frame)
+    return frames
+
+
+def _changed_pixels(frame, last_frame):
+    diff = ImageChops.difference(frame.convert('RGB'), last_frame.convert('RGB')).convert('L')
+    return {(x, y) for y in range(frame.height) for x in range(frame.width) if diff.getpixel((x, y))}
+
+
+def test_tiled_delta_frames():
+    image = Image.open(TILED_ANIMATION)
+    frames = _read_frames(_encode(image))
+    assert len(frames) == 3
+
+    assert frames[0]['flags'] == 0
+    assert frames[1]['flags'] == QGF_FRAME_FLAG_TILED
+    assert frames[1]['tiles'] == [(2, 2, 5, 5), (25, 11, 27, 12)]
+    assert frames[2]['flags'] == QGF_FRAME_FLAG_TILED
+    assert frames[2]['tiles'] == [(2, 2, 5, 5), (16, 0, 17, 1)]
+
+    for idx in (1, 2):
+        # Every changed pixel is covered by a tile, and each tile has its own data block
+        image.seek(idx - 1)
+        last_frame = image.convert('RGB')
+        image.seek(idx)
+        covered = {(x, y) for (left, top, right, bottom) in frames[idx]['tiles'] for y in range(top, bottom + 1) for x in range(left, right + 1)}
+        assert _changed_pixels(image, last_frame) <= covered
+
+        if frames[idx]['compression'] == 0x00:
+            assert frames[idx]['data'] == [(right - left + 1) * (bottom - top + 1) * 2 for (left, top, right, bottom) in frames[idx]['tiles']]
+
+
+def test_tiled_delta_frames_disabled():
+    frames = _read_frames(_encode(Image.open(TILED_ANIMATION), use_tiles=False))
+    assert not any(frame['flags'] & QGF_FRAME_FLAG_TILED for frame in frames)
+
+
+def test_tiled_animation_source_is_up_to_date():
+    # The Quantum Painter tests decode the generated source, so it has to match what the encoder produces now.
+    # Regenerate it with `qmk painter-convert-graphics -i quantum/painter/tests/tiled_animation.gif -f rgb565` if this fails.
+    source = TILED_ANIMATION.with_suffix('.qgf.c').read_text()
+    generated = bytes(int(byte, 16) for byte in re.findall(r'0x([0-9A-F]{2}),', source.split('] = {', 1)[1]))
+    assert generated == _encode(Image.open(TILED_ANIMATION))
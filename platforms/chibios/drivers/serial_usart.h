@@ -44,7 +44,16 @@
 #    define SERIAL_USART_TIMEOUT 20
 #endif
 
-#if HAL_USE_SERIAL
+#if defined(SERIAL_DRIVER_USART_DMA)
+
+typedef UARTDriver QMKSerialDriver;
+typedef UARTConfig QMKSerialConfig;
+
+#    if !defined(SERIAL_USART_DRIVER)
+#        define SERIAL_USART_DRIVER UARTD1
+#    endif
+
+#elif HAL_USE_SERIAL
 
 typedef SerialDriver QMKSerialDriver;
 typedef SerialConfig QMKSerialConfig;
@@ -0,0 +1,426 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+ * Split transport on top of the ChibiOS UART driver, which moves every byte
+ * with DMA. The transaction buffers in split_shmem are handed to the DMA as
+ * they are, and the slave answers from the UART interrupts instead of a
+ * thread of its own.
+ *
+ * A transaction is a single round trip:
+ *   master -> slave: [id][initiator2target buffer]
+ *   slave -> master: [id ^ NUM_TOTAL_TRANSACTIONS][target2initiator buffer]
+ *
+ * Transactions without a slave callback don't depend on what the master
+ * sends, so the slave starts its answer as soon as it has the id and both
+ * directions run at the same time. Slave callbacks can't run in an
+ * interrupt, soft_serial_target_task() calls them from the main loop.
+ */
+
+#include "serial_usart.h"
+#include "synchronization_util.h"
+#include "chibios_config.h"
+#include <string.h>
+
+#if !defined(SERIAL_USART_FULL_DUPLEX)
+#    error The usart_dma driver sends and receives at the same time, wire up the halves as for SERIAL_USART_FULL_DUPLEX and define it.
+#endif
+
+#if !HAL_USE_UART
+#    error The UART driver has to be activated to use the usart_dma driver for split keyboards.
+#endif
+
+/* The callbacks are filled in by the init functions. */
+#if defined(SERIAL_USART_CONFIG)
+static QMKSerialConfig serial_config = SERIAL_USART_CONFIG;
+#elif defined(MCU_STM32) /* STM32 MCUs */
+static QMKSerialConfig serial_config = {
+    .speed = (SERIAL_USART_SPEED),
+    .cr1   = (SERIAL_USART_CR1),
+    .cr2   = (SERIAL_USART_CR2),
+    .cr3   = (SERIAL_USART_CR3),
+};
+#else
+#    error MCU Familiy not supported by default, supply your own serial_config by defining SERIAL_USART_CONFIG in your keyboard files.
+#endif
+
+static QMKSerialDriver* serial_driver = (QMKSerialDriver*)&SERIAL_USART_DRIVER;
+
+/* Parts of the transaction in flight that are still outstanding. */
+#define OUTSTANDING_RX 0x01
+#define OUTSTANDING_TX 0x02
+#define OUTSTANDING_CALLBACK 0x04
+/* An initiator2target buffer in rx_staging that still has to go to split_shmem. */
+#define OUTSTANDING_COPY 0x08
+/* Parts during which the DMA reads or writes split_shmem. */
+#define OUTSTANDING_DMA (OUTSTANDING_RX | OUTSTANDING_TX)
+
+static bool                      is_master;
+static split_transaction_desc_t* transaction;
+static volatile uint8_t          outstanding;
+/* Set while a thread holds the split shared memory. */
+static bool locked;
+/* Slave answer that has to wait for the split shared memory to be released. */
+static bool reply_deferred;
+
+/* The DMA needs the one byte headers to stay put while it runs. */
+static uint8_t tx_header;
+static uint8_t rx_header;
+/* Buffers that follow the headers. */
+static const uint8_t* tx_body;
+static size_t         tx_body_size;
+static uint8_t*       rx_body;
+static size_t         rx_body_size;
+static bool           rx_expects_header;
+/* Slave side, takes the initiator2target buffer while a thread holds split_shmem. */
+static uint8_t        rx_staging[UINT8_MAX];
+
+static threads_queue_t    lock_queue;
+static thread_reference_t master_thread;
+static virtual_timer_t    slave_timeout;
+
+/**
+ * @brief Acquire exclusive access to the split keyboard shared memory. Takes
+ * the place of the mutex in synchronization_util.c, as the DMA started from
+ * the UART interrupts accesses split_shmem as well. A transfer that is running
+ * is waited for. A slave transaction that comes in while the memory is held is
+ * received on the side, copied over and answered once it is released.
+ */
+void split_shared_memory_lock(void) {
+    osalSysLock();
+    while (locked || (outstanding & OUTSTANDING_DMA)) {
+        (void)osalThreadEnqueueTimeoutS(&lock_queue, TIME_INFINITE);
+    }
+    locked = true;
+    osalSysUnlock();
+}
+
+static void start_reply_i(void);
+static void copy_staged_i(void);
+
+/**
+ * @brief Release the split shared memory that has been acquired before.
+ */
+void split_shared_memory_unlock(void) {
+    osalSysLock();
+    locked = false;
+    if ((outstanding & OUTSTANDING_COPY) && !(outstanding & OUTSTANDING_RX)) {
+        copy_staged_i();
+    }
+    if (reply_deferred) {
+        reply_deferred = false;
+        start_reply_i();
+    }
+    osalThreadDequeueNextI(&lock_queue, MSG_OK);
+    osalOsRescheduleS();
+    osalSysUnlock();
+}
+
+static inline void start_send_i(const uint8_t* body, size_t body_size) {
+    outstanding |= OUTSTANDING_TX;
+    tx_body      = body;
+    tx_body_size = body_size;
+    uartStartSendI(serial_driver, sizeof(tx_header), &tx_header);
+}
+
+static inline void start_receive_i(uint8_t* destination, size_t size, bool header) {
+    outstanding |= OUTSTANDING_RX;
+    rx_expects_header = header;
+    if (header) {
+        rx_body      = destination;
+        rx_body_size = size;
+        uartStartReceiveI(serial_driver, sizeof(rx_header), &rx_header);
+    } else {
+        rx_body_size = 0;
+        uartStartReceiveI(serial_driver, size, destination);
+    }
+}
+
+/**
+ * @brief Called with the system locked whenever a part of the transaction has
+ * completed.
+ */
+static void part_done_i(uint8_t part) {
+    outstanding &= ~part;
+
+    if (!(outstanding & OUTSTANDING_DMA)) {
+        /* Threads waiting for the split shared memory may go ahead, even if a
+         * slave callback is still due - soft_serial_target_task() needs it. */
+        osalThreadDequeueAllI(&lock_queue, MSG_OK);
+    }
+
+    if (outstanding == 0) {
+        if (is_master) {
+            osalThreadResumeI(&master_thread, MSG_OK);
+        } else {
+            chVTResetI(&slave_timeout);
+        }
+        transaction = NULL;
+    }
+}
+
+/**
+ * @brief Called with the system locked to give up on the transaction in
+ * flight, after a timeout or a receive error.
+ */
+static void abort_i(msg_t reason) {
+    uartStopSendI(serial_driver);
+    uartStopReceiveI(serial_driver);
+    outstanding    = 0;
+    reply_deferred = false;
+    transaction    = NULL;
+    osalThreadDequeueAllI(&lock_queue, MSG_OK);
+    if (is_master) {
+        osalThreadResumeI(&master_thread, reason);
+    } else {
+        chVTResetI(&slave_timeout);
+    }
+}
+
+static void slave_timeout_cb(struct ch_virtual_timer* timer, void* arg) {
+    (void)timer;
+    (void)arg;
+    osalSysLockFromISR();
+    abort_i(MSG_TIMEOUT);
+    osalSysUnlockFromISR();
+}
+
+/**
+ * @brief Moves an initiator2target buffer that was received while split_shmem
+ * was held to where the transaction expects it.
+ */
+static void copy_staged_i(void) {
+    memcpy(split_trans_initiator2target_buffer(transaction), rx_staging, transaction->initiator2target_buffer_size);
+    part_done_i(OUTSTANDING_COPY);
+}
+
+/**
+ * @brief Starts the slave answer, straight out of the target2initiator buffer.
+ */
+static void start_reply_i(void) {
+    start_send_i(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size);
+}
+
+/**
+ * @brief The id of a new transaction arrived on the slave.
+ */
+static void begin_slave_transaction_i(uint8_t transaction_id) {
+    transaction = &split_transaction_table[transaction_id];
+    tx_header   = transaction_id ^ NUM_TOTAL_TRANSACTIONS;
+    outstanding = 0;
+    chVTSetI(&slave_timeout, TIME_MS2I(SERIAL_USART_TIMEOUT), slave_timeout_cb, NULL);
+
+    /* The DMA writes straight into split_shmem, unless a thread holds it right
+     * now. The buffer can't wait in the UART until the thread is done, so it is
+     * received on the side and copied over once it is released. */
+    if (transaction->initiator2target_buffer_size) {
+        if (locked) {
+            outstanding |= OUTSTANDING_COPY;
+            start_receive_i(rx_staging, transaction->initiator2target_buffer_size, false);
+        } else {
+            start_receive_i(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size, false);
+        }
+    }
+
+    if (transaction->slave_callback) {
+        /* Answered by soft_serial_target_task(), once the buffer is in. */
+        outstanding |= OUTSTANDING_CALLBACK;
+    } else if (locked) {
+        outstanding |= OUTSTANDING_TX;
+        reply_deferred = true;
+    } else {
+        start_reply_i();
+    }
+}
+
+static void serial_txend_cb(UARTDriver* uartp) {
+    osalSysLockFromISR();
+    if (tx_body_size && (outstanding & OUTSTANDING_TX)) {
+        size_t size  = tx_body_size;
+        tx_body_size = 0;
+        uartStartSendI(uartp, size, tx_body);
+    } else if (outstanding & OUTSTANDING_TX) {
+        part_done_i(OUTSTANDING_TX);
+    }
+    osalSysUnlockFromISR();
+}
+
+static void serial_rxend_cb(UARTDriver* uartp) {
+    osalSysLockFromISR();
+    if (!(outstanding & OUTSTANDING_RX)) {
+        /* Stale completion of a transaction that has been aborted. */
+    } else if (rx_expects_header) {
+        if (rx_header != (tx_header ^ NUM_TOTAL_TRANSACTIONS)) {
+            serial_dprintf("SPLIT: receiving handshake failed\n");
+            abort_i(MSG_RESET);
+        } else if (rx_body_size) {
+            start_receive_i(rx_body, rx_body_size, false);
+        } else {
+            part_done_i(OUTSTANDING_RX);
+        }
+    } else {
+        part_done_i(OUTSTANDING_RX);
+        /* Otherwise copied over by split_shared_memory_unlock(). */
+        if ((outstanding & OUTSTANDING_COPY) && !locked) {
+            copy_staged_i();
+        }
+    }
+    osalSysUnlockFromISR();
+}
+
+/**
+ * @brief Called for every byte that arrives while no receive is running. On
+ * the slave this is the id that starts a transaction.
+ */
+static void serial_rxchar_cb(UARTDriver* uartp, uint16_t c) {
+    (void)uartp;
+    osalSysLockFromISR();
+    if (!is_master && transaction == NULL && (uint8_t)c < NUM_TOTAL_TRANSACTIONS) {
+        begin_slave_transaction_i((uint8_t)c);
+    }
+    osalSysUnlockFromISR();
+}
+
+static void serial_rxerr_cb(UARTDriver* uartp, uartflags_t e) {
+    (void)uartp;
+    (void)e;
+    osalSysLockFromISR();
+    if (transaction != NULL) {
+        abort_i(MSG_RESET);
+    }
+    osalSysUnlockFromISR();
+}
+
+/**
+ * @brief Runs the slave callback of the transaction in flight, if it is due,
+ * and sends the answer. Called from the slave main loop.
+ */
+void soft_serial_target_task(void) {
+    if (!(outstanding & OUTSTANDING_CALLBACK) || (outstanding & (OUTSTANDING_RX | OUTSTANDING_COPY))) {
+        return;
+    }
+
+    split_shared_memory_lock();
+
+    osalSysLock();
+    split_transaction_desc_t* trans = (outstanding & OUTSTANDING_CALLBACK) ? transaction : NULL;
+    osalSysUnlock();
+
+    if (trans) {
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+
+        osalSysLock();
+        /* Unless the master gave up in the meantime. */
+        if (transaction == trans && (outstanding & OUTSTANDING_CALLBACK)) {
+            outstanding &= ~OUTSTANDING_CALLBACK;
+            start_reply_i();
+        }
+        osalSysUnlock();
+    }
+
+    split_shared_memory_unlock();
+}
+
+/**
+ * @brief Start transaction from the master half to the slave half.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool Indicates success of transaction.
+ */
+bool soft_serial_transaction(int index) {
+    /* Sanity check that we are actually starting a valid transaction. */
+    if (unlikely(index < 0 || index >= NUM_TOTAL_TRANSACTIONS)) {
+        serial_dprintf("SPLIT: illegal transaction id\n");
+        return false;
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    osalSysLock();
+    transaction = &split_transaction_table[index];
+    tx_header   = (uint8_t)index;
+    outstanding = 0;
+    /* Listen before talking, the answer may start before the buffer is out. */
+    start_receive_i(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size, true);
+    start_send_i(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size);
+    msg_t msg = osalThreadSuspendTimeoutS(&master_thread, TIME_MS2I(SERIAL_USART_TIMEOUT));
+    if (unlikely(msg == MSG_TIMEOUT)) {
+        serial_dprintf("SPLIT: transaction timed out\n");
+        abort_i(MSG_TIMEOUT);
+    }
+    osalSysUnlock();
+
+    return msg == MSG_OK;
+}
+
+/**
+ * @brief Initiate pins for USART peripheral. Full-duplex configuration.
+ */
+__attribute__((weak)) void usart_init(void) {
+#if defined(USE_GPIOV1)
+    palSetLineMode(SERIAL_USART_TX_PIN, PAL_MODE_ALTERNATE_PUSHPULL);
+    palSetLineMode(SERIAL_USART_RX_PIN, PAL_MODE_INPUT);
+#else
+    palSetLineMode(SERIAL_USART_TX_PIN, PAL_MODE_ALTERNATE(SERIAL_USART_TX_PAL_MODE) | PAL_OUTPUT_TYPE_PUSHPULL | PAL_OUTPUT_SPEED_HIGHEST);
+    palSetLineMode(SERIAL_USART_RX_PIN, PAL_MODE_ALTERNATE(SERIAL_USART_RX_PAL_MODE) | PAL_OUTPUT_TYPE_PUSHPULL | PAL_OUTPUT_SPEED_HIGHEST);
+#endif
+
+#if defined(USART_REMAP)
+    USART_REMAP;
+#endif
+}
+
+/**
+ * @brief Overridable master specific initializations.
+ */
+__attribute__((weak, nonnull)) void usart_master_init(QMKSerialDriver** driver) {
+    (void)driver;
+    usart_init();
+}
+
+/**
+ * @brief Overridable slave specific initializations.
+ */
+__attribute__((weak, nonnull)) void usart_slave_init(QMKSerialDriver** driver) {
+    (void)driver;
+    usart_init();
+}
+
+/**
+ * @brief UART Driver startup routine.
+ */
+static inline void usart_driver_start(void) {
+    serial_config.txend1_cb = serial_txend_cb;
+    serial_config.rxend_cb  = serial_rxend_cb;
+    serial_config.rxchar_cb = serial_rxchar_cb;
+    serial_config.rxerr_cb  = serial_rxerr_cb;
+    uartStart(serial_driver, &serial_config);
+}
+
+/**
+ * @brief Slave specific initializations.
+ */
+void soft_serial_target_init(void) {
+    osalThreadQueueObjectInit(&lock_queue);
+    chVTObjectInit(&slave_timeout);
+    is_master = false;
+
+    usart_slave_init(&serial_driver);
+    usart_driver_start();
+}
+
+/**
+ * @brief Master specific initializations.
+ */
+void soft_serial_initiator_init(void) {
+    osalThreadQueueObjectInit(&lock_queue);
+    is_master = true;
+
+    usart_master_init(&serial_driver);
+
+#if defined(MCU_STM32) && defined(SERIAL_USART_PIN_SWAP)
+    serial_config.cr2 |= USART_CR2_SWAP; // master has swapped TX/RX pins
+#endif
+
+    usart_driver_start();
+}
@@ -4,7 +4,8 @@
 #include "synchronization_util.h"
 #include "ch.h"
 
-#if defined(SPLIT_KEYBOARD)
+// The usart_dma split driver brings its own, see serial_usart_dma.c
+#if defined(SPLIT_KEYBOARD) && !defined(SERIAL_DRIVER_USART_DMA)
 static MUTEX_DECL(SPLIT_SHARED_MEMORY_MUTEX);
 
 /**
@@ -0,0 +1,63 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include "i2c_async.h"
+
+static i2c_async_job_t *i2c_async_head = NULL;
+
+/** \brief Queues a job, returns false if it is still busy from an earlier submit
+ */
+bool i2c_async_submit(i2c_async_job_t *job) {
+    if (job->busy) {
+        return false;
+    }
+    job->busy = true;
+    job->sent = 0;
+
+    i2c_async_job_t **link = &i2c_async_head;
+    // A job that has started keeps the bus until its last write is out
+    if (*link && (*link)->sent > 0) {
+        link = &(*link)->next;
+    }
+    while (*link && (*link)->priority >= job->priority) {
+        link = &(*link)->next;
+    }
+    job->next = *link;
+    *link     = job;
+    return true;
+}
+
+bool i2c_async_busy(const i2c_async_job_t *job) {
+    return job->busy;
+}
+
+/** \brief Sends the next queued writes, returns true while jobs are left
+ */
+bool i2c_async_task(void) {
+    for (uint8_t i = 0; i < I2C_ASYNC_TRANSFERS_PER_TASK && i2c_async_head; i++) {
+        i2c_async_job_t *job    = i2c_async_head;
+        i2c_status_t     status = I2C_STATUS_SUCCESS;
+
+        if (job->sent < job->count) {
+            const i2c_async_write_t *write = &job->writes[job->sent++];
+            status                         = i2c_write_register(job->address, write->reg, write->data, write->length, job->timeout);
+        }
+        if (status != I2C_STATUS_SUCCESS || job->sent >= job->count) {
+            // Taken off the queue first, so that the callback may submit it again
+            i2c_async_head = job->next;
+            job->busy      = false;
+            if (job->callback) {
+                job->callback(job, status);
+            }
+        }
+    }
+    return i2c_async_head != NULL;
+}
+
+/** \brief Sends everything that is queued before returning
+ */
+void i2c_async_flush(void) {
+    while (i2c_async_task()) {
+    }
+}
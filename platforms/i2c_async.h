@@ -0,0 +1,57 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Queued I2C transfers, sent from the main loop.
+ *
+ * A feature fills in an i2c_async_job_t, hands it to i2c_async_submit() and
+ * carries on. i2c_async_task() then sends at most I2C_ASYNC_TRANSFERS_PER_TASK
+ * register writes per pass of the main loop, so no single pass waits on the
+ * bus for a whole sequence. Once the last write is out, or one of them fails,
+ * the job's callback is called from i2c_async_task().
+ *
+ * Jobs with a higher priority are sent first, jobs of equal priority in the
+ * order they were submitted. A job that has started is never interleaved with
+ * another one, so a register sequence reaches its device in one piece.
+ *
+ * The job and the data its writes point to belong to the caller, and must
+ * stay untouched until the job is no longer busy.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "i2c_master.h"
+
+#ifndef I2C_ASYNC_TRANSFERS_PER_TASK
+#    define I2C_ASYNC_TRANSFERS_PER_TASK 1
+#endif
+
+typedef struct i2c_async_write_t {
+    uint8_t        reg;
+    uint16_t       length;
+    const uint8_t *data;
+} i2c_async_write_t;
+
+typedef struct i2c_async_job_t i2c_async_job_t;
+
+// Called once per job, with I2C_STATUS_SUCCESS or the status of the write that failed
+typedef void (*i2c_async_callback_t)(i2c_async_job_t *job, i2c_status_t status);
+
+struct i2c_async_job_t {
+    uint8_t                  address; // already shifted, as for i2c_write_register()
+    uint8_t                  priority;
+    uint16_t                 timeout;
+    const i2c_async_write_t *writes;
+    uint8_t                  count;
+    i2c_async_callback_t     callback;
+
+    // Only used by the queue
+    i2c_async_job_t *next;
+    uint8_t          sent;
+    bool             busy;
+};
+
+bool i2c_async_submit(i2c_async_job_t *job);
+bool i2c_async_busy(const i2c_async_job_t *job);
+bool i2c_async_task(void);
+void i2c_async_flush(void);
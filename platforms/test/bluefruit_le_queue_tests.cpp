@@ -0,0 +1,219 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+#include "bluefruit_le_queue.hpp"
+#include "bluefruit_le_response.hpp"
+
+static queue_item key_report(uint8_t modifier, std::initializer_list<uint8_t> keys) {
+    queue_item item   = {};
+    item.queue_type   = QTKeyReport;
+    item.key.modifier = modifier;
+    uint8_t i         = 0;
+    for (uint8_t key : keys) {
+        item.key.keys[i++] = key;
+    }
+    return item;
+}
+
+static queue_item mouse_report(int8_t x, int8_t y, uint8_t buttons) {
+    queue_item item        = {};
+    item.queue_type        = QTMouseMove;
+    item.mousemove.x       = x;
+    item.mousemove.y       = y;
+    item.mousemove.buttons = buttons;
+    return item;
+}
+
+// Everything in the queue, front first
+template <uint8_t Size>
+static std::vector<queue_item> drain(ReportQueue<Size> &queue, uint16_t now) {
+    std::vector<queue_item> items;
+    while (!queue.empty()) {
+        items.push_back(queue.front());
+        queue.sent(now);
+    }
+    return items;
+}
+
+TEST(BluefruitLeQueue, MouseMovementsAddUp) {
+    ReportQueue<8> queue;
+    for (int i = 0; i < 5; i++) {
+        EXPECT_TRUE(queue.add(mouse_report(10, -3, 0), 0));
+    }
+
+    // The first one may be on its way already
+    auto items = drain(queue, 0);
+    ASSERT_EQ(items.size(), 2);
+    EXPECT_EQ(items[0].mousemove.x, 10);
+    EXPECT_EQ(items[1].mousemove.x, 40);
+    EXPECT_EQ(items[1].mousemove.y, -12);
+    EXPECT_EQ(queue.stats().coalesced, 3);
+}
+
+TEST(BluefruitLeQueue, MouseMovementsDoNotOverflow) {
+    ReportQueue<8> queue;
+    queue.add(mouse_report(1, 0, 0), 0);
+    queue.add(mouse_report(100, 0, 0), 0);
+    queue.add(mouse_report(100, 0, 0), 0);
+
+    auto items = drain(queue, 0);
+    ASSERT_EQ(items.size(), 3);
+    EXPECT_EQ(items[1].mousemove.x, 100);
+    EXPECT_EQ(items[2].mousemove.x, 100);
+}
+
+TEST(BluefruitLeQueue, ButtonChangesAreKept) {
+    ReportQueue<8> queue;
+    queue.add(mouse_report(1, 0, 0), 0);
+    queue.add(mouse_report(1, 0, 0), 0);
+    queue.add(mouse_report(0, 0, 1), 0);
+    queue.add(mouse_report(0, 0, 0), 0);
+
+    auto items = drain(queue, 0);
+    ASSERT_EQ(items.size(), 4);
+    EXPECT_EQ(items[2].mousemove.buttons, 1);
+    EXPECT_EQ(items[3].mousemove.buttons, 0);
+}
+
+TEST(BluefruitLeQueue, TapIsNotLost) {
+    ReportQueue<8> queue;
+    queue.add(key_report(0, {}), 0);
+    queue.add(key_report(0, {KC_A}), 0);
+    queue.add(key_report(0, {}), 0);
+
+    EXPECT_EQ(drain(queue, 0).size(), 3);
+}
+
+TEST(BluefruitLeQueue, PressOrderIsKept) {
+    ReportQueue<8> queue;
+    queue.add(key_report(0, {}), 0);
+    queue.add(key_report(0, {KC_A}), 0);
+    queue.add(key_report(0, {KC_A, KC_B}), 0);
+    // Shift after the A, the A must not turn into a capital
+    queue.add(key_report(MOD_BIT(KC_LSFT), {KC_A, KC_B}), 0);
+
+    EXPECT_EQ(drain(queue, 0).size(), 4);
+}
+
+TEST(BluefruitLeQueue, RolloverCollapses) {
+    ReportQueue<8> queue;
+    queue.add(key_report(0, {}), 0);
+    queue.add(key_report(0, {KC_A}), 0);
+    queue.add(key_report(0, {KC_A, KC_B}), 0);
+    // A goes up, then B: both releases in one report
+    queue.add(key_report(0, {KC_B}), 0);
+    queue.add(key_report(0, {}), 0);
+
+    auto items = drain(queue, 0);
+    ASSERT_EQ(items.size(), 4);
+    EXPECT_EQ(items[3].key.keys[0], 0);
+    EXPECT_EQ(queue.stats().coalesced, 1);
+}
+
+TEST(BluefruitLeQueue, ReleaseAndPressIsKept) {
+    ReportQueue<8> queue;
+    queue.add(key_report(0, {}), 0);
+    queue.add(key_report(0, {KC_A}), 0);
+    queue.add(key_report(0, {}), 0);
+    queue.add(key_report(0, {KC_A}), 0);
+
+    EXPECT_EQ(drain(queue, 0).size(), 4);
+}
+
+TEST(BluefruitLeQueue, LatencyStats) {
+    ReportQueue<8> queue;
+    queue.add(key_report(0, {KC_A}), 100);
+    queue.add(key_report(0, {}), 110);
+    queue.sent(130);
+    queue.sent(140);
+
+    EXPECT_EQ(queue.stats().sent, 2);
+    EXPECT_EQ(queue.stats().max_latency, 30);
+    EXPECT_EQ(queue.stats().total_latency, 60);
+    EXPECT_EQ(queue.stats().max_depth, 2);
+
+    queue.reset_stats();
+    EXPECT_EQ(queue.stats().sent, 0);
+}
+
+TEST(BluefruitLeQueue, FullQueueRefuses) {
+    ReportQueue<4> queue;
+    queue.add(mouse_report(0, 0, 0), 0);
+    queue.add(mouse_report(0, 0, 1), 0);
+    queue.add(mouse_report(0, 0, 0), 0);
+    EXPECT_FALSE(queue.add(mouse_report(0, 0, 1), 0));
+    // Still merges into the last one
+    EXPECT_TRUE(queue.add(mouse_report(5, 0, 0), 0));
+}
+
+/* Rolling over the keys while typing into a module that takes 20ms per AT
+ * command, a report every 5ms. Returns how many commands it took. */
+static uint32_t type_into(ReportQueue<40> &queue, bool coalesce) {
+    static const std::vector<std::vector<uint8_t>> states = {{KC_A}, {KC_A, KC_B}, {KC_B}, {KC_B, KC_C}, {KC_C}, {}};
+    uint16_t                                       busy     = 0;
+    uint32_t                                       commands = 0;
+
+    for (uint16_t i = 0, now = 0; i < 30 || !queue.empty(); i++, now += 5) {
+        if (i < 30) {
+            const std::vector<uint8_t> &keys = states[i % states.size()];
+            queue_item                  item = key_report(0, {});
+            std::copy(keys.begin(), keys.end(), item.key.keys);
+            item.added = now;
+            EXPECT_TRUE(coalesce ? queue.add(item, now) : queue.enqueue(item));
+        }
+        if (now >= busy && !queue.empty()) {
+            busy = now + 20;
+            queue.sent(busy);
+            commands++;
+        }
+    }
+    return commands;
+}
+
+TEST(BluefruitLeQueue, TypingBacklog) {
+    ReportQueue<40> plain, coalesced;
+    uint32_t        plain_commands     = type_into(plain, false);
+    uint32_t        coalesced_commands = type_into(coalesced, true);
+    uint32_t        plain_wait         = plain.stats().total_latency / plain.stats().sent;
+    uint32_t        coalesced_wait     = coalesced.stats().total_latency / coalesced.stats().sent;
+
+    EXPECT_EQ(plain_commands, 30);
+    // Most reports catch the one before them still queued, which halves the commands and the time spent waiting
+    EXPECT_LE(coalesced_commands, plain_commands / 2 + 1);
+    EXPECT_LT(coalesced_wait * 2, plain_wait);
+    EXPECT_LT(coalesced.stats().max_latency * 2, plain.stats().max_latency);
+}
+
+TEST(BluefruitLeResponse, Ok) {
+    char resp[] = "OK\r\n";
+    EXPECT_TRUE(at_response_ok(resp, resp + strlen(resp)));
+    EXPECT_STREQ(resp, "OK");
+}
+
+TEST(BluefruitLeResponse, ValueThenOk) {
+    char resp[] = "1\r\nOK\r\n";
+    EXPECT_TRUE(at_response_ok(resp, resp + strlen(resp)));
+    EXPECT_EQ(atoi(resp), 1);
+}
+
+TEST(BluefruitLeResponse, Error) {
+    char resp[] = "AT+FOO\r\nERROR\r\n";
+    EXPECT_FALSE(at_response_ok(resp, resp + strlen(resp)));
+}
+
+TEST(BluefruitLeResponse, Empty) {
+    char resp[] = "\r\n";
+    EXPECT_FALSE(at_response_ok(resp, resp + strlen(resp)));
+    EXPECT_STREQ(resp, "");
+}
+
+TEST(BluefruitLeResponse, Truncated) {
+    // Cut off in the middle of the last line
+    char resp[] = "0x0000000\r\nO";
+    EXPECT_FALSE(at_response_ok(resp, resp + strlen(resp)));
+}
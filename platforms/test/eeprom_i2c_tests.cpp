@@ -0,0 +1,276 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "eeprom.h"
+#include "eeprom_driver.h"
+#include "i2c_master.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+/* A 24LC256 on a 400kHz bus. The device ignores its address for the length
+ * of a write cycle, which on real parts is well under the 5ms the datasheet
+ * allows for. Bus time is handed to the millisecond timer as it adds up.
+ */
+#define MODEL_WRITE_CYCLE_NS 3500000
+#define MODEL_PAGE_COUNT (EXTERNAL_EEPROM_BYTE_COUNT / EXTERNAL_EEPROM_PAGE_SIZE)
+
+static uint8_t  memory[EXTERNAL_EEPROM_BYTE_COUNT];
+static uint32_t pointer;
+static uint64_t busy_until_ns;
+static uint32_t residual_ns;
+static uint32_t page_writes;
+static uint32_t nacks;
+static uint32_t failed_receives;
+
+static uint64_t now_ns(void) {
+    return (uint64_t)timer_read32() * 1000000 + residual_ns;
+}
+
+static void spend_bytes(uint32_t bytes) {
+    residual_ns += bytes * I2C_SIM_BYTE_NS;
+    while (residual_ns >= 1000000) {
+        advance_time(1);
+        residual_ns -= 1000000;
+    }
+}
+
+static bool model_busy(void) {
+    if (now_ns() < busy_until_ns) {
+        spend_bytes(1);
+        nacks++;
+        return true;
+    }
+    return false;
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    if (model_busy()) {
+        return I2C_STATUS_ERROR;
+    }
+    spend_bytes(1 + length);
+    pointer = ((uint32_t)data[0] << 8 | data[1]) % EXTERNAL_EEPROM_BYTE_COUNT;
+    if (length > EXTERNAL_EEPROM_ADDRESS_SIZE) {
+        // Writes wrap around within the page
+        uint32_t page = pointer - pointer % EXTERNAL_EEPROM_PAGE_SIZE;
+        for (uint16_t i = 0; i < length - EXTERNAL_EEPROM_ADDRESS_SIZE; i++) {
+            memory[page + (pointer + i) % EXTERNAL_EEPROM_PAGE_SIZE] = data[EXTERNAL_EEPROM_ADDRESS_SIZE + i];
+        }
+        page_writes++;
+        busy_until_ns = now_ns() + MODEL_WRITE_CYCLE_NS;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout) {
+    if (model_busy()) {
+        return I2C_STATUS_ERROR;
+    }
+    // As if the bus failed part way, with nothing read into data
+    if (failed_receives) {
+        failed_receives--;
+        return I2C_STATUS_TIMEOUT;
+    }
+    spend_bytes(1 + length);
+    for (uint16_t i = 0; i < length; i++) {
+        data[i] = memory[pointer];
+        pointer = (pointer + 1) % EXTERNAL_EEPROM_BYTE_COUNT;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+// What the driver took before: every page write followed by EXTERNAL_EEPROM_WRITE_TIME
+static uint64_t fixed_delay_write_ns(uint32_t pages, uint32_t bytes_per_page) {
+    return pages * ((1 + EXTERNAL_EEPROM_ADDRESS_SIZE + bytes_per_page) * (uint64_t)I2C_SIM_BYTE_NS + EXTERNAL_EEPROM_WRITE_TIME * 1000000ull);
+}
+
+class EepromI2C : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        eeprom_driver_init();
+        // Also drops anything an earlier test left in the cache
+        eeprom_driver_erase();
+        memset(memory, 0xFF, sizeof(memory));
+        advance_time(100);
+        page_writes     = 0;
+        nacks           = 0;
+        failed_receives = 0;
+    }
+
+    void housekeeping(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            eeprom_driver_task();
+        }
+    }
+};
+
+TEST_F(EepromI2C, ReadsBackWrites) {
+    std::mt19937         rng(42);
+    std::vector<uint8_t> expected(memory, memory + sizeof(memory));
+
+    for (int i = 0; i < 200; i++) {
+        uint32_t             addr = rng() % (EXTERNAL_EEPROM_BYTE_COUNT - 300);
+        std::vector<uint8_t> data(rng() % 300 + 1);
+        for (auto &b : data) {
+            b = rng();
+        }
+        eeprom_write_block(data.data(), (void *)(uintptr_t)addr, data.size());
+        std::copy(data.begin(), data.end(), expected.begin() + addr);
+
+        std::vector<uint8_t> back(data.size());
+        eeprom_read_block(back.data(), (void *)(uintptr_t)addr, back.size());
+        ASSERT_EQ(back, data);
+        if (rng() % 8 == 0) {
+            housekeeping(EXTERNAL_EEPROM_WRITE_BACK_DELAY + 10);
+        }
+    }
+    eeprom_driver_flush();
+    EXPECT_EQ(std::vector<uint8_t>(memory, memory + sizeof(memory)), expected);
+}
+
+TEST_F(EepromI2C, WritesBackFromHousekeeping) {
+    eeprom_write_byte((uint8_t *)10, 0x42);
+    EXPECT_EQ(page_writes, 0);
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)10), 0x42);
+
+    housekeeping(EXTERNAL_EEPROM_WRITE_BACK_DELAY - 1);
+    EXPECT_EQ(page_writes, 0);
+    housekeeping(1);
+    EXPECT_EQ(page_writes, 1);
+    EXPECT_EQ(memory[10], 0x42);
+    EXPECT_EQ(memory[11], 0xFF);
+}
+
+TEST_F(EepromI2C, HousekeepingDoesNotWaitForWriteCycle) {
+    uint8_t page[EXTERNAL_EEPROM_PAGE_SIZE] = {1, 2, 3};
+    eeprom_write_block(page, (void *)0, sizeof(page));
+    eeprom_write_block(page, (void *)EXTERNAL_EEPROM_PAGE_SIZE, sizeof(page));
+    housekeeping(EXTERNAL_EEPROM_WRITE_BACK_DELAY);
+    EXPECT_EQ(page_writes, 1);
+
+    // The device is busy: each pass asks it once, and comes back after a single address byte
+    uint64_t worst = 0;
+    while (page_writes < 2) {
+        uint64_t before = now_ns();
+        eeprom_driver_task();
+        worst = std::max(worst, now_ns() - before);
+        if (now_ns() == before) {
+            advance_time(1);
+        }
+    }
+    EXPECT_EQ(worst, (1 + EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE) * (uint64_t)I2C_SIM_BYTE_NS);
+    EXPECT_LE(nacks, EXTERNAL_EEPROM_WRITE_TIME);
+}
+
+TEST_F(EepromI2C, ByteUpdatesShareOnePageWrite) {
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_PAGE_SIZE; i++) {
+        eeprom_update_byte((uint8_t *)(uintptr_t)(EXTERNAL_EEPROM_PAGE_SIZE * 3 + i), i);
+    }
+    eeprom_driver_flush();
+    EXPECT_EQ(page_writes, 1);
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_PAGE_SIZE; i++) {
+        EXPECT_EQ(memory[EXTERNAL_EEPROM_PAGE_SIZE * 3 + i], i);
+    }
+}
+
+TEST_F(EepromI2C, UnchangedPagesAreSkipped) {
+    uint8_t page[EXTERNAL_EEPROM_PAGE_SIZE];
+    memset(page, 0x5A, sizeof(page));
+    eeprom_write_block(page, (void *)0, sizeof(page));
+    eeprom_driver_flush();
+    EXPECT_EQ(page_writes, 1);
+
+    eeprom_write_block(page, (void *)0, sizeof(page));
+    eeprom_write_byte((uint8_t *)5, 0x5A);
+    eeprom_driver_flush();
+    EXPECT_EQ(page_writes, 1);
+}
+
+TEST_F(EepromI2C, FlushWritesEverything) {
+    for (uint32_t p = 0; p < EXTERNAL_EEPROM_CACHE_PAGES + 2; p++) {
+        eeprom_write_byte((uint8_t *)(uintptr_t)(p * EXTERNAL_EEPROM_PAGE_SIZE), p);
+    }
+    eeprom_driver_flush();
+    EXPECT_EQ(page_writes, EXTERNAL_EEPROM_CACHE_PAGES + 2);
+    for (uint32_t p = 0; p < EXTERNAL_EEPROM_CACHE_PAGES + 2; p++) {
+        EXPECT_EQ(memory[p * EXTERNAL_EEPROM_PAGE_SIZE], p);
+    }
+}
+
+TEST_F(EepromI2C, FailedReadIsNotWrittenBack) {
+    for (uint32_t i = 0; i < 2 * EXTERNAL_EEPROM_PAGE_SIZE; i++) {
+        memory[i] = i;
+    }
+    // Leaves data of its own page in the cache
+    uint8_t value = 0xA5;
+    eeprom_write_block(&value, (void *)1, 1);
+
+    failed_receives = 1;
+    eeprom_write_block(&value, (void *)(uintptr_t)(EXTERNAL_EEPROM_PAGE_SIZE + 3), 1);
+    eeprom_driver_flush();
+
+    // Only the byte written changed on the page that could not be read
+    EXPECT_EQ(memory[1], 0xA5);
+    for (uint32_t i = EXTERNAL_EEPROM_PAGE_SIZE; i < 2 * EXTERNAL_EEPROM_PAGE_SIZE; i++) {
+        EXPECT_EQ(memory[i], i == EXTERNAL_EEPROM_PAGE_SIZE + 3 ? 0xA5 : (uint8_t)i);
+    }
+
+    uint8_t page[EXTERNAL_EEPROM_PAGE_SIZE];
+    eeprom_read_block(page, (void *)EXTERNAL_EEPROM_PAGE_SIZE, sizeof(page));
+    EXPECT_EQ(memcmp(page, &memory[EXTERNAL_EEPROM_PAGE_SIZE], sizeof(page)), 0);
+}
+
+TEST_F(EepromI2C, EraseTiming) {
+    uint64_t start = now_ns();
+    eeprom_driver_erase();
+    uint64_t full = now_ns() - start;
+    for (uint32_t i = 0; i < EXTERNAL_EEPROM_BYTE_COUNT; i++) {
+        ASSERT_EQ(memory[i], 0x00);
+    }
+    EXPECT_EQ(page_writes, MODEL_PAGE_COUNT);
+
+    // As after a keyboard has been in use for a while: only the start of the EEPROM holds data
+    memset(memory, 0x33, 2048);
+    page_writes = 0;
+    start       = now_ns();
+    eeprom_driver_erase();
+    uint64_t used = now_ns() - start;
+    // Depending on where the data ends, the page after it may be written without being read
+    EXPECT_GE(page_writes, 2048 / EXTERNAL_EEPROM_PAGE_SIZE);
+    EXPECT_LE(page_writes, 2048 / EXTERNAL_EEPROM_PAGE_SIZE + 1);
+
+    uint64_t before = fixed_delay_write_ns(MODEL_PAGE_COUNT, EXTERNAL_EEPROM_PAGE_SIZE);
+    EXPECT_LE(full, before);
+    EXPECT_LT(used * 3, before);
+}
+
+TEST_F(EepromI2C, KeymapWriteTiming) {
+    // A VIA keymap upload: four layers of 5x15 keys, sent as 28 byte packets and stored with eeprom_update_byte()
+    const uint32_t base = 0x40, size = 4 * 5 * 15 * 2;
+    std::mt19937   rng(7);
+    uint64_t       start = now_ns();
+    for (uint32_t offset = 0; offset < size; offset += 28) {
+        for (uint32_t i = offset; i < std::min(offset + 28, size); i++) {
+            eeprom_update_byte((uint8_t *)(uintptr_t)(base + i), rng());
+        }
+        housekeeping(1);
+    }
+    eeprom_driver_flush();
+    uint64_t elapsed = now_ns() - start;
+
+    uint32_t pages = (base + size - 1) / EXTERNAL_EEPROM_PAGE_SIZE - base / EXTERNAL_EEPROM_PAGE_SIZE + 1;
+    EXPECT_LE(page_writes, pages + 1);
+
+    // Before, every byte that changed was read and then written with a page write of its own
+    uint64_t before = fixed_delay_write_ns(size, 1) + size * (uint64_t)(1 + EXTERNAL_EEPROM_ADDRESS_SIZE + 1 + 1) * I2C_SIM_BYTE_NS;
+    EXPECT_LT(elapsed * 20, before);
+}
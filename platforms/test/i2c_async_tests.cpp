@@ -0,0 +1,227 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+#include "i2c_async.h"
+}
+
+#define LED_ADDRESS (0x30 << 1)
+#define HAPTIC_ADDRESS (0x5A << 1)
+#define MISSING_ADDRESS (0x50 << 1)
+
+struct completion {
+    i2c_async_job_t *job;
+    i2c_status_t     status;
+};
+
+static std::vector<completion> completions;
+
+static void record_completion(i2c_async_job_t *job, i2c_status_t status) {
+    completions.push_back({job, status});
+}
+
+static i2c_async_job_t make_job(uint8_t address, uint8_t priority, const i2c_async_write_t *writes, uint8_t count) {
+    i2c_async_job_t job = {};
+    job.address         = address;
+    job.priority        = priority;
+    job.timeout         = 100;
+    job.writes          = writes;
+    job.count           = count;
+    job.callback        = record_completion;
+    return job;
+}
+
+static const uint8_t           values[] = {0x11, 0x22, 0x33, 0x44};
+static const i2c_async_write_t three_writes[] = {
+    {0x01, 1, &values[0]},
+    {0x02, 1, &values[1]},
+    {0x03, 2, &values[2]},
+};
+
+class I2CAsync : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        i2c_sim_reset();
+        i2c_sim_attach(LED_ADDRESS);
+        i2c_sim_attach(HAPTIC_ADDRESS);
+        completions.clear();
+    }
+
+    // Address and register of each transfer the bus has seen
+    std::vector<std::pair<uint8_t, uint8_t>> transfers() {
+        std::vector<std::pair<uint8_t, uint8_t>> result;
+        for (uint16_t i = 0; i < i2c_sim_transfer_count(); i++) {
+            result.push_back({i2c_sim_transfer(i)->address, i2c_sim_transfer(i)->reg});
+        }
+        return result;
+    }
+};
+
+TEST_F(I2CAsync, SubmitDoesNotTouchTheBus) {
+    i2c_async_job_t job = make_job(LED_ADDRESS, 0, three_writes, 3);
+
+    EXPECT_TRUE(i2c_async_submit(&job));
+    EXPECT_TRUE(i2c_async_busy(&job));
+    EXPECT_EQ(i2c_sim_transfer_count(), 0);
+    EXPECT_EQ(i2c_sim_busy_ns(), 0);
+    i2c_async_flush();
+}
+
+TEST_F(I2CAsync, ChainedWritesOnePerTask) {
+    i2c_async_job_t job = make_job(LED_ADDRESS, 0, three_writes, 3);
+    i2c_async_submit(&job);
+
+    EXPECT_TRUE(i2c_async_task());
+    EXPECT_EQ(i2c_sim_transfer_count(), 1);
+    EXPECT_TRUE(i2c_async_task());
+    EXPECT_EQ(i2c_sim_transfer_count(), 2);
+    EXPECT_TRUE(completions.empty());
+
+    EXPECT_FALSE(i2c_async_task());
+    EXPECT_FALSE(i2c_async_busy(&job));
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_EQ(completions[0].job, &job);
+    EXPECT_EQ(completions[0].status, I2C_STATUS_SUCCESS);
+
+    EXPECT_EQ(transfers(), (std::vector<std::pair<uint8_t, uint8_t>>{{LED_ADDRESS, 0x01}, {LED_ADDRESS, 0x02}, {LED_ADDRESS, 0x03}}));
+    EXPECT_EQ(i2c_sim_register(LED_ADDRESS, 0x01), 0x11);
+    EXPECT_EQ(i2c_sim_register(LED_ADDRESS, 0x02), 0x22);
+    EXPECT_EQ(i2c_sim_register(LED_ADDRESS, 0x03), 0x33);
+    EXPECT_EQ(i2c_sim_register(LED_ADDRESS, 0x04), 0x44);
+}
+
+TEST_F(I2CAsync, HigherPriorityFirst) {
+    i2c_async_job_t low1 = make_job(LED_ADDRESS, 0, &three_writes[0], 1);
+    i2c_async_job_t low2 = make_job(LED_ADDRESS, 0, &three_writes[1], 1);
+    i2c_async_job_t high = make_job(HAPTIC_ADDRESS, 5, &three_writes[2], 1);
+
+    i2c_async_submit(&low1);
+    i2c_async_submit(&low2);
+    i2c_async_submit(&high);
+    i2c_async_flush();
+
+    EXPECT_EQ(transfers(), (std::vector<std::pair<uint8_t, uint8_t>>{{HAPTIC_ADDRESS, 0x03}, {LED_ADDRESS, 0x01}, {LED_ADDRESS, 0x02}}));
+    ASSERT_EQ(completions.size(), 3);
+    EXPECT_EQ(completions[0].job, &high);
+    EXPECT_EQ(completions[1].job, &low1);
+    EXPECT_EQ(completions[2].job, &low2);
+}
+
+TEST_F(I2CAsync, StartedJobIsNotInterleaved) {
+    i2c_async_job_t low  = make_job(LED_ADDRESS, 0, three_writes, 3);
+    i2c_async_job_t high = make_job(HAPTIC_ADDRESS, 5, three_writes, 1);
+
+    i2c_async_submit(&low);
+    i2c_async_task();
+    i2c_async_submit(&high);
+    i2c_async_flush();
+
+    EXPECT_EQ(transfers(), (std::vector<std::pair<uint8_t, uint8_t>>{{LED_ADDRESS, 0x01}, {LED_ADDRESS, 0x02}, {LED_ADDRESS, 0x03}, {HAPTIC_ADDRESS, 0x01}}));
+}
+
+TEST_F(I2CAsync, FailedWriteEndsTheJob) {
+    i2c_async_job_t missing = make_job(MISSING_ADDRESS, 0, three_writes, 3);
+    i2c_async_job_t next    = make_job(LED_ADDRESS, 0, three_writes, 1);
+
+    i2c_async_submit(&missing);
+    i2c_async_submit(&next);
+    i2c_async_flush();
+
+    // The rest of the sequence is dropped, the next job still goes out
+    EXPECT_EQ(transfers(), (std::vector<std::pair<uint8_t, uint8_t>>{{MISSING_ADDRESS, 0x01}, {LED_ADDRESS, 0x01}}));
+    ASSERT_EQ(completions.size(), 2);
+    EXPECT_EQ(completions[0].job, &missing);
+    EXPECT_EQ(completions[0].status, I2C_STATUS_ERROR);
+    EXPECT_EQ(completions[1].status, I2C_STATUS_SUCCESS);
+}
+
+TEST_F(I2CAsync, BusyJobIsNotQueuedTwice) {
+    i2c_async_job_t job = make_job(LED_ADDRESS, 0, three_writes, 1);
+
+    EXPECT_TRUE(i2c_async_submit(&job));
+    EXPECT_FALSE(i2c_async_submit(&job));
+    i2c_async_flush();
+    EXPECT_EQ(i2c_sim_transfer_count(), 1);
+    EXPECT_TRUE(i2c_async_submit(&job));
+    i2c_async_flush();
+    EXPECT_EQ(completions.size(), 2);
+}
+
+static int resubmits;
+
+static void resubmit(i2c_async_job_t *job, i2c_status_t status) {
+    record_completion(job, status);
+    if (--resubmits > 0) {
+        EXPECT_TRUE(i2c_async_submit(job));
+    }
+}
+
+TEST_F(I2CAsync, CallbackMaySubmitAgain) {
+    i2c_async_job_t job = make_job(LED_ADDRESS, 0, three_writes, 2);
+    job.callback        = resubmit;
+    resubmits           = 3;
+
+    i2c_async_submit(&job);
+    i2c_async_flush();
+    EXPECT_EQ(completions.size(), 3);
+    EXPECT_EQ(i2c_sim_transfer_count(), 6);
+}
+
+// An LED frame of four 24 byte pages and a three write haptic pulse, as keyboard_task() would meet them
+static uint8_t                 frame[4][24];
+static const i2c_async_write_t frame_writes[] = {
+    {0x00, 24, frame[0]},
+    {0x18, 24, frame[1]},
+    {0x30, 24, frame[2]},
+    {0x48, 24, frame[3]},
+};
+static const i2c_async_write_t pulse_writes[] = {
+    {0x0C, 1, &values[0]},
+    {0x04, 1, &values[1]},
+    {0x0C, 1, &values[2]},
+};
+
+TEST_F(I2CAsync, KeyboardTaskBlockingTime) {
+    uint32_t blocking = 0;
+    for (int pass = 0; pass < 4; pass++) {
+        uint32_t before = i2c_sim_busy_ns();
+        for (auto &w : frame_writes) {
+            i2c_write_register(LED_ADDRESS, w.reg, w.data, w.length, 100);
+        }
+        for (auto &w : pulse_writes) {
+            i2c_write_register(HAPTIC_ADDRESS, w.reg, w.data, w.length, 100);
+        }
+        blocking = std::max(blocking, i2c_sim_busy_ns() - before);
+    }
+    uint32_t blocking_total = i2c_sim_busy_ns();
+
+    i2c_sim_reset();
+    i2c_sim_attach(LED_ADDRESS);
+    i2c_sim_attach(HAPTIC_ADDRESS);
+
+    i2c_async_job_t leds   = make_job(LED_ADDRESS, 0, frame_writes, 4);
+    i2c_async_job_t haptic = make_job(HAPTIC_ADDRESS, 1, pulse_writes, 3);
+    uint32_t        worst  = 0;
+    int             passes = 0;
+    for (int pass = 0; pass < 4; pass++) {
+        i2c_async_submit(&leds);
+        i2c_async_submit(&haptic);
+        while (true) {
+            uint32_t before = i2c_sim_busy_ns();
+            bool     more   = i2c_async_task();
+            worst           = std::max(worst, i2c_sim_busy_ns() - before);
+            passes++;
+            if (!more) break;
+        }
+    }
+
+    // One register write per pass
+    EXPECT_EQ(passes, 4 * (4 + 3));
+    EXPECT_EQ(i2c_sim_busy_ns(), blocking_total);
+    EXPECT_EQ(worst, (2 + 24) * I2C_SIM_BYTE_NS);
+    EXPECT_LT(worst * 4, blocking);
+}
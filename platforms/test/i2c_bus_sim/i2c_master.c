@@ -0,0 +1,131 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include <string.h>
+#include "i2c_master.h"
+
+typedef struct {
+    bool    attached;
+    uint8_t address;
+    uint8_t registers[256];
+} i2c_sim_device_t;
+
+static i2c_sim_device_t   i2c_sim_devices[I2C_SIM_DEVICES];
+static i2c_sim_transfer_t i2c_sim_log[I2C_SIM_LOG_SIZE];
+static uint16_t           i2c_sim_log_count = 0;
+static uint32_t           i2c_sim_ns        = 0;
+
+static i2c_sim_device_t *i2c_sim_find(uint8_t address) {
+    for (uint8_t i = 0; i < I2C_SIM_DEVICES; i++) {
+        if (i2c_sim_devices[i].attached && i2c_sim_devices[i].address == address) {
+            return &i2c_sim_devices[i];
+        }
+    }
+    return NULL;
+}
+
+// Logs a transfer and the bus time it takes. Without a device, only the address byte goes out.
+static i2c_sim_device_t *i2c_sim_transfer_start(uint8_t address, uint8_t reg, const uint8_t *data, uint16_t length, bool read, uint16_t bytes) {
+    i2c_sim_device_t *device = i2c_sim_find(address);
+
+    if (i2c_sim_log_count < I2C_SIM_LOG_SIZE) {
+        i2c_sim_transfer_t *transfer = &i2c_sim_log[i2c_sim_log_count++];
+        *transfer                    = (i2c_sim_transfer_t){.address = address, .reg = reg, .length = length, .read = read, .acked = device != NULL};
+        if (data) {
+            memcpy(transfer->data, data, length < I2C_SIM_LOG_DATA ? length : I2C_SIM_LOG_DATA);
+        }
+    }
+    i2c_sim_ns += (device ? bytes : 1) * I2C_SIM_BYTE_NS;
+    return device;
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    if (length == 0) {
+        return i2c_ping_address(address, timeout);
+    }
+    return i2c_write_register(address, data[0], data + 1, length - 1, timeout);
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout) {
+    i2c_sim_device_t *device = i2c_sim_transfer_start(address, 0, NULL, length, true, 1 + length);
+    if (!device) {
+        return I2C_STATUS_ERROR;
+    }
+    memcpy(data, device->registers, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    i2c_sim_device_t *device = i2c_sim_transfer_start(devaddr, regaddr, data, length, false, 2 + length);
+    if (!device) {
+        return I2C_STATUS_ERROR;
+    }
+    for (uint16_t i = 0; i < length; i++) {
+        device->registers[(uint8_t)(regaddr + i)] = data[i];
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    // Address and register, then a repeated start with the address again
+    i2c_sim_device_t *device = i2c_sim_transfer_start(devaddr, regaddr, NULL, length, true, 3 + length);
+    if (!device) {
+        return I2C_STATUS_ERROR;
+    }
+    for (uint16_t i = 0; i < length; i++) {
+        data[i] = device->registers[(uint8_t)(regaddr + i)];
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
+    return i2c_sim_transfer_start(address, 0, NULL, 0, false, 1) ? I2C_STATUS_SUCCESS : I2C_STATUS_ERROR;
+}
+
+void i2c_sim_reset(void) {
+    memset(i2c_sim_devices, 0, sizeof(i2c_sim_devices));
+    i2c_sim_reset_log();
+}
+
+// Starts the log and the bus time over, devices keep their registers
+void i2c_sim_reset_log(void) {
+    i2c_sim_log_count = 0;
+    i2c_sim_ns        = 0;
+}
+
+void i2c_sim_attach(uint8_t address) {
+    for (uint8_t i = 0; i < I2C_SIM_DEVICES; i++) {
+        if (!i2c_sim_devices[i].attached) {
+            i2c_sim_devices[i].attached = true;
+            i2c_sim_devices[i].address  = address;
+            return;
+        }
+    }
+}
+
+void i2c_sim_detach(uint8_t address) {
+    i2c_sim_device_t *device = i2c_sim_find(address);
+    if (device) {
+        device->attached = false;
+    }
+}
+
+uint8_t i2c_sim_register(uint8_t address, uint8_t reg) {
+    i2c_sim_device_t *device = i2c_sim_find(address);
+    return device ? device->registers[reg] : 0;
+}
+
+uint32_t i2c_sim_busy_ns(void) {
+    return i2c_sim_ns;
+}
+
+uint16_t i2c_sim_transfer_count(void) {
+    return i2c_sim_log_count;
+}
+
+const i2c_sim_transfer_t *i2c_sim_transfer(uint16_t index) {
+    return index < i2c_sim_log_count ? &i2c_sim_log[index] : NULL;
+}
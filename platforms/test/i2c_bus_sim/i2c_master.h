@@ -0,0 +1,60 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Simulated I2C bus for unit tests.
+ *
+ * Offers the same calls as the platform i2c_master drivers. Each attached
+ * device is a bank of 256 registers, transfers to any other address are not
+ * acknowledged. Every transfer is logged and counted towards the time the
+ * caller would have been blocked on a real bus.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef int16_t i2c_status_t;
+
+#define I2C_STATUS_SUCCESS (0)
+#define I2C_STATUS_ERROR (-1)
+#define I2C_STATUS_TIMEOUT (-2)
+
+void         i2c_init(void);
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout);
+
+// Time one byte takes on the wire, nine clocks at 400kHz
+#ifndef I2C_SIM_BYTE_NS
+#    define I2C_SIM_BYTE_NS 22500
+#endif
+#ifndef I2C_SIM_DEVICES
+#    define I2C_SIM_DEVICES 4
+#endif
+#ifndef I2C_SIM_LOG_SIZE
+#    define I2C_SIM_LOG_SIZE 256
+#endif
+// Bytes of each transfer kept in the log
+#ifndef I2C_SIM_LOG_DATA
+#    define I2C_SIM_LOG_DATA 4
+#endif
+
+typedef struct i2c_sim_transfer_t {
+    uint8_t  address;
+    uint8_t  reg;
+    uint16_t length;
+    bool     read;
+    bool     acked;
+    uint8_t  data[I2C_SIM_LOG_DATA];
+} i2c_sim_transfer_t;
+
+void                      i2c_sim_reset(void);
+void                      i2c_sim_reset_log(void);
+void                      i2c_sim_attach(uint8_t address);
+void                      i2c_sim_detach(uint8_t address);
+uint8_t                   i2c_sim_register(uint8_t address, uint8_t reg);
+uint32_t                  i2c_sim_busy_ns(void);
+uint16_t                  i2c_sim_transfer_count(void);
+const i2c_sim_transfer_t *i2c_sim_transfer(uint16_t index);
@@ -0,0 +1,222 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <vector>
+
+extern "C" {
+#include "is31fl3733.h"
+#include "i2c_master.h"
+#ifdef IS31FL3733_I2C_ASYNC
+#    include "i2c_async.h"
+#endif
+}
+
+#define ADDRESS_1 (IS31FL3733_I2C_ADDRESS_1 << 1)
+#define ADDRESS_2 (IS31FL3733_I2C_ADDRESS_2 << 1)
+#define LEDS_PER_DRIVER (IS31FL3733_LED_COUNT / IS31FL3733_DRIVER_COUNT)
+
+// Every PWM register in use, three per LED
+#define LED(i) \
+    { (i) / LEDS_PER_DRIVER, (i) % LEDS_PER_DRIVER * 3, (i) % LEDS_PER_DRIVER * 3 + 1, (i) % LEDS_PER_DRIVER * 3 + 2 }
+#define LED4(i) LED(i), LED(i + 1), LED(i + 2), LED(i + 3)
+#define LED16(i) LED4(i), LED4(i + 4), LED4(i + 8), LED4(i + 12)
+
+const is31fl3733_led_t PROGMEM g_is31fl3733_leds[IS31FL3733_LED_COUNT] = {
+    LED16(0), LED16(16), LED16(32), LED16(48), LED16(64), LED16(80), LED16(96), LED16(112),
+};
+
+// What every flush cost before: the page select and twelve 16 byte writes for each driver
+static uint32_t chunked_flush_ns(void) {
+    return IS31FL3733_DRIVER_COUNT * (2 * 3 + 12 * (2 + 16)) * I2C_SIM_BYTE_NS;
+}
+
+class IS31FL3733 : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        i2c_sim_reset();
+        i2c_sim_attach(ADDRESS_1);
+        i2c_sim_attach(ADDRESS_2);
+        is31fl3733_init_drivers();
+        is31fl3733_set_color_all(0, 0, 0);
+        flush();
+    }
+
+    // Clears the log, so that only what the flush sent is left in it
+    void flush() {
+        i2c_sim_reset_log();
+        is31fl3733_flush();
+#ifdef IS31FL3733_I2C_ASYNC
+        i2c_async_flush();
+#endif
+    }
+
+    // PWM writes of a flush, leaving out the single byte page selects
+    std::vector<std::pair<uint8_t, uint16_t>> pwm_writes(uint8_t address) {
+        std::vector<std::pair<uint8_t, uint16_t>> result;
+        for (uint16_t i = 0; i < i2c_sim_transfer_count(); i++) {
+            const i2c_sim_transfer_t *t = i2c_sim_transfer(i);
+            if (t->address == address && t->reg != IS31FL3733_REG_COMMAND && t->reg != IS31FL3733_REG_COMMAND_WRITE_LOCK) {
+                result.push_back({t->reg, t->length});
+            }
+        }
+        return result;
+    }
+
+    // The simulated bus has no pages, so only registers the PWM page has been written to since init can be checked
+    void expect_leds(int first, int last, uint8_t r, uint8_t g, uint8_t b) {
+        for (int i = first; i <= last; i++) {
+            uint8_t address = (i / LEDS_PER_DRIVER ? ADDRESS_2 : ADDRESS_1);
+            uint8_t reg     = i % LEDS_PER_DRIVER * 3;
+            EXPECT_EQ(i2c_sim_register(address, reg), r) << "LED " << i;
+            EXPECT_EQ(i2c_sim_register(address, reg + 1), g) << "LED " << i;
+            EXPECT_EQ(i2c_sim_register(address, reg + 2), b) << "LED " << i;
+        }
+    }
+};
+
+TEST_F(IS31FL3733, FullFrameIsOneTransferPerDriver) {
+    is31fl3733_set_color_all(10, 20, 30);
+    flush();
+
+    typedef std::vector<std::pair<uint8_t, uint16_t>> writes;
+    EXPECT_EQ(pwm_writes(ADDRESS_1), (writes{{0, 192}}));
+    EXPECT_EQ(pwm_writes(ADDRESS_2), (writes{{0, 192}}));
+    expect_leds(0, IS31FL3733_LED_COUNT - 1, 10, 20, 30);
+}
+
+TEST_F(IS31FL3733, OnlyChangedRegistersAreSent) {
+    is31fl3733_set_color(5, 1, 2, 3);
+    is31fl3733_set_color(LEDS_PER_DRIVER + 7, 4, 5, 6);
+    flush();
+
+    typedef std::vector<std::pair<uint8_t, uint16_t>> writes;
+    EXPECT_EQ(pwm_writes(ADDRESS_1), (writes{{15, 3}}));
+    EXPECT_EQ(pwm_writes(ADDRESS_2), (writes{{21, 3}}));
+    expect_leds(5, 5, 1, 2, 3);
+    expect_leds(LEDS_PER_DRIVER + 7, LEDS_PER_DRIVER + 7, 4, 5, 6);
+}
+
+TEST_F(IS31FL3733, SmallGapsShareATransfer) {
+    // Red of LEDs 0 and 1 leaves a gap of two registers, red of LED 3 one of five
+    is31fl3733_set_color(0, 9, 0, 0);
+    is31fl3733_set_color(1, 9, 0, 0);
+    is31fl3733_set_color(3, 9, 0, 0);
+    flush();
+
+    typedef std::vector<std::pair<uint8_t, uint16_t>> writes;
+    EXPECT_EQ(pwm_writes(ADDRESS_1), (writes{{0, 4}, {9, 1}}));
+}
+
+TEST_F(IS31FL3733, ChangedBackIsNotSent) {
+    is31fl3733_set_color(5, 1, 2, 3);
+    is31fl3733_set_color(5, 0, 0, 0);
+    flush();
+
+    EXPECT_TRUE(pwm_writes(ADDRESS_1).empty());
+}
+
+TEST_F(IS31FL3733, FailedWriteIsSentAgain) {
+    i2c_sim_detach(ADDRESS_2);
+    is31fl3733_set_color(LEDS_PER_DRIVER, 7, 7, 7);
+    flush();
+
+    i2c_sim_attach(ADDRESS_2);
+    is31fl3733_set_color(LEDS_PER_DRIVER + 1, 8, 8, 8);
+    flush();
+
+    typedef std::vector<std::pair<uint8_t, uint16_t>> writes;
+#ifdef IS31FL3733_I2C_ASYNC
+    // The queued update can't tell which registers were lost, so the whole page goes again
+    EXPECT_EQ(pwm_writes(ADDRESS_2), (writes{{0, 192}}));
+#else
+    EXPECT_EQ(pwm_writes(ADDRESS_2), (writes{{0, 6}}));
+#endif
+    expect_leds(LEDS_PER_DRIVER, LEDS_PER_DRIVER, 7, 7, 7);
+    expect_leds(LEDS_PER_DRIVER + 1, LEDS_PER_DRIVER + 1, 8, 8, 8);
+}
+
+TEST_F(IS31FL3733, FlushTiming) {
+    // Every LED changes, as in a rainbow
+    uint32_t worst = 0;
+    for (int frame = 1; frame <= 10; frame++) {
+        for (int i = 0; i < IS31FL3733_LED_COUNT; i++) {
+            is31fl3733_set_color(i, frame + i, frame * 2 + i, frame * 3 + i);
+        }
+        flush();
+        worst = std::max(worst, i2c_sim_busy_ns());
+    }
+
+    // A few keys fading out, as in a reactive effect
+    uint32_t reactive = 0;
+    for (int frame = 1; frame <= 10; frame++) {
+        for (int key : {3, 20, 21, 70, 100}) {
+            is31fl3733_set_color(key, 0, 0, 255 - frame * 20);
+        }
+        flush();
+        reactive = std::max(reactive, i2c_sim_busy_ns());
+    }
+
+    EXPECT_LT(worst, chunked_flush_ns());
+    EXPECT_LT(reactive * 5, chunked_flush_ns());
+}
+
+#ifdef IS31FL3733_I2C_ASYNC
+TEST_F(IS31FL3733, QueuedFlushSendsOneWritePerTask) {
+    is31fl3733_set_color_all(10, 20, 30);
+    i2c_sim_reset_log();
+    is31fl3733_flush();
+    EXPECT_EQ(i2c_sim_transfer_count(), 0);
+
+    // The page select and a single burst for each driver
+    int passes = 0;
+    while (i2c_async_task()) {
+        passes++;
+        EXPECT_EQ(i2c_sim_transfer_count(), passes);
+    }
+    EXPECT_EQ(i2c_sim_transfer_count(), IS31FL3733_DRIVER_COUNT * 3);
+    expect_leds(0, IS31FL3733_LED_COUNT - 1, 10, 20, 30);
+}
+
+TEST_F(IS31FL3733, ChangesDuringAQueuedFlushGoOutNextFlush) {
+    is31fl3733_set_color(5, 1, 2, 3);
+    i2c_sim_reset_log();
+    is31fl3733_flush();
+    i2c_async_task();
+
+    // The first update is still queued, so this one has to wait
+    is31fl3733_set_color(5, 4, 5, 6);
+    is31fl3733_set_color(9, 7, 8, 9);
+    is31fl3733_flush();
+    i2c_async_flush();
+
+    typedef std::vector<std::pair<uint8_t, uint16_t>> writes;
+    EXPECT_EQ(pwm_writes(ADDRESS_1), (writes{{15, 3}}));
+    expect_leds(5, 5, 1, 2, 3);
+
+    flush();
+    EXPECT_EQ(pwm_writes(ADDRESS_1), (writes{{15, 3}, {27, 3}}));
+    expect_leds(5, 5, 4, 5, 6);
+    expect_leds(9, 9, 7, 8, 9);
+}
+
+TEST_F(IS31FL3733, BurstsPastTheLimitAreMerged) {
+    // Red of every fifth LED, each too far from the next to share a burst
+    for (int i = 0; i < LEDS_PER_DRIVER; i += 5) {
+        is31fl3733_set_color(i, 9, 0, 0);
+    }
+    flush();
+
+    typedef std::vector<std::pair<uint8_t, uint16_t>> writes;
+    writes expected;
+    for (uint8_t i = 0; i < IS31FL3733_I2C_ASYNC_WRITES - 1; i++) {
+        expected.push_back({(uint8_t)(i * 15), 1});
+    }
+    uint8_t first = (IS31FL3733_I2C_ASYNC_WRITES - 1) * 15, last = (LEDS_PER_DRIVER - 1) / 5 * 15;
+    expected.push_back({first, (uint16_t)(last - first + 1)});
+    EXPECT_EQ(pwm_writes(ADDRESS_1), expected);
+    for (int i = 0; i < LEDS_PER_DRIVER; i += 5) {
+        EXPECT_EQ(i2c_sim_register(ADDRESS_1, i * 3), 9) << "LED " << i;
+    }
+}
+#endif
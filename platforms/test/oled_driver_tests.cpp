@@ -0,0 +1,132 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <string.h>
+#include <vector>
+
+extern "C" {
+#include "oled_driver.h"
+}
+
+#define COLUMN_ADDR 0x21
+#define PAGE_ADDR 0x22
+
+struct Write {
+    uint16_t offset;
+    uint16_t length;
+    bool     operator==(const Write &other) const {
+        return offset == other.offset && length == other.length;
+    }
+};
+
+/* The display memory, written in horizontal addressing mode */
+static uint8_t            display[OLED_MATRIX_SIZE];
+static uint8_t            column_start, column_end, page;
+static uint16_t           column;
+static std::vector<Write> writes;
+
+extern "C" bool oled_send_cmd(const uint8_t *data, uint16_t size) {
+    // Only the address commands of a render are of interest, and they come first
+    if (size == 7 && data[1] == COLUMN_ADDR && data[4] == PAGE_ADDR) {
+        column_start = data[2];
+        column_end   = data[3];
+        page         = data[5];
+        column       = column_start;
+    }
+    return true;
+}
+
+extern "C" bool oled_send_cmd_P(const uint8_t *data, uint16_t size) {
+    return oled_send_cmd(data, size);
+}
+
+extern "C" bool oled_send_data(const uint8_t *data, uint16_t size) {
+    writes.push_back({(uint16_t)(page * OLED_DISPLAY_WIDTH + column), size});
+    for (uint16_t i = 0; i < size; i++) {
+        display[page * OLED_DISPLAY_WIDTH + column] = data[i];
+        if (column++ == column_end) {
+            column = column_start;
+            page++;
+        }
+    }
+    return true;
+}
+
+class OledShadowBuffer : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        memset(display, 0xAA, sizeof(display));
+        oled_init(OLED_ROTATION_0);
+        render();
+    }
+
+    // Renders everything that is dirty, and returns what was written
+    std::vector<Write> render() {
+        writes.clear();
+        oled_render_dirty(true);
+        return writes;
+    }
+
+    void expect_display_matches() {
+        EXPECT_EQ(memcmp(display, oled_read_raw(0).current_element, OLED_MATRIX_SIZE), 0);
+    }
+};
+
+TEST_F(OledShadowBuffer, FirstRenderSendsEverything) {
+    oled_init(OLED_ROTATION_0);
+    uint16_t total = 0;
+    for (const Write &write : render()) {
+        total += write.length;
+    }
+    EXPECT_EQ(total, OLED_MATRIX_SIZE);
+    expect_display_matches();
+}
+
+TEST_F(OledShadowBuffer, UnchangedRedrawSendsNothing) {
+    oled_write_raw_byte(0x55, 10);
+    render();
+
+    // Drawn again with the same contents, the blocks are dirty but nothing differs
+    oled_clear();
+    oled_write_raw_byte(0x55, 10);
+    EXPECT_TRUE(render().empty());
+    expect_display_matches();
+}
+
+TEST_F(OledShadowBuffer, OnlyChangedBytesAreSent) {
+    oled_write_raw_byte(0x55, 200);
+    EXPECT_EQ(render(), (std::vector<Write>{{200, 1}}));
+    expect_display_matches();
+}
+
+TEST_F(OledShadowBuffer, NearbyChangesAreMerged) {
+    oled_write_raw_byte(0x01, 20);
+    oled_write_raw_byte(0x02, 20 + OLED_SHADOW_MAX_GAP + 1);
+    EXPECT_EQ(render(), (std::vector<Write>{{20, OLED_SHADOW_MAX_GAP + 2}}));
+    expect_display_matches();
+}
+
+TEST_F(OledShadowBuffer, DistantChangesAreSeparate) {
+    oled_write_raw_byte(0x01, 20);
+    oled_write_raw_byte(0x02, 20 + OLED_SHADOW_MAX_GAP + 2);
+    EXPECT_EQ(render(), (std::vector<Write>{{20, 1}, {20 + OLED_SHADOW_MAX_GAP + 2, 1}}));
+    expect_display_matches();
+}
+
+TEST_F(OledShadowBuffer, ChangesOnDifferentPagesAreSeparate) {
+    oled_write_raw_byte(0x01, OLED_DISPLAY_WIDTH - 1);
+    oled_write_raw_byte(0x02, OLED_DISPLAY_WIDTH);
+    EXPECT_EQ(render(), (std::vector<Write>{{OLED_DISPLAY_WIDTH - 1, 1}, {OLED_DISPLAY_WIDTH, 1}}));
+    expect_display_matches();
+}
+
+TEST_F(OledShadowBuffer, ScrollingResendsEverything) {
+    oled_scroll_left();
+    oled_scroll_off();
+    uint16_t total = 0;
+    for (const Write &write : render()) {
+        total += write.length;
+    }
+    EXPECT_EQ(total, OLED_MATRIX_SIZE);
+}
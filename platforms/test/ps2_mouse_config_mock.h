@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/* The test drives the clock line itself, and calls the interrupt handler on every edge */
+#define PS2_INT_INIT()
+#define PS2_INT_ON()
+#define PS2_INT_OFF()
+
+#define PS2_MOUSE_INIT_DELAY 0
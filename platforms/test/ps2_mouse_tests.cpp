@@ -0,0 +1,234 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <initializer_list>
+#include <vector>
+
+extern "C" {
+#include "ps2.h"
+#include "ps2_mouse.h"
+#include "timer.h"
+
+void ps2_interrupt_service_routine(void);
+}
+
+int tp_buttons = 0;
+
+static std::vector<report_mouse_t> reports;
+
+extern "C" void host_mouse_send(report_mouse_t *report) {
+    reports.push_back(*report);
+}
+
+/* The lines as the device drives them, the host side is not simulated */
+static bool clock_line = true;
+static bool data_line  = true;
+
+extern "C" {
+void clock_init(void) {}
+void clock_lo(void) {}
+void clock_hi(void) {}
+bool clock_in(void) {
+    return clock_line;
+}
+void data_init(void) {}
+void data_lo(void) {}
+void data_hi(void) {}
+bool data_in(void) {
+    return data_line;
+}
+}
+
+// The device sets the data line while the clock is high, the host reads it on the falling edge
+static void send_bit(bool bit) {
+    data_line  = bit;
+    clock_line = false;
+    ps2_interrupt_service_routine();
+    clock_line = true;
+    ps2_interrupt_service_routine();
+}
+
+static void send_byte(uint8_t byte, bool good_parity = true) {
+    bool parity = good_parity;
+    send_bit(0);
+    for (uint8_t i = 0; i < 8; i++) {
+        bool bit = byte & (1 << i);
+        parity ^= bit;
+        send_bit(bit);
+    }
+    send_bit(parity);
+    send_bit(1);
+}
+
+static void send_packet(std::initializer_list<uint8_t> bytes) {
+    for (uint8_t byte : bytes) {
+        send_byte(byte);
+    }
+}
+
+#define PACKET_FLAGS (1 << 3)
+#define X_NEG (1 << PS2_MOUSE_X_SIGN)
+#define Y_NEG (1 << PS2_MOUSE_Y_SIGN)
+#define LEFT (1 << PS2_MOUSE_BTN_LEFT)
+
+class Ps2Mouse : public testing::Test {
+   protected:
+    static void SetUpTestCase() {
+        // Nothing answers the commands, but it leaves the driver in stream mode
+        ps2_mouse_init();
+    }
+
+    void SetUp() override {
+        timer_clear();
+        reports.clear();
+        ps2_mouse_task();
+        reports.clear();
+    }
+};
+
+TEST_F(Ps2Mouse, MovementReachesHost) {
+    send_packet({PACKET_FLAGS, 10, 3});
+    ps2_mouse_task();
+
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0].x, 10);
+    // Up on PS/2 is down on USB
+    EXPECT_EQ(reports[0].y, -3);
+    EXPECT_EQ(reports[0].buttons, 0);
+}
+
+TEST_F(Ps2Mouse, NegativeMovement) {
+    send_packet({PACKET_FLAGS | X_NEG | Y_NEG, (uint8_t)-10, (uint8_t)-5});
+    ps2_mouse_task();
+
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0].x, -10);
+    EXPECT_EQ(reports[0].y, 5);
+}
+
+TEST_F(Ps2Mouse, PacketsAddUp) {
+    send_packet({PACKET_FLAGS, 10, 0});
+    send_packet({PACKET_FLAGS | X_NEG, (uint8_t)-4, 2});
+    send_packet({PACKET_FLAGS, 10, 0});
+    ps2_mouse_task();
+
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0].x, 16);
+    EXPECT_EQ(reports[0].y, -2);
+}
+
+TEST_F(Ps2Mouse, SumIsLimited) {
+    send_packet({PACKET_FLAGS | X_NEG, (uint8_t)-100, 0});
+    send_packet({PACKET_FLAGS | X_NEG, (uint8_t)-100, 0});
+    send_packet({PACKET_FLAGS | X_NEG, (uint8_t)-100, 0});
+    ps2_mouse_task();
+
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0].x, -127);
+}
+
+TEST_F(Ps2Mouse, ButtonChangesAreKept) {
+    send_packet({PACKET_FLAGS, 1, 0});
+    send_packet({PACKET_FLAGS | LEFT, 1, 0});
+    send_packet({PACKET_FLAGS | LEFT, 1, 0});
+    send_packet({PACKET_FLAGS, 0, 0});
+    ps2_mouse_task();
+
+    ASSERT_EQ(reports.size(), 3);
+    EXPECT_EQ(reports[0].buttons, 0);
+    EXPECT_EQ(reports[0].x, 1);
+    EXPECT_EQ(reports[1].buttons, LEFT);
+    EXPECT_EQ(reports[1].x, 2);
+    EXPECT_EQ(reports[2].buttons, 0);
+    EXPECT_EQ(reports[2].x, 0);
+}
+
+TEST_F(Ps2Mouse, PartialPacketDoesNotBlock) {
+    send_byte(PACKET_FLAGS);
+    send_byte(7);
+    uint32_t start = timer_read32();
+    ps2_mouse_task();
+    EXPECT_EQ(timer_read32(), start);
+    EXPECT_EQ(reports.size(), 0);
+
+    send_byte(0);
+    ps2_mouse_task();
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0].x, 7);
+}
+
+TEST_F(Ps2Mouse, ParityErrorDropsPacket) {
+    send_byte(PACKET_FLAGS);
+    send_byte(20, false);
+    send_byte(0);
+    ps2_mouse_task();
+    EXPECT_EQ(reports.size(), 0);
+
+    send_packet({PACKET_FLAGS, 5, 0});
+    ps2_mouse_task();
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0].x, 5);
+}
+
+TEST_F(Ps2Mouse, LostByteIsResynced) {
+    // The Y byte goes missing, the next packet starts where it should have been
+    send_packet({PACKET_FLAGS, 5});
+    send_packet({PACKET_FLAGS, 1, 0});
+    send_packet({PACKET_FLAGS, 2, 0});
+    send_packet({PACKET_FLAGS, 3, 0});
+    ps2_mouse_task();
+    reports.clear();
+
+    send_packet({PACKET_FLAGS, 9, 0});
+    ps2_mouse_task();
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0].x, 9);
+}
+
+TEST_F(Ps2Mouse, FullBufferDropsWholePackets) {
+    for (int i = 0; i < PS2_PACKET_BUFFER_SIZE + 2; i++) {
+        send_packet({PACKET_FLAGS, 1, 0});
+    }
+    ps2_mouse_task();
+    ASSERT_EQ(reports.size(), 1);
+    EXPECT_EQ(reports[0].x, PS2_PACKET_BUFFER_SIZE - 1);
+
+    // Still in step with the packets
+    send_packet({PACKET_FLAGS, 4, 0});
+    ps2_mouse_task();
+    ASSERT_EQ(reports.size(), 2);
+    EXPECT_EQ(reports[1].x, 4);
+}
+
+TEST_F(Ps2Mouse, ByteModeForResponses) {
+    ps2_host_set_packet_size(0);
+    send_byte(PS2_ACK);
+    EXPECT_EQ(ps2_host_recv(), PS2_ACK);
+    EXPECT_EQ(ps2_error, PS2_ERR_NONE);
+    ps2_host_set_packet_size(3);
+}
+
+TEST_F(Ps2Mouse, MainLoopTimeWithPartialPacket) {
+    // Reading byte by byte, as the mouse task does with the other drivers
+    ps2_host_set_packet_size(0);
+    send_byte(PACKET_FLAGS);
+    uint32_t start = timer_read32();
+    ps2_host_recv_response();
+    ps2_host_recv_response();
+    ps2_host_recv_response();
+    uint32_t bytewise = timer_read32() - start;
+    ps2_host_set_packet_size(3);
+
+    send_byte(PACKET_FLAGS);
+    start = timer_read32();
+    ps2_mouse_task();
+    uint32_t packets = timer_read32() - start;
+
+    EXPECT_GT(bytewise, 0);
+    EXPECT_EQ(packets, 0);
+
+    send_byte(0);
+    send_byte(0);
+    ps2_mouse_task();
+}
@@ -23,3 +23,81 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+i2c_async_INC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_bus_sim
+i2c_async_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_bus_sim/i2c_master.c \
+	$(PLATFORM_PATH)/i2c_async.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_async_tests.cpp
+
+eeprom_i2c_DEFS := -DEEPROM_DRIVER -DEEPROM_I2C -DEEPROM_I2C_24LC256
+eeprom_i2c_INC := \
+	$(TOP_DIR)/drivers/eeprom \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_bus_sim
+eeprom_i2c_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(TOP_DIR)/drivers/eeprom/eeprom_driver.c \
+	$(TOP_DIR)/drivers/eeprom/eeprom_i2c.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_i2c_tests.cpp
+
+is31fl3733_DEFS := \
+	-DIS31FL3733_LED_COUNT=128 \
+	-DIS31FL3733_I2C_ADDRESS_1=0x50 \
+	-DIS31FL3733_I2C_ADDRESS_2=0x5F
+# platforms/ ahead of platforms/test/, so that wait.h finds the _wait.h of the test platform
+is31fl3733_INC := \
+	$(PLATFORM_PATH) \
+	$(TOP_DIR)/drivers/led/issi \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_bus_sim
+is31fl3733_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_bus_sim/i2c_master.c \
+	$(TOP_DIR)/drivers/led/issi/is31_common.c \
+	$(TOP_DIR)/drivers/led/issi/is31fl3733.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/is31fl3733_tests.cpp
+
+is31fl3733_async_DEFS := $(is31fl3733_DEFS) -DI2C_ASYNC_ENABLE -DIS31FL3733_I2C_ASYNC -DIS31FL3733_I2C_ASYNC_WRITES=4
+is31fl3733_async_INC := $(is31fl3733_INC)
+is31fl3733_async_SRC := \
+	$(is31fl3733_SRC) \
+	$(PLATFORM_PATH)/i2c_async.c
+
+serial_usart_dma_DEFS := -DSPLIT_KEYBOARD -DPLATFORM_SUPPORTS_SYNCHRONIZATION -DSERIAL_DRIVER_USART_DMA
+serial_usart_dma_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/serial_usart_dma_config_mock.h
+# uart_sim/ ahead of platforms/test/, so that hal.h and chibios_config.h are those of the simulated UART
+serial_usart_dma_INC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/uart_sim \
+	$(PLATFORM_PATH)/chibios/drivers \
+	$(QUANTUM_PATH)/split_common
+serial_usart_dma_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/uart_sim/uart_sim.c \
+	$(PLATFORM_PATH)/chibios/drivers/serial_usart_dma.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/serial_usart_dma_tests.cpp
+
+bluefruit_le_queue_INC := $(TOP_DIR)/drivers/bluetooth
+bluefruit_le_queue_SRC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/bluefruit_le_queue_tests.cpp
+
+ps2_mouse_DEFS := -DNO_PRINT -DPS2_ENABLE -DPS2_MOUSE_ENABLE -DPS2_DRIVER_INTERRUPT
+ps2_mouse_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/ps2_mouse_config_mock.h
+# platforms/ ahead of platforms/test/, so that wait.h finds the _wait.h of the test platform
+ps2_mouse_INC := \
+	$(PLATFORM_PATH) \
+	$(TOP_DIR)/drivers/ps2
+ps2_mouse_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/logging/debug.c \
+	$(TOP_DIR)/drivers/ps2/ps2_interrupt.c \
+	$(TOP_DIR)/drivers/ps2/ps2_mouse.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/ps2_mouse_tests.cpp
+
+oled_driver_DEFS := -DNO_PRINT -DOLED_ENABLE -DOLED_TRANSPORT_I2C -DOLED_SHADOW_BUFFER
+# platforms/ ahead of platforms/test/, so that wait.h finds the _wait.h of the test platform
+oled_driver_INC := \
+	$(PLATFORM_PATH) \
+	$(TOP_DIR)/drivers/oled \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_bus_sim
+oled_driver_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_bus_sim/i2c_master.c \
+	$(TOP_DIR)/drivers/oled/oled_driver.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/oled_driver_tests.cpp
@@ -0,0 +1,14 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 2
+#define MATRIX_COLS 2
+
+// Transactions of the test, which sets up their buffers itself
+#define SPLIT_TRANSACTION_IDS_USER TEST_PUT, TEST_GET, TEST_RPC
+
+#define SERIAL_USART_FULL_DUPLEX
+// There is no MCU to take the default configuration from
+#define SERIAL_USART_CONFIG \
+    { .speed = SERIAL_USART_SPEED }
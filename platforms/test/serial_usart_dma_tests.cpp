@@ -0,0 +1,282 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <cstring>
+#include <vector>
+
+// the split headers are C11, map their assertions onto the C++ keyword
+#define _Static_assert static_assert
+
+extern "C" {
+#include "serial.h"
+#include "synchronization_util.h"
+#include "transactions.h"
+#include "transport.h"
+#include <hal.h>
+}
+
+static split_shared_memory_t shmem;
+split_shared_memory_t *const split_shmem = &shmem;
+split_transaction_desc_t     split_transaction_table[NUM_TOTAL_TRANSACTIONS];
+static uint8_t *const        memory = (uint8_t *)&shmem;
+
+// Buffers of the test transactions, at the start of split_shmem
+#define PUT_OFFSET 0
+#define GET_OFFSET 8
+#define RPC_IN_OFFSET 16
+#define RPC_OUT_OFFSET 20
+
+static const std::vector<uint8_t> put_data = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+static const std::vector<uint8_t> get_data = {0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6};
+static const std::vector<uint8_t> rpc_data = {0x01, 0x02, 0x03, 0x04};
+
+static int rpc_calls;
+
+static void rpc_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    for (uint8_t i = 0; i < target2initiator_buffer_size; i++) {
+        ((uint8_t *)target2initiator_buffer)[i] = ((const uint8_t *)initiator2target_buffer)[i] + 0x10;
+    }
+    rpc_calls++;
+}
+
+static std::vector<uint8_t> handshake(uint8_t id, const std::vector<uint8_t> &data = {}) {
+    std::vector<uint8_t> bytes = {(uint8_t)(id ^ NUM_TOTAL_TRANSACTIONS)};
+    bytes.insert(bytes.end(), data.begin(), data.end());
+    return bytes;
+}
+
+static std::vector<uint8_t> with_id(uint8_t id, const std::vector<uint8_t> &data = {}) {
+    std::vector<uint8_t> bytes = {id};
+    bytes.insert(bytes.end(), data.begin(), data.end());
+    return bytes;
+}
+
+static void receive(const std::vector<uint8_t> &bytes) {
+    uart_sim_receive(bytes.data(), bytes.size());
+}
+
+static std::vector<uint8_t> sent() {
+    return std::vector<uint8_t>(uart_sim_sent(), uart_sim_sent() + uart_sim_sent_count());
+}
+
+static std::vector<uint8_t> memory_at(size_t offset, size_t size) {
+    return std::vector<uint8_t>(memory + offset, memory + offset + size);
+}
+
+class SerialUsartDma : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        memset(&shmem, 0, sizeof(shmem));
+        memset(split_transaction_table, 0, sizeof(split_transaction_table));
+        split_transaction_table[TEST_PUT] = {(uint8_t)put_data.size(), PUT_OFFSET, 0, 0, NULL};
+        split_transaction_table[TEST_GET] = {0, 0, (uint8_t)get_data.size(), GET_OFFSET, NULL};
+        split_transaction_table[TEST_RPC] = {(uint8_t)rpc_data.size(), RPC_IN_OFFSET, (uint8_t)rpc_data.size(), RPC_OUT_OFFSET, rpc_callback};
+        rpc_calls = 0;
+        uart_sim_reset();
+    }
+
+    void TearDown() override {
+        EXPECT_EQ(uart_sim_misuse_count(), 0);
+    }
+};
+
+class SerialUsartDmaSlave : public SerialUsartDma {
+   protected:
+    void SetUp() override {
+        SerialUsartDma::SetUp();
+        memcpy(memory + GET_OFFSET, get_data.data(), get_data.size());
+        soft_serial_target_init();
+    }
+
+    void TearDown() override {
+        // Every test leaves the slave ready for the next transaction
+        EXPECT_FALSE(uart_sim_timer_armed());
+        SerialUsartDma::TearDown();
+    }
+};
+
+TEST_F(SerialUsartDmaSlave, AnswersStraightFromSharedMemory) {
+    receive(with_id(TEST_GET));
+    uart_sim_flush();
+    EXPECT_EQ(sent(), handshake(TEST_GET, get_data));
+}
+
+TEST_F(SerialUsartDmaSlave, AnswersBeforeTheBufferIsIn) {
+    receive(with_id(TEST_PUT));
+    EXPECT_TRUE(uart_sim_send_pending());
+    uart_sim_flush();
+    EXPECT_EQ(sent(), handshake(TEST_PUT));
+    EXPECT_TRUE(uart_sim_timer_armed());
+
+    receive(put_data);
+    EXPECT_EQ(memory_at(PUT_OFFSET, put_data.size()), put_data);
+}
+
+TEST_F(SerialUsartDmaSlave, BufferWaitsForTheLock) {
+    const std::vector<uint8_t> untouched(put_data.size(), 0);
+
+    split_shared_memory_lock();
+    receive(with_id(TEST_PUT, put_data));
+    uart_sim_flush();
+    // Neither written nor answered while a thread holds the shared memory
+    EXPECT_EQ(memory_at(PUT_OFFSET, put_data.size()), untouched);
+    EXPECT_EQ(sent(), std::vector<uint8_t>{});
+
+    split_shared_memory_unlock();
+    EXPECT_EQ(memory_at(PUT_OFFSET, put_data.size()), put_data);
+    uart_sim_flush();
+    EXPECT_EQ(sent(), handshake(TEST_PUT));
+}
+
+TEST_F(SerialUsartDmaSlave, LockReleasedWhileReceiving) {
+    const std::vector<uint8_t> untouched(put_data.size(), 0);
+
+    split_shared_memory_lock();
+    receive(with_id(TEST_PUT, {put_data.begin(), put_data.begin() + 2}));
+    split_shared_memory_unlock();
+    uart_sim_flush();
+    EXPECT_EQ(sent(), handshake(TEST_PUT));
+    EXPECT_EQ(memory_at(PUT_OFFSET, put_data.size()), untouched);
+
+    receive({put_data.begin() + 2, put_data.end()});
+    EXPECT_EQ(memory_at(PUT_OFFSET, put_data.size()), put_data);
+}
+
+TEST_F(SerialUsartDmaSlave, LockWaitsForTheAnswer) {
+    receive(with_id(TEST_GET));
+    ASSERT_TRUE(uart_sim_send_pending());
+
+    // The DMA still reads the target2initiator buffer, so the lock is only granted once it is out
+    split_shared_memory_lock();
+    EXPECT_FALSE(uart_sim_send_pending());
+    EXPECT_EQ(sent(), handshake(TEST_GET, get_data));
+    split_shared_memory_unlock();
+}
+
+TEST_F(SerialUsartDmaSlave, CallbackRunsFromTheMainLoop) {
+    receive(with_id(TEST_RPC, rpc_data));
+    uart_sim_flush();
+    EXPECT_EQ(rpc_calls, 0);
+    EXPECT_EQ(sent(), std::vector<uint8_t>{});
+
+    soft_serial_target_task();
+    EXPECT_EQ(rpc_calls, 1);
+    uart_sim_flush();
+    EXPECT_EQ(sent(), handshake(TEST_RPC, {0x11, 0x12, 0x13, 0x14}));
+
+    // Nothing left to do
+    soft_serial_target_task();
+    EXPECT_EQ(rpc_calls, 1);
+}
+
+TEST_F(SerialUsartDmaSlave, CallbackWaitsForTheLockedBuffer) {
+    split_shared_memory_lock();
+    receive(with_id(TEST_RPC, rpc_data));
+    split_shared_memory_unlock();
+
+    soft_serial_target_task();
+    EXPECT_EQ(rpc_calls, 1);
+    EXPECT_EQ(memory_at(RPC_IN_OFFSET, rpc_data.size()), rpc_data);
+    uart_sim_flush();
+    EXPECT_EQ(sent(), handshake(TEST_RPC, {0x11, 0x12, 0x13, 0x14}));
+}
+
+TEST_F(SerialUsartDmaSlave, TimeoutDropsTheTransaction) {
+    receive(with_id(TEST_PUT, {put_data.begin(), put_data.begin() + 2}));
+    uart_sim_flush();
+    uart_sim_fire_timer();
+    uart_sim_reset_log();
+
+    // Ids that arrive without a transaction in flight start a new one
+    receive(with_id(TEST_GET));
+    uart_sim_flush();
+    EXPECT_EQ(sent(), handshake(TEST_GET, get_data));
+}
+
+TEST_F(SerialUsartDmaSlave, TimeoutWhileLockedDropsTheBuffer) {
+    const std::vector<uint8_t> untouched(put_data.size(), 0);
+
+    split_shared_memory_lock();
+    receive(with_id(TEST_PUT, put_data));
+    uart_sim_fire_timer();
+    split_shared_memory_unlock();
+    uart_sim_flush();
+    EXPECT_EQ(memory_at(PUT_OFFSET, put_data.size()), untouched);
+    EXPECT_EQ(sent(), std::vector<uint8_t>{});
+}
+
+TEST_F(SerialUsartDmaSlave, IgnoresInvalidIds) {
+    receive({NUM_TOTAL_TRANSACTIONS});
+    uart_sim_flush();
+    EXPECT_EQ(sent(), std::vector<uint8_t>{});
+    EXPECT_FALSE(uart_sim_timer_armed());
+}
+
+static std::vector<uint8_t> peer_answer;
+static bool                 peer_answered;
+
+// Answers as the slave does, as soon as the transaction id is out
+static bool answering_peer(void) {
+    if (peer_answered || uart_sim_sent_count() == 0) {
+        return false;
+    }
+    peer_answered = true;
+    receive(peer_answer);
+    return true;
+}
+
+class SerialUsartDmaMaster : public SerialUsartDma {
+   protected:
+    void SetUp() override {
+        SerialUsartDma::SetUp();
+        memcpy(memory + PUT_OFFSET, put_data.data(), put_data.size());
+        memcpy(memory + RPC_IN_OFFSET, rpc_data.data(), rpc_data.size());
+        soft_serial_initiator_init();
+        peer_answered = false;
+        uart_sim_set_peer(answering_peer);
+    }
+};
+
+TEST_F(SerialUsartDmaMaster, Get) {
+    peer_answer = handshake(TEST_GET, get_data);
+    EXPECT_TRUE(soft_serial_transaction(TEST_GET));
+    EXPECT_EQ(sent(), with_id(TEST_GET));
+    EXPECT_EQ(memory_at(GET_OFFSET, get_data.size()), get_data);
+}
+
+TEST_F(SerialUsartDmaMaster, AnswerOverlapsTheBuffer) {
+    // The peer answers right after the id, before the master's buffer went out
+    peer_answer = handshake(TEST_RPC, {0x11, 0x12, 0x13, 0x14});
+    EXPECT_TRUE(soft_serial_transaction(TEST_RPC));
+    EXPECT_EQ(sent(), with_id(TEST_RPC, rpc_data));
+    EXPECT_EQ(memory_at(RPC_OUT_OFFSET, 4), (std::vector<uint8_t>{0x11, 0x12, 0x13, 0x14}));
+}
+
+TEST_F(SerialUsartDmaMaster, WrongHandshake) {
+    peer_answer = handshake(TEST_GET, get_data);
+    EXPECT_FALSE(soft_serial_transaction(TEST_PUT));
+}
+
+TEST_F(SerialUsartDmaMaster, NoAnswer) {
+    peer_answered = true;
+    EXPECT_FALSE(soft_serial_transaction(TEST_PUT));
+    EXPECT_FALSE(uart_sim_send_pending());
+
+    // The next transaction starts over
+    uart_sim_reset_log();
+    peer_answered = false;
+    peer_answer   = handshake(TEST_GET, get_data);
+    EXPECT_TRUE(soft_serial_transaction(TEST_GET));
+    EXPECT_EQ(memory_at(GET_OFFSET, get_data.size()), get_data);
+}
+
+TEST_F(SerialUsartDmaMaster, ShortAnswer) {
+    peer_answer = handshake(TEST_GET, {get_data.begin(), get_data.begin() + 3});
+    EXPECT_FALSE(soft_serial_transaction(TEST_GET));
+}
+
+TEST_F(SerialUsartDmaMaster, IllegalId) {
+    EXPECT_FALSE(soft_serial_transaction(NUM_TOTAL_TRANSACTIONS));
+    EXPECT_EQ(sent(), std::vector<uint8_t>{});
+}
@@ -1 +1 @@
-TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large
+TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large eeprom_i2c i2c_async is31fl3733 is31fl3733_async serial_usart_dma bluefruit_le_queue ps2_mouse oled_driver
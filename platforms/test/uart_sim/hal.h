@@ -0,0 +1,119 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Simulated ChibiOS UART driver for unit tests.
+ *
+ * Offers the parts of the UART driver and the OSAL that the split serial
+ * drivers use, with a single thread: the test. Bytes the other half sends are
+ * handed to the driver by the test, which also decides when a send completes
+ * or a timer runs out, and the driver callbacks run right away as interrupts
+ * would. A thread that waits for the driver gets the sends in progress
+ * completed and the peer called, until it is woken up or nothing happens any
+ * more.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef TRUE
+#    define TRUE 1
+#endif
+#ifndef FALSE
+#    define FALSE 0
+#endif
+
+#define HAL_USE_UART TRUE
+
+#define likely(x) __builtin_expect(!!(x), 1)
+#define unlikely(x) __builtin_expect(!!(x), 0)
+
+typedef int32_t  msg_t;
+typedef uint32_t sysinterval_t;
+
+#define MSG_OK ((msg_t)0)
+#define MSG_TIMEOUT ((msg_t)-1)
+#define MSG_RESET ((msg_t)-2)
+
+#define TIME_INFINITE ((sysinterval_t)-1)
+#define TIME_MS2I(ms) ((sysinterval_t)(ms))
+
+typedef struct ch_thread thread_t;
+typedef thread_t        *thread_reference_t;
+
+typedef struct {
+    bool waiting;
+} threads_queue_t;
+
+typedef struct ch_virtual_timer virtual_timer_t;
+typedef void (*vtfunc_t)(virtual_timer_t *vtp, void *p);
+struct ch_virtual_timer {
+    vtfunc_t func;
+    void    *par;
+};
+
+void  osalSysLock(void);
+void  osalSysUnlock(void);
+void  osalSysLockFromISR(void);
+void  osalSysUnlockFromISR(void);
+void  osalOsRescheduleS(void);
+void  osalThreadQueueObjectInit(threads_queue_t *tqp);
+msg_t osalThreadEnqueueTimeoutS(threads_queue_t *tqp, sysinterval_t timeout);
+void  osalThreadDequeueNextI(threads_queue_t *tqp, msg_t msg);
+void  osalThreadDequeueAllI(threads_queue_t *tqp, msg_t msg);
+msg_t osalThreadSuspendTimeoutS(thread_reference_t *trp, sysinterval_t timeout);
+void  osalThreadResumeI(thread_reference_t *trp, msg_t msg);
+void  chVTObjectInit(virtual_timer_t *vtp);
+void  chVTSetI(virtual_timer_t *vtp, sysinterval_t delay, vtfunc_t vtfunc, void *par);
+void  chVTResetI(virtual_timer_t *vtp);
+
+typedef uint32_t               uartflags_t;
+typedef struct hal_uart_driver UARTDriver;
+typedef void (*uartcb_t)(UARTDriver *uartp);
+typedef void (*uartccb_t)(UARTDriver *uartp, uint16_t c);
+typedef void (*uartecb_t)(UARTDriver *uartp, uartflags_t e);
+
+typedef struct hal_uart_config {
+    uartcb_t  txend1_cb;
+    uartcb_t  txend2_cb;
+    uartcb_t  rxend_cb;
+    uartccb_t rxchar_cb;
+    uartecb_t rxerr_cb;
+    uint32_t  speed;
+} UARTConfig;
+
+struct hal_uart_driver {
+    const UARTConfig *config;
+};
+
+extern UARTDriver UARTD1;
+
+void   uartStart(UARTDriver *uartp, const UARTConfig *config);
+void   uartStartSendI(UARTDriver *uartp, size_t n, const void *txbuf);
+void   uartStartReceiveI(UARTDriver *uartp, size_t n, void *rxbuf);
+size_t uartStopSendI(UARTDriver *uartp);
+size_t uartStopReceiveI(UARTDriver *uartp);
+
+// There are no pins to set up
+#define palSetLineMode(line, mode) \
+    do {                           \
+    } while (0)
+
+#ifndef UART_SIM_LOG_SIZE
+#    define UART_SIM_LOG_SIZE 256
+#endif
+
+void           uart_sim_reset(void);
+void           uart_sim_reset_log(void);
+void           uart_sim_receive(const uint8_t *data, size_t length);
+void           uart_sim_receive_error(void);
+bool           uart_sim_send_pending(void);
+bool           uart_sim_complete_send(void);
+void           uart_sim_flush(void);
+bool           uart_sim_timer_armed(void);
+void           uart_sim_fire_timer(void);
+void           uart_sim_set_peer(bool (*peer)(void));
+size_t         uart_sim_sent_count(void);
+const uint8_t *uart_sim_sent(void);
+uint16_t       uart_sim_misuse_count(void);
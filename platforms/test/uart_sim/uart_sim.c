@@ -0,0 +1,293 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal.h"
+
+struct ch_thread {
+    int unused;
+};
+
+UARTDriver UARTD1;
+
+static struct {
+    const uint8_t *buffer;
+    size_t         size;
+} uart_sim_tx;
+
+static struct {
+    uint8_t *buffer;
+    size_t   size;
+    size_t   done;
+} uart_sim_rx;
+
+static thread_t         uart_sim_thread;
+static msg_t            uart_sim_wake_msg;
+static virtual_timer_t *uart_sim_timer;
+static bool (*uart_sim_peer)(void);
+static uint8_t  uart_sim_log[UART_SIM_LOG_SIZE];
+static size_t   uart_sim_log_count;
+static int      uart_sim_lock_depth;
+static uint16_t uart_sim_misuse;
+
+// I-class and S-class calls need the system locked, lock calls must not nest
+static void uart_sim_check_locked(void) {
+    if (uart_sim_lock_depth != 1) {
+        uart_sim_misuse++;
+    }
+}
+
+static void uart_sim_lock(void) {
+    if (uart_sim_lock_depth++ != 0) {
+        uart_sim_misuse++;
+    }
+}
+
+static void uart_sim_unlock(void) {
+    if (--uart_sim_lock_depth != 0) {
+        uart_sim_misuse++;
+    }
+}
+
+// Time passes for a waiting thread: the next send completes, or else the peer answers, or else the timer runs out
+static bool uart_sim_step(void) {
+    if (uart_sim_complete_send()) {
+        return true;
+    }
+    if (uart_sim_peer && uart_sim_peer()) {
+        return true;
+    }
+    if (uart_sim_timer_armed()) {
+        uart_sim_fire_timer();
+        return true;
+    }
+    return false;
+}
+
+void osalSysLock(void) {
+    uart_sim_lock();
+}
+
+void osalSysUnlock(void) {
+    uart_sim_unlock();
+}
+
+void osalSysLockFromISR(void) {
+    uart_sim_lock();
+}
+
+void osalSysUnlockFromISR(void) {
+    uart_sim_unlock();
+}
+
+void osalOsRescheduleS(void) {
+    uart_sim_check_locked();
+}
+
+void osalThreadQueueObjectInit(threads_queue_t *tqp) {
+    tqp->waiting = false;
+}
+
+msg_t osalThreadEnqueueTimeoutS(threads_queue_t *tqp, sysinterval_t timeout) {
+    uart_sim_check_locked();
+    tqp->waiting = true;
+    // The system is unlocked while the thread sleeps
+    uart_sim_lock_depth--;
+    while (tqp->waiting && uart_sim_step()) {
+    }
+    uart_sim_lock_depth++;
+
+    if (tqp->waiting) {
+        tqp->waiting = false;
+        if (timeout == TIME_INFINITE) {
+            fprintf(stderr, "uart_sim: thread waits for a queue that is never woken up\n");
+            abort();
+        }
+        return MSG_TIMEOUT;
+    }
+    return uart_sim_wake_msg;
+}
+
+void osalThreadDequeueNextI(threads_queue_t *tqp, msg_t msg) {
+    uart_sim_check_locked();
+    if (tqp->waiting) {
+        tqp->waiting      = false;
+        uart_sim_wake_msg = msg;
+    }
+}
+
+void osalThreadDequeueAllI(threads_queue_t *tqp, msg_t msg) {
+    osalThreadDequeueNextI(tqp, msg);
+}
+
+msg_t osalThreadSuspendTimeoutS(thread_reference_t *trp, sysinterval_t timeout) {
+    uart_sim_check_locked();
+    *trp = &uart_sim_thread;
+    uart_sim_lock_depth--;
+    while (*trp != NULL && uart_sim_step()) {
+    }
+    uart_sim_lock_depth++;
+
+    if (*trp != NULL) {
+        *trp = NULL;
+        return MSG_TIMEOUT;
+    }
+    return uart_sim_wake_msg;
+}
+
+void osalThreadResumeI(thread_reference_t *trp, msg_t msg) {
+    uart_sim_check_locked();
+    if (*trp != NULL) {
+        *trp              = NULL;
+        uart_sim_wake_msg = msg;
+    }
+}
+
+void chVTObjectInit(virtual_timer_t *vtp) {
+    vtp->func = NULL;
+}
+
+void chVTSetI(virtual_timer_t *vtp, sysinterval_t delay, vtfunc_t vtfunc, void *par) {
+    uart_sim_check_locked();
+    vtp->func      = vtfunc;
+    vtp->par       = par;
+    uart_sim_timer = vtp;
+}
+
+void chVTResetI(virtual_timer_t *vtp) {
+    uart_sim_check_locked();
+    vtp->func = NULL;
+}
+
+void uartStart(UARTDriver *uartp, const UARTConfig *config) {
+    uartp->config = config;
+}
+
+void uartStartSendI(UARTDriver *uartp, size_t n, const void *txbuf) {
+    uart_sim_check_locked();
+    if (uart_sim_tx.size) {
+        uart_sim_misuse++;
+    }
+    uart_sim_tx.buffer = txbuf;
+    uart_sim_tx.size   = n;
+}
+
+void uartStartReceiveI(UARTDriver *uartp, size_t n, void *rxbuf) {
+    uart_sim_check_locked();
+    if (uart_sim_rx.size) {
+        uart_sim_misuse++;
+    }
+    uart_sim_rx.buffer = rxbuf;
+    uart_sim_rx.size   = n;
+    uart_sim_rx.done   = 0;
+}
+
+size_t uartStopSendI(UARTDriver *uartp) {
+    uart_sim_check_locked();
+    size_t remaining = uart_sim_tx.size;
+    uart_sim_tx.size = 0;
+    return remaining;
+}
+
+size_t uartStopReceiveI(UARTDriver *uartp) {
+    uart_sim_check_locked();
+    size_t remaining = uart_sim_rx.size - uart_sim_rx.done;
+    uart_sim_rx.size = 0;
+    return remaining;
+}
+
+void uart_sim_reset(void) {
+    memset(&UARTD1, 0, sizeof(UARTD1));
+    memset(&uart_sim_tx, 0, sizeof(uart_sim_tx));
+    memset(&uart_sim_rx, 0, sizeof(uart_sim_rx));
+    uart_sim_timer      = NULL;
+    uart_sim_peer       = NULL;
+    uart_sim_lock_depth = 0;
+    uart_sim_misuse     = 0;
+    uart_sim_reset_log();
+}
+
+void uart_sim_reset_log(void) {
+    uart_sim_log_count = 0;
+}
+
+// The other half sends bytes, which end up in the receive in progress or else go to the character callback
+void uart_sim_receive(const uint8_t *data, size_t length) {
+    const UARTConfig *config = UARTD1.config;
+    for (size_t i = 0; i < length; i++) {
+        if (uart_sim_rx.size) {
+            uart_sim_rx.buffer[uart_sim_rx.done++] = data[i];
+            if (uart_sim_rx.done == uart_sim_rx.size) {
+                uart_sim_rx.size = 0;
+                if (config->rxend_cb) {
+                    config->rxend_cb(&UARTD1);
+                }
+            }
+        } else if (config->rxchar_cb) {
+            config->rxchar_cb(&UARTD1, data[i]);
+        }
+    }
+}
+
+void uart_sim_receive_error(void) {
+    if (UARTD1.config->rxerr_cb) {
+        UARTD1.config->rxerr_cb(&UARTD1, 0);
+    }
+}
+
+bool uart_sim_send_pending(void) {
+    return uart_sim_tx.size != 0;
+}
+
+// The send in progress goes out on the wire, the DMA reads the buffer only now
+bool uart_sim_complete_send(void) {
+    if (!uart_sim_tx.size) {
+        return false;
+    }
+    for (size_t i = 0; i < uart_sim_tx.size && uart_sim_log_count < UART_SIM_LOG_SIZE; i++) {
+        uart_sim_log[uart_sim_log_count++] = uart_sim_tx.buffer[i];
+    }
+    uart_sim_tx.size = 0;
+    if (UARTD1.config->txend1_cb) {
+        UARTD1.config->txend1_cb(&UARTD1);
+    }
+    return true;
+}
+
+// Completes sends until there are none in progress, including those started by the driver callbacks
+void uart_sim_flush(void) {
+    while (uart_sim_complete_send()) {
+    }
+}
+
+bool uart_sim_timer_armed(void) {
+    return uart_sim_timer && uart_sim_timer->func;
+}
+
+void uart_sim_fire_timer(void) {
+    if (uart_sim_timer_armed()) {
+        vtfunc_t func        = uart_sim_timer->func;
+        uart_sim_timer->func = NULL;
+        func(uart_sim_timer, uart_sim_timer->par);
+    }
+}
+
+// Called while a thread waits for the driver, returns true if it sent anything
+void uart_sim_set_peer(bool (*peer)(void)) {
+    uart_sim_peer = peer;
+}
+
+size_t uart_sim_sent_count(void) {
+    return uart_sim_log_count;
+}
+
+const uint8_t *uart_sim_sent(void) {
+    return uart_sim_log;
+}
+
+// Calls made without the system locked when they need it, nested locks and transfers started on top of another
+uint16_t uart_sim_misuse_count(void) {
+    return uart_sim_misuse;
+}
@@ -23,5 +23,14 @@
 
 #define FREQUENCY_LUT_LENGTH 349
 
+/* one period of a waveform, with samples ranging from 0 to WAVETABLE_MAX */
+#define WAVETABLE_LENGTH 256
+#define WAVETABLE_MAX 4095
+
 extern const float    vibrato_lut[VIBRATO_LUT_LENGTH];
+extern const uint16_t vibrato_fixed_lut[VIBRATO_LUT_LENGTH]; // vibrato_lut in 1.15 fixed point
 extern const uint16_t frequency_lut[FREQUENCY_LUT_LENGTH];
+
+extern const uint16_t wavetable_sine[WAVETABLE_LENGTH];
+extern const uint16_t wavetable_triangle[WAVETABLE_LENGTH];
+extern const uint16_t wavetable_trapezoid[WAVETABLE_LENGTH];
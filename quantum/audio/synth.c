@@ -0,0 +1,47 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synth.h"
+
+uint32_t synth_phase_increment(float frequency, uint32_t sample_rate) {
+    if (frequency <= 0.0f || frequency >= sample_rate) {
+        return 0;
+    }
+    return (uint32_t)(frequency * (4294967296.0f / sample_rate));
+}
+
+void synth_set_frequency(synth_oscillator_t *oscillator, float frequency, uint32_t sample_rate) {
+    oscillator->increment = synth_phase_increment(frequency, sample_rate);
+}
+
+uint16_t synth_mix(synth_oscillator_t *oscillators, uint8_t count, const uint16_t *wavetable, uint32_t wavetable_length) {
+    uint32_t sum = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        oscillators[i].phase += oscillators[i].increment;
+
+        // scale the upper half of the phase to the wavetable, which works for any length up to 2^16
+        sum += wavetable[((oscillators[i].phase >> 16) * wavetable_length) >> 16];
+    }
+
+    return sum / count;
+}
+
+void synth_render(synth_oscillator_t *oscillators, uint8_t count, const uint16_t *wavetable, uint32_t wavetable_length, uint16_t *buffer, size_t samples) {
+    for (size_t i = 0; i < samples; i++) {
+        buffer[i] = synth_mix(oscillators, count, wavetable, wavetable_length);
+    }
+}
@@ -0,0 +1,62 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Fixed point wavetable synthesis
+
+  every tone is an oscillator stepping through one period of a wavetable, with its position kept
+  in a phase accumulator: a full period of the wavetable is 2^32, so the accumulator wraps around
+  on its own, and a tone's frequency is the step it takes each sample
+
+  the frequency only needs converting when a tone changes, generating samples is integer math only
+*/
+
+typedef struct {
+    uint32_t phase;     // position in the wavetable, a full period is 2^32
+    uint32_t increment; // phase advance per sample
+} synth_oscillator_t;
+
+/**
+ * @brief convert a frequency to the phase increment of an oscillator
+ * @param[in] frequency: in Hz, below sample_rate
+ * @param[in] sample_rate: in samples per second
+ */
+uint32_t synth_phase_increment(float frequency, uint32_t sample_rate);
+
+/**
+ * @brief set the frequency of an oscillator, keeping its phase
+ */
+void synth_set_frequency(synth_oscillator_t *oscillator, float frequency, uint32_t sample_rate);
+
+/**
+ * @brief advance the oscillators by one sample and mix them by additive synthesis
+ * @param[in,out] oscillators: the tones to mix
+ * @param[in] count: number of oscillators, at least one
+ * @param[in] wavetable: one period of the waveform
+ * @param[in] wavetable_length: number of samples in the wavetable, at most 65536
+ * @return the average of the oscillators' samples
+ */
+uint16_t synth_mix(synth_oscillator_t *oscillators, uint8_t count, const uint16_t *wavetable, uint32_t wavetable_length);
+
+/**
+ * @brief render a number of samples, see synth_mix
+ */
+void synth_render(synth_oscillator_t *oscillators, uint8_t count, const uint16_t *wavetable, uint32_t wavetable_length, uint16_t *buffer, size_t samples);
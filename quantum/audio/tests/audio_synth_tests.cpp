@@ -0,0 +1,174 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+extern "C" {
+#include "synth.h"
+#include "luts.h"
+#include "musical_notes.h"
+#include "voices.h"
+#include "timer.h"
+void set_time(uint32_t t);
+float voice_add_vibrato(float average_freq);
+}
+
+namespace {
+
+const uint32_t sample_rate = 44100 * 3 / 2;
+
+// The float additive synthesis the DAC driver used before, rendered to a PCM buffer
+std::vector<uint16_t> render_float(const std::vector<float> &frequencies, const uint16_t *wavetable, size_t samples) {
+    std::vector<float>    position(frequencies.size(), 0.0f);
+    std::vector<uint16_t> buffer;
+    for (size_t s = 0; s < samples; s++) {
+        uint_fast16_t value = 0;
+        for (size_t i = 0; i < frequencies.size(); i++) {
+            position[i] += frequencies[i] * ((float)WAVETABLE_LENGTH / sample_rate);
+            while (position[i] >= WAVETABLE_LENGTH)
+                position[i] -= WAVETABLE_LENGTH;
+            value += wavetable[(size_t)position[i]] / frequencies.size();
+        }
+        buffer.push_back(value);
+    }
+    return buffer;
+}
+
+std::vector<uint16_t> render_fixed(const std::vector<float> &frequencies, const uint16_t *wavetable, size_t samples) {
+    std::vector<synth_oscillator_t> oscillators(frequencies.size());
+    for (size_t i = 0; i < frequencies.size(); i++) {
+        oscillators[i] = {};
+        synth_set_frequency(&oscillators[i], frequencies[i], sample_rate);
+    }
+    std::vector<uint16_t> buffer(samples);
+    synth_render(oscillators.data(), oscillators.size(), wavetable, WAVETABLE_LENGTH, buffer.data(), samples);
+    return buffer;
+}
+
+unsigned largest_step(const uint16_t *wavetable) {
+    unsigned step = 0;
+    for (size_t i = 0; i < WAVETABLE_LENGTH; i++) {
+        step = std::max(step, (unsigned)std::abs(wavetable[(i + 1) % WAVETABLE_LENGTH] - wavetable[i]));
+    }
+    return step;
+}
+
+} // namespace
+
+TEST(AudioSynth, PhaseIncrementMatchesFrequency) {
+    for (float frequency : {NOTE_C0, NOTE_A4, NOTE_B8, 10000.0f}) {
+        const uint32_t increment = synth_phase_increment(frequency, sample_rate);
+        EXPECT_NEAR((double)increment * sample_rate / 4294967296.0, frequency, frequency * 1e-6) << frequency << " Hz";
+    }
+    EXPECT_EQ(synth_phase_increment(0.0f, sample_rate), 0);
+    EXPECT_EQ(synth_phase_increment(sample_rate, sample_rate), 0);
+}
+
+TEST(AudioSynth, MatchesFloatReference) {
+    const std::vector<std::vector<float>> chords = {
+        {NOTE_A4},
+        {NOTE_C4, NOTE_E4, NOTE_G4},
+        {NOTE_C2, NOTE_C5, NOTE_C6, NOTE_B7, NOTE_C8, NOTE_A3, NOTE_GS4, NOTE_D5},
+    };
+    const size_t samples = sample_rate / 4;
+
+    for (const uint16_t *wavetable : {wavetable_sine, wavetable_triangle, wavetable_trapezoid}) {
+        const unsigned step = largest_step(wavetable);
+        for (const auto &chord : chords) {
+            const auto reference = render_float(chord, wavetable, samples);
+            const auto fixed     = render_fixed(chord, wavetable, samples);
+
+            double   error   = 0;
+            unsigned largest = 0;
+            for (size_t s = 0; s < samples; s++) {
+                const unsigned difference = std::abs(fixed[s] - reference[s]);
+                largest                   = std::max(largest, difference);
+                error += difference;
+            }
+
+            // Either may land on the neighbouring sample of a tone now and then, and the float one rounds down each tone on its own
+            EXPECT_LE(largest, step + chord.size()) << chord.size() << " tones";
+            EXPECT_LT(error / samples, WAVETABLE_MAX / 400.0) << chord.size() << " tones";
+        }
+    }
+}
+
+TEST(AudioSynth, KeepsPhaseWhenFrequencyChanges) {
+    synth_oscillator_t oscillator = {};
+    synth_set_frequency(&oscillator, NOTE_A4, sample_rate);
+
+    uint16_t buffer[100];
+    synth_render(&oscillator, 1, wavetable_sine, WAVETABLE_LENGTH, buffer, 100);
+    const uint32_t phase = oscillator.phase;
+    EXPECT_EQ(phase, 100 * oscillator.increment);
+
+    synth_set_frequency(&oscillator, NOTE_A5, sample_rate);
+    EXPECT_EQ(oscillator.phase, phase);
+}
+
+TEST(AudioSynth, SquareWaveOfTwoSamples) {
+    const uint16_t     square[2]  = {0, 4095};
+    synth_oscillator_t oscillator = {};
+    synth_set_frequency(&oscillator, sample_rate / 8.0f, sample_rate);
+
+    uint16_t buffer[16];
+    synth_render(&oscillator, 1, square, 2, buffer, 16);
+    for (size_t s = 0; s < 16; s++) {
+        EXPECT_EQ(buffer[s], (s + 1) % 8 < 4 ? 0 : 4095) << "sample " << s;
+    }
+}
+
+TEST(AudioSynth, VibratoMatchesFloatReference) {
+    set_voice(vibrating);
+
+    for (float strength : {0.25f, 0.5f, 1.0f, 2.0f}) {
+        for (float rate : {0.125f, 0.5f, 2.0f}) {
+            voice_set_vibrato_strength(strength);
+            voice_set_vibrato_rate(rate);
+
+            for (uint32_t t = 0; t < 10000; t += 7) {
+                set_time(t);
+                const float counter   = std::fmod(t / (100 * rate), VIBRATO_LUT_LENGTH);
+                const float reference = NOTE_A4 * std::pow(vibrato_lut[(int)counter], strength);
+                EXPECT_NEAR(voice_add_vibrato(NOTE_A4), reference, reference * 1e-4) << "strength " << strength << ", rate " << rate << ", at " << t << " ms";
+            }
+        }
+    }
+
+    set_voice(default_voice);
+}
+
+TEST(AudioSynth, VibratoAcrossOctaves) {
+    set_voice(vibrating);
+    voice_set_vibrato_strength(1.0f);
+    voice_set_vibrato_rate(0.125f);
+
+    for (float frequency : {NOTE_C1, NOTE_B2, NOTE_A4, NOTE_E6, NOTE_C8}) {
+        for (uint32_t t = 0; t < 1000; t += 3) {
+            set_time(t);
+            const float counter   = std::fmod(t / (100 * 0.125f), VIBRATO_LUT_LENGTH);
+            const float reference = frequency * vibrato_lut[(int)counter];
+            EXPECT_NEAR(voice_add_vibrato(frequency), reference, reference * 1e-4) << frequency << " Hz at " << t << " ms";
+        }
+    }
+    EXPECT_EQ(voice_add_vibrato(0.0f), 0.0f);
+
+    set_voice(default_voice);
+}
@@ -0,0 +1,11 @@
+audio_synth_DEFS := -DAUDIO_ENABLE -DAUDIO_VOICES
+
+audio_synth_SRC := \
+	$(QUANTUM_PATH)/audio/tests/audio_synth_tests.cpp \
+	$(QUANTUM_PATH)/audio/synth.c \
+	$(QUANTUM_PATH)/audio/luts.c \
+	$(QUANTUM_PATH)/audio/voices.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+audio_synth_INC := \
+	$(QUANTUM_PATH)/audio
@@ -20,11 +20,14 @@
 #include <stdlib.h>
 #include <math.h>
 
-uint8_t note_timbre      = TIMBRE_DEFAULT;
-bool    glissando        = false;
-bool    vibrato          = false;
-float   vibrato_strength = 0.5;
-float   vibrato_rate     = 0.125;
+uint8_t note_timbre = TIMBRE_DEFAULT;
+bool    glissando   = false;
+bool    vibrato     = false;
+
+// depth of the vibrato relative to vibrato_lut, in 8.8 fixed point
+static uint16_t vibrato_strength = 0.5 * 256;
+// time spent on each step of vibrato_lut, in 1/16 ms
+static uint16_t vibrato_step = 0.125 * 100 * 16;
 
 uint16_t voices_timer = 0;
 
@@ -47,16 +50,47 @@ void voice_deiterate(void) {
 }
 
 #ifdef AUDIO_VOICES
-float mod(float a, int b) {
-    float r = fmod(a, b);
-    return r < 0 ? r + b : r;
+// scale a frequency by ratio / 32768, between 0.5 and 2, with integer math on the mantissa of the float
+static float voice_scale_frequency(float frequency, int32_t ratio) {
+    union {
+        float    f;
+        uint32_t u;
+    } bits = {.f = frequency};
+
+    // no note, or too low to be heard
+    if (!(bits.u & 0x7F800000)) {
+        return frequency;
+    }
+
+    uint32_t exponent = bits.u & 0xFF800000;
+    int32_t  mantissa = (bits.u & 0x007FFFFF) | 0x00800000;
+    // the ratio is close to 1, so only the difference is multiplied, on the top 16 bits of the mantissa
+    mantissa += ((mantissa >> 8) * (ratio - 32768)) >> 7;
+
+    if (mantissa >= 0x01000000) {
+        mantissa >>= 1;
+        exponent += 0x00800000;
+    } else if (mantissa < 0x00800000) {
+        mantissa <<= 1;
+        exponent -= 0x00800000;
+    }
+    bits.u = exponent | (mantissa & 0x007FFFFF);
+    return bits.f;
 }
 
 // Effect: 'vibrate' a given target frequency slightly above/below its initial value
 float voice_add_vibrato(float average_freq) {
-    float vibrato_counter = mod(timer_read() / (100 * vibrato_rate), VIBRATO_LUT_LENGTH);
+    uint8_t vibrato_counter = ((uint32_t)timer_read() * 16 / vibrato_step) % VIBRATO_LUT_LENGTH;
+
+    // the lut only deviates from 1 by a fraction of a percent, where pow(lut, strength) is as good as 1 + (lut - 1) * strength
+    int32_t ratio = 32768 + ((int32_t)vibrato_fixed_lut[vibrato_counter] - 32768) * vibrato_strength / 256;
+    if (ratio < 16385) {
+        ratio = 16385;
+    } else if (ratio > 65535) {
+        ratio = 65535;
+    }
 
-    return average_freq * pow(vibrato_lut[(int)vibrato_counter], vibrato_strength);
+    return voice_scale_frequency(average_freq, ratio);
 }
 
 // Effect: 'slides' the 'frequency' from the starting-point, to the target frequency
@@ -204,7 +238,8 @@ float voice_envelope(float frequency) {
                     break;
 
                 case 20 ... 200:
-                    note_timbre = 12 - (uint8_t)(pow(((float)compensated_index - 20) / (200 - 20), 2) * 12.5);
+                    // 12.5 * ((compensated_index - 20) / (200 - 20))^2
+                    note_timbre = 12 - (uint8_t)((uint32_t)(compensated_index - 20) * (compensated_index - 20) * 25 / (2 * (200 - 20) * (200 - 20)));
                     break;
 
                 default:
@@ -266,7 +301,7 @@ float voice_envelope(float frequency) {
                     break;
                 default:
                     // TODO: merge/replace with voice_add_vibrato above
-                    frequency = frequency * vibrato_lut[(int)fmod((((float)compensated_index - (VOICE_VIBRATO_DELAY + 1)) / 1000 * VOICE_VIBRATO_SPEED), VIBRATO_LUT_LENGTH)];
+                    frequency = voice_scale_frequency(frequency, vibrato_fixed_lut[(compensated_index - (VOICE_VIBRATO_DELAY + 1)) * VOICE_VIBRATO_SPEED / 1000 % VIBRATO_LUT_LENGTH]);
                     break;
             }
             break;
@@ -333,23 +368,35 @@ float voice_envelope(float frequency) {
 
 // Vibrato functions
 
+// the settings are kept in fixed point, converting them here rather than on every use
+static uint16_t voice_fixed_point(float value, float scale, uint16_t min) {
+    value *= scale;
+    if (value < min) {
+        return min;
+    }
+    if (value > UINT16_MAX) {
+        return UINT16_MAX;
+    }
+    return (uint16_t)value;
+}
+
 void voice_set_vibrato_rate(float rate) {
-    vibrato_rate = rate;
+    vibrato_step = voice_fixed_point(rate, 100 * 16, 1);
 }
 void voice_increase_vibrato_rate(float change) {
-    vibrato_rate *= change;
+    vibrato_step = voice_fixed_point(vibrato_step, change, 1);
 }
 void voice_decrease_vibrato_rate(float change) {
-    vibrato_rate /= change;
+    vibrato_step = voice_fixed_point(vibrato_step, 1 / change, 1);
 }
 void voice_set_vibrato_strength(float strength) {
-    vibrato_strength = strength;
+    vibrato_strength = voice_fixed_point(strength, 256, 0);
 }
 void voice_increase_vibrato_strength(float change) {
-    vibrato_strength *= change;
+    vibrato_strength = voice_fixed_point(vibrato_strength, change, 0);
 }
 void voice_decrease_vibrato_strength(float change) {
-    vibrato_strength /= change;
+    vibrato_strength = voice_fixed_point(vibrato_strength, 1 / change, 0);
 }
 
 // Timbre functions
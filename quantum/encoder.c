@@ -5,6 +5,16 @@
 #include "action.h"
 #include "encoder.h"
 #include "wait.h"
+#ifdef ENCODER_ACCUMULATE_STEPS
+#    include "timer.h"
+#    if defined(ENCODER_MAP_ENABLE) && defined(MOUSEKEY_ENABLE)
+#        include "action_layer.h"
+#        include "host.h"
+#        include "keycodes.h"
+#        include "keymap_common.h"
+#        include "mousekey.h"
+#    endif
+#endif // ENCODER_ACCUMULATE_STEPS
 
 #ifndef ENCODER_MAP_KEY_DELAY
 #    define ENCODER_MAP_KEY_DELAY TAP_CODE_DELAY
@@ -16,9 +26,15 @@ __attribute__((weak)) bool should_process_encoder(void) {
 
 static encoder_events_t encoder_events;
 static bool             signal_queue_drain = false;
+#ifdef ENCODER_ACCUMULATE_STEPS
+static uint16_t encoder_last_batch[NUM_ENCODERS];
+#endif // ENCODER_ACCUMULATE_STEPS
 
 void encoder_init(void) {
     memset(&encoder_events, 0, sizeof(encoder_events));
+#ifdef ENCODER_ACCUMULATE_STEPS
+    memset(encoder_last_batch, 0, sizeof(encoder_last_batch));
+#endif // ENCODER_ACCUMULATE_STEPS
     encoder_driver_init();
 }
 
@@ -27,6 +43,80 @@ static void encoder_queue_drain(void) {
     encoder_events.dequeued = encoder_events.enqueued;
 }
 
+#ifdef ENCODER_ACCUMULATE_STEPS
+
+// Detents per second, measured from the previous batch of the same encoder. An idle encoder counts as having taken ENCODER_VELOCITY_TIMEOUT.
+static uint16_t encoder_velocity(uint8_t index, uint8_t steps) {
+    uint16_t now     = timer_read();
+    uint16_t elapsed = TIMER_DIFF_16(now, encoder_last_batch[index]);
+
+    encoder_last_batch[index] = now;
+    if (elapsed == 0) {
+        elapsed = 1;
+    } else if (elapsed > ENCODER_VELOCITY_TIMEOUT) {
+        elapsed = ENCODER_VELOCITY_TIMEOUT;
+    }
+    return (uint16_t)((uint32_t)steps * 1000 / elapsed);
+}
+
+#    ifdef ENCODER_MAP_ENABLE
+#        ifdef MOUSEKEY_ENABLE
+// Turns a batch on a mouse wheel keycode into a single report with the whole delta
+static bool encoder_map_scroll(uint8_t index, bool clockwise, uint8_t steps) {
+    keypos_t       key     = (clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true)).key;
+    uint16_t       keycode = keymap_key_to_keycode(layer_switch_get_layer(key), key);
+    report_mouse_t report  = mousekey_get_report();
+
+    report.x = report.y = report.v = report.h = 0;
+    switch (keycode) {
+        case KC_MS_WH_UP:
+            report.v = steps;
+            break;
+        case KC_MS_WH_DOWN:
+            report.v = -steps;
+            break;
+        case KC_MS_WH_LEFT:
+            report.h = -steps;
+            break;
+        case KC_MS_WH_RIGHT:
+            report.h = steps;
+            break;
+        default:
+            return false;
+    }
+    host_mouse_send(&report);
+    return true;
+}
+#        endif // MOUSEKEY_ENABLE
+
+static void encoder_map_exec(uint8_t index, bool clockwise) {
+    // The delays below cater for Windows and its wonderful requirements.
+    action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
+#        if ENCODER_MAP_KEY_DELAY > 0
+    wait_ms(ENCODER_MAP_KEY_DELAY);
+#        endif // ENCODER_MAP_KEY_DELAY > 0
+
+    action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
+#        if ENCODER_MAP_KEY_DELAY > 0
+    wait_ms(ENCODER_MAP_KEY_DELAY);
+#        endif // ENCODER_MAP_KEY_DELAY > 0
+}
+#    endif // ENCODER_MAP_ENABLE
+
+static bool encoder_handle_queue(void) {
+    bool    changed = false;
+    uint8_t index;
+    bool    clockwise;
+    uint8_t steps;
+    while (encoder_dequeue_steps(&index, &clockwise, &steps)) {
+        encoder_update_steps_kb(index, clockwise, steps, encoder_velocity(index, steps));
+        changed = true;
+    }
+    return changed;
+}
+
+#else // ENCODER_ACCUMULATE_STEPS
+
 static bool encoder_handle_queue(void) {
     bool    changed = false;
     uint8_t index;
@@ -56,6 +146,8 @@ static bool encoder_handle_queue(void) {
     return changed;
 }
 
+#endif // ENCODER_ACCUMULATE_STEPS
+
 bool encoder_task(void) {
     bool changed = false;
 
@@ -83,7 +175,7 @@ bool encoder_task(void) {
 }
 
 bool encoder_queue_full_advanced(encoder_events_t *events) {
-    return events->head == (events->tail - 1) % MAX_QUEUED_ENCODER_EVENTS;
+    return (events->head + 1) % MAX_QUEUED_ENCODER_EVENTS == events->tail;
 }
 
 bool encoder_queue_full(void) {
@@ -99,13 +191,30 @@ bool encoder_queue_empty(void) {
 }
 
 bool encoder_queue_event_advanced(encoder_events_t *events, uint8_t index, bool clockwise) {
+#ifdef ENCODER_ACCUMULATE_STEPS
+    // Fold into the newest event if it is for the same encoder and direction, up to what a mouse report can carry.
+    // The oldest event is left alone, as it may be being dequeued.
+    uint8_t last = (events->head + MAX_QUEUED_ENCODER_EVENTS - 1) % MAX_QUEUED_ENCODER_EVENTS;
+    if (!encoder_queue_empty_advanced(events) && last != events->tail) {
+        encoder_event_t *event = &events->queue[last];
+        if (event->index == index && event->clockwise == (clockwise ? 1 : 0) && event->steps < INT8_MAX) {
+            event->steps++;
+            return true;
+        }
+    }
+#endif // ENCODER_ACCUMULATE_STEPS
+
     // Drop out if we're full
     if (encoder_queue_full_advanced(events)) {
         return false;
     }
 
     // Append the event
-    encoder_event_t new_event   = {.index = index, .clockwise = clockwise ? 1 : 0};
+#ifdef ENCODER_ACCUMULATE_STEPS
+    encoder_event_t new_event = {.index = index, .clockwise = clockwise ? 1 : 0, .steps = 1};
+#else
+    encoder_event_t new_event = {.index = index, .clockwise = clockwise ? 1 : 0};
+#endif // ENCODER_ACCUMULATE_STEPS
     events->queue[events->head] = new_event;
 
     // Increment the head index
@@ -120,17 +229,56 @@ bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bo
         return false;
     }
 
+    // Retrieve the event
+    encoder_event_t *event = &events->queue[events->tail];
+    *index                 = event->index;
+    *clockwise             = event->clockwise;
+
+#ifdef ENCODER_ACCUMULATE_STEPS
+    // Hand out one detent at a time, keeping the rest at the front of the queue
+    if (--event->steps > 0) {
+        return true;
+    }
+#endif // ENCODER_ACCUMULATE_STEPS
+
+    // Increment the tail index
+    events->tail = (events->tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+    events->dequeued++;
+
+    return true;
+}
+
+#ifdef ENCODER_ACCUMULATE_STEPS
+bool encoder_dequeue_steps_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise, uint8_t *steps) {
+    if (encoder_queue_empty_advanced(events)) {
+        return false;
+    }
+
     // Retrieve the event
     encoder_event_t event = events->queue[events->tail];
     *index                = event.index;
     *clockwise            = event.clockwise;
+    *steps                = event.steps;
 
     // Increment the tail index
     events->tail = (events->tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
     events->dequeued++;
 
+    // Join back the events that were only split to keep the oldest one untouched by the queueing side.
+    // Each becomes the oldest before it is read, so it cannot grow while being read.
+    while (!encoder_queue_empty_advanced(events)) {
+        event = events->queue[events->tail];
+        if (event.index != *index || event.clockwise != *clockwise || *steps + event.steps > INT8_MAX) {
+            break;
+        }
+        *steps += event.steps;
+        events->tail = (events->tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events->dequeued++;
+    }
+
     return true;
 }
+#endif // ENCODER_ACCUMULATE_STEPS
 
 bool encoder_queue_event(uint8_t index, bool clockwise) {
     return encoder_queue_event_advanced(&encoder_events, index, clockwise);
@@ -140,6 +288,12 @@ bool encoder_dequeue_event(uint8_t *index, bool *clockwise) {
     return encoder_dequeue_event_advanced(&encoder_events, index, clockwise);
 }
 
+#ifdef ENCODER_ACCUMULATE_STEPS
+bool encoder_dequeue_steps(uint8_t *index, bool *clockwise, uint8_t *steps) {
+    return encoder_dequeue_steps_advanced(&encoder_events, index, clockwise, steps);
+}
+#endif // ENCODER_ACCUMULATE_STEPS
+
 void encoder_retrieve_events(encoder_events_t *events) {
     memcpy(events, &encoder_events, sizeof(encoder_events));
 }
@@ -177,3 +331,30 @@ __attribute__((weak)) bool encoder_update_kb(uint8_t index, bool clockwise) {
 #endif // ENCODER_TESTS
     return res;
 }
+
+#ifdef ENCODER_ACCUMULATE_STEPS
+__attribute__((weak)) bool encoder_update_steps_user(uint8_t index, bool clockwise, uint8_t steps, uint16_t velocity) {
+    return true;
+}
+
+__attribute__((weak)) bool encoder_update_steps_kb(uint8_t index, bool clockwise, uint8_t steps, uint16_t velocity) {
+    bool res = encoder_update_steps_user(index, clockwise, steps, velocity);
+    if (res) {
+#    ifdef ENCODER_MAP_ENABLE
+#        ifdef MOUSEKEY_ENABLE
+        if (encoder_map_scroll(index, clockwise, steps)) {
+            return res;
+        }
+#        endif // MOUSEKEY_ENABLE
+        for (uint8_t i = 0; i < steps; i++) {
+            encoder_map_exec(index, clockwise);
+        }
+#    else  // ENCODER_MAP_ENABLE
+        for (uint8_t i = 0; i < steps; i++) {
+            encoder_update_kb(index, clockwise);
+        }
+#    endif // ENCODER_MAP_ENABLE
+    }
+    return res;
+}
+#endif // ENCODER_ACCUMULATE_STEPS
@@ -34,6 +34,18 @@ bool encoder_dequeue_event(uint8_t *index, bool *clockwise);
 bool encoder_update_kb(uint8_t index, bool clockwise);
 bool encoder_update_user(uint8_t index, bool clockwise);
 
+#    ifdef ENCODER_ACCUMULATE_STEPS
+#        ifndef ENCODER_VELOCITY_TIMEOUT
+#            define ENCODER_VELOCITY_TIMEOUT 200
+#        endif // ENCODER_VELOCITY_TIMEOUT
+
+bool encoder_dequeue_steps(uint8_t *index, bool *clockwise, uint8_t *steps);
+
+// Same-direction detents of one encoder, merged; velocity is in detents per second
+bool encoder_update_steps_kb(uint8_t index, bool clockwise, uint8_t steps, uint16_t velocity);
+bool encoder_update_steps_user(uint8_t index, bool clockwise, uint8_t steps, uint16_t velocity);
+#    endif // ENCODER_ACCUMULATE_STEPS
+
 #    ifdef SPLIT_KEYBOARD
 
 #        if defined(ENCODERS_PAD_A_RIGHT)
@@ -80,6 +92,9 @@ bool encoder_update_user(uint8_t index, bool clockwise);
 typedef struct encoder_event_t {
     uint8_t index : 7;
     uint8_t clockwise : 1;
+#    ifdef ENCODER_ACCUMULATE_STEPS
+    uint8_t steps;
+#    endif // ENCODER_ACCUMULATE_STEPS
 } encoder_event_t;
 
 typedef struct encoder_events_t {
@@ -96,6 +111,9 @@ void encoder_retrieve_events(encoder_events_t *events);
 // Encoder event queue management
 bool encoder_queue_event_advanced(encoder_events_t *events, uint8_t index, bool clockwise);
 bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise);
+#    ifdef ENCODER_ACCUMULATE_STEPS
+bool encoder_dequeue_steps_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise, uint8_t *steps);
+#    endif // ENCODER_ACCUMULATE_STEPS
 
 // Reset the queue to be empty
 void encoder_signal_queue_drain(void);
@@ -0,0 +1,174 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+struct detent {
+    uint8_t index;
+    bool    clockwise;
+
+    bool operator==(const detent &other) const {
+        return index == other.index && clockwise == other.clockwise;
+    }
+};
+
+struct batch {
+    uint8_t  index;
+    bool     clockwise;
+    uint8_t  steps;
+    uint16_t velocity;
+};
+
+std::vector<batch>  batches;
+std::vector<detent> updates;
+
+bool encoder_update_steps_user(uint8_t index, bool clockwise, uint8_t steps, uint16_t velocity) {
+    batches.push_back({index, clockwise, steps, velocity});
+    return true;
+}
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    updates.push_back({index, clockwise});
+    return true;
+}
+
+class EncoderAccumulateTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        batches.clear();
+        updates.clear();
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderAccumulateTest, MergesSameDirection) {
+    for (int i = 0; i < 5; i++) {
+        EXPECT_TRUE(encoder_queue_event(0, true));
+    }
+    EXPECT_TRUE(encoder_task());
+
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches[0].index, 0);
+    EXPECT_EQ(batches[0].clockwise, true);
+    EXPECT_EQ(batches[0].steps, 5);
+
+    // Without a keymap level handler, every detent still reaches encoder_update_kb()
+    EXPECT_EQ(updates, std::vector<detent>(5, {0, true}));
+
+    batches.clear();
+    EXPECT_FALSE(encoder_task());
+    EXPECT_TRUE(batches.empty());
+}
+
+TEST_F(EncoderAccumulateTest, NoLossWhenFull) {
+    // Alternating directions cannot be merged, so this fills the queue
+    EXPECT_TRUE(encoder_queue_event(0, true));
+    EXPECT_TRUE(encoder_queue_event(0, false));
+    EXPECT_TRUE(encoder_queue_event(1, true));
+    EXPECT_FALSE(encoder_queue_event(1, false));
+
+    // Same direction as the newest event still fits
+    EXPECT_TRUE(encoder_queue_event(1, true));
+
+    encoder_task();
+    EXPECT_EQ(updates, (std::vector<detent>{{0, true}, {0, false}, {1, true}, {1, true}}));
+}
+
+TEST_F(EncoderAccumulateTest, FastSpinIsNotDropped) {
+    // Far more detents than the queue has slots
+    for (int i = 0; i < 200; i++) {
+        EXPECT_TRUE(encoder_queue_event(1, false));
+    }
+    encoder_task();
+
+    unsigned steps = 0;
+    for (auto &b : batches) {
+        EXPECT_EQ(b.index, 1);
+        EXPECT_EQ(b.clockwise, false);
+        EXPECT_LE(b.steps, INT8_MAX);
+        steps += b.steps;
+    }
+    EXPECT_EQ(steps, 200);
+    EXPECT_LE(batches.size(), 3);
+    EXPECT_EQ(updates.size(), 200);
+}
+
+TEST_F(EncoderAccumulateTest, KeepsOrder) {
+    std::mt19937        rng(1234);
+    std::vector<detent> sent;
+
+    for (int i = 0; i < 2000; i++) {
+        // Runs of random length, as a hand spinning two knobs would produce
+        detent d = {(uint8_t)(rng() % 2), (rng() % 2) == 0};
+        for (unsigned n = rng() % 12 + 1; n > 0; n--) {
+            if (!encoder_queue_event(d.index, d.clockwise)) {
+                encoder_task();
+                ASSERT_TRUE(encoder_queue_event(d.index, d.clockwise));
+            }
+            sent.push_back(d);
+        }
+        if (rng() % 4 == 0) {
+            encoder_task();
+        }
+    }
+    encoder_task();
+
+    std::vector<detent> received;
+    for (auto &b : batches) {
+        EXPECT_GT(b.steps, 0);
+        received.insert(received.end(), b.steps, {b.index, b.clockwise});
+    }
+    EXPECT_EQ(received, sent);
+    EXPECT_EQ(updates, sent);
+    EXPECT_LT(batches.size(), sent.size() / 2);
+}
+
+TEST_F(EncoderAccumulateTest, Velocity) {
+    set_time(1000);
+    for (int i = 0; i < 4; i++) {
+        encoder_queue_event(0, true);
+    }
+    encoder_queue_event(1, true);
+    encoder_task();
+
+    // The first batch after being idle is measured over ENCODER_VELOCITY_TIMEOUT
+    ASSERT_EQ(batches.size(), 2);
+    EXPECT_EQ(batches[0].velocity, 4 * 1000 / ENCODER_VELOCITY_TIMEOUT);
+    EXPECT_EQ(batches[1].velocity, 1 * 1000 / ENCODER_VELOCITY_TIMEOUT);
+    batches.clear();
+
+    advance_time(50);
+    for (int i = 0; i < 6; i++) {
+        encoder_queue_event(0, true);
+    }
+    encoder_task();
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches[0].velocity, 6 * 1000 / 50);
+}
+
+TEST_F(EncoderAccumulateTest, DequeuesSingleDetents) {
+    for (int i = 0; i < 3; i++) {
+        encoder_queue_event(0, true);
+    }
+    encoder_queue_event(1, false);
+
+    uint8_t             index;
+    bool                clockwise;
+    std::vector<detent> received;
+    while (encoder_dequeue_event(&index, &clockwise)) {
+        received.push_back({index, clockwise});
+    }
+    EXPECT_EQ(received, (std::vector<detent>{{0, true}, {0, true}, {0, true}, {1, false}}));
+}
@@ -21,6 +21,7 @@
 #include "usb_device_state.h"
 #include "gpio.h"
 #include "keyboard.h"
+#include "timer.h"
 
 #ifdef HAPTIC_DRV2605L
 #    include "drv2605l.h"
@@ -35,6 +36,27 @@ extern uint8_t split_haptic_play;
 
 haptic_config_t haptic_config;
 
+#ifdef HAPTIC_DRV2605L
+// Effects waiting to be played, so that key processing never waits on the I2C bus
+static uint8_t  haptic_queue[HAPTIC_QUEUE_SIZE];
+static uint8_t  haptic_queue_head  = 0;
+static uint8_t  haptic_queue_count = 0;
+static uint16_t haptic_pulse_timer;
+
+static void haptic_queue_push(uint8_t effect) {
+    if (haptic_queue_count > 0) {
+        uint8_t *newest = &haptic_queue[(haptic_queue_head + haptic_queue_count - 1) % HAPTIC_QUEUE_SIZE];
+        // Requests arriving faster than the motor plays them are merged, and a full queue keeps the latest one
+        if (*newest == effect || haptic_queue_count == HAPTIC_QUEUE_SIZE) {
+            *newest = effect;
+            return;
+        }
+    }
+    haptic_queue[(haptic_queue_head + haptic_queue_count) % HAPTIC_QUEUE_SIZE] = effect;
+    haptic_queue_count++;
+}
+#endif
+
 static void update_haptic_enable_gpios(void) {
     if (haptic_config.enable && ((!HAPTIC_OFF_IN_LOW_POWER) || (usb_device_state == USB_DEVICE_STATE_CONFIGURED))) {
 #if defined(HAPTIC_ENABLE_PIN)
@@ -104,6 +126,18 @@ void haptic_init(void) {
 }
 
 void haptic_task(void) {
+#ifdef HAPTIC_DRV2605L
+#    if defined(SPLIT_KEYBOARD) && !defined(SPLIT_HAPTIC_ENABLE)
+    if (!is_keyboard_master()) return;
+#    endif
+    // The register writes go out from i2c_async_task(): finish the previous pulse before starting the next, and give each pulse time to play
+    if (haptic_queue_count > 0 && !drv2605l_pulse_busy() && timer_elapsed(haptic_pulse_timer) >= HAPTIC_PULSE_INTERVAL) {
+        drv2605l_pulse_async(haptic_queue[haptic_queue_head]);
+        haptic_queue_head = (haptic_queue_head + 1) % HAPTIC_QUEUE_SIZE;
+        haptic_queue_count--;
+        haptic_pulse_timer = timer_read();
+    }
+#endif // HAPTIC_DRV2605L
 #ifdef HAPTIC_SOLENOID
 // Only run task on seconary boards if the user desires
 #    if defined(SPLIT_KEYBOARD) && !defined(SPLIT_HAPTIC_ENABLE)
@@ -332,9 +366,7 @@ void haptic_cont_decrease(void) {
 
 void haptic_play(void) {
 #ifdef HAPTIC_DRV2605L
-    uint8_t play_eff = 0;
-    play_eff         = haptic_config.mode;
-    drv2605l_pulse(play_eff);
+    haptic_queue_push(haptic_config.mode);
 #    if defined(SPLIT_KEYBOARD) && defined(SPLIT_HAPTIC_ENABLE)
     split_haptic_play = haptic_config.mode;
 #    endif
@@ -26,6 +26,12 @@
 #ifndef HAPTIC_DEFAULT_MODE
 #    define HAPTIC_DEFAULT_MODE DRV2605L_DEFAULT_MODE
 #endif
+#ifndef HAPTIC_QUEUE_SIZE
+#    define HAPTIC_QUEUE_SIZE 4
+#endif
+#ifndef HAPTIC_PULSE_INTERVAL
+#    define HAPTIC_PULSE_INTERVAL 20
+#endif
 
 /* EEPROM config settings */
 typedef union {
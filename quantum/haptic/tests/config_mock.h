@@ -0,0 +1,8 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define DRV2605L_DEFAULT_MODE 1
+#define HAPTIC_QUEUE_SIZE 4
+#define HAPTIC_PULSE_INTERVAL 20
@@ -0,0 +1,174 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <ostream>
+#include <vector>
+
+extern "C" {
+#include "drv2605l.h"
+#include "i2c_async.h"
+
+// haptic.h itself can't be included from C++
+void haptic_init(void);
+void haptic_task(void);
+void haptic_play(void);
+void haptic_set_mode(uint8_t mode);
+
+void advance_time(uint32_t ms);
+}
+
+struct reg_write {
+    uint8_t reg;
+    uint8_t value;
+
+    bool operator==(const reg_write &other) const {
+        return reg == other.reg && value == other.value;
+    }
+};
+
+static std::ostream &operator<<(std::ostream &os, const reg_write &w) {
+    return os << "{" << (int)w.reg << "," << (int)w.value << "}";
+}
+
+// Address, register and value of a single register write
+#define WRITE_NS (3 * I2C_SIM_BYTE_NS)
+
+// Register writes the DRV2605L has seen
+static std::vector<reg_write> writes() {
+    std::vector<reg_write> result;
+    for (uint16_t i = 0; i < i2c_sim_transfer_count(); i++) {
+        const i2c_sim_transfer_t *t = i2c_sim_transfer(i);
+        if (t->address == DRV2605L_I2C_ADDRESS << 1 && !t->read) {
+            result.push_back({t->reg, t->data[0]});
+        }
+    }
+    return result;
+}
+
+static std::vector<reg_write> pulse(uint8_t effect) {
+    return {{DRV2605L_REG_GO, 0x00}, {DRV2605L_REG_WAVEFORM_SEQUENCER_1, effect}, {DRV2605L_REG_GO, 0x01}};
+}
+
+class Haptic : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        advance_time(1000);
+        haptic_init();
+        haptic_set_mode(1);
+        // Let the queue settle from any earlier test
+        for (int i = 0; i < 20; i++) {
+            advance_time(HAPTIC_PULSE_INTERVAL);
+            keyboard_task();
+        }
+        i2c_sim_reset();
+        i2c_sim_attach(DRV2605L_I2C_ADDRESS << 1);
+    }
+
+    // The parts of keyboard_task() that touch the haptic driver
+    void keyboard_task() {
+        haptic_task();
+        i2c_async_task();
+    }
+
+    // Runs the task until the bus goes quiet, returning the most bus time any single pass took
+    uint32_t drain() {
+        uint32_t worst = 0;
+        for (int i = 0; i < 10; i++) {
+            uint32_t before = i2c_sim_busy_ns();
+            keyboard_task();
+            worst = std::max(worst, i2c_sim_busy_ns() - before);
+        }
+        return worst;
+    }
+};
+
+TEST_F(Haptic, PlayDoesNotTouchTheBus) {
+    haptic_play();
+    EXPECT_TRUE(writes().empty());
+    EXPECT_EQ(i2c_sim_busy_ns(), 0);
+
+    EXPECT_EQ(drain(), WRITE_NS);
+    EXPECT_EQ(writes(), pulse(1));
+}
+
+TEST_F(Haptic, CoalescesBursts) {
+    for (int i = 0; i < 5; i++) {
+        haptic_play();
+    }
+    drain();
+    EXPECT_EQ(writes(), pulse(1));
+}
+
+TEST_F(Haptic, KeepsDistinctEffectsInOrder) {
+    haptic_play();
+    haptic_set_mode(7);
+    haptic_play();
+    haptic_play();
+    haptic_set_mode(1);
+    haptic_play();
+
+    std::vector<reg_write> expected;
+    for (uint8_t effect : {1, 7, 1}) {
+        auto p = pulse(effect);
+        expected.insert(expected.end(), p.begin(), p.end());
+    }
+    for (int i = 0; i < 3; i++) {
+        drain();
+        advance_time(HAPTIC_PULSE_INTERVAL);
+    }
+    EXPECT_EQ(writes(), expected);
+}
+
+TEST_F(Haptic, WaitsForPulseInterval) {
+    haptic_play();
+    drain();
+    i2c_sim_reset();
+    i2c_sim_attach(DRV2605L_I2C_ADDRESS << 1);
+
+    advance_time(HAPTIC_PULSE_INTERVAL / 2);
+    haptic_set_mode(3);
+    haptic_play();
+    drain();
+    EXPECT_TRUE(writes().empty());
+
+    advance_time(HAPTIC_PULSE_INTERVAL / 2);
+    drain();
+    EXPECT_EQ(writes(), pulse(3));
+}
+
+TEST_F(Haptic, FullQueueKeepsLatest) {
+    for (uint8_t effect = 1; effect <= HAPTIC_QUEUE_SIZE + 3; effect++) {
+        haptic_set_mode(effect);
+        haptic_play();
+    }
+
+    std::vector<reg_write> expected;
+    for (uint8_t effect = 1; effect < HAPTIC_QUEUE_SIZE; effect++) {
+        auto p = pulse(effect);
+        expected.insert(expected.end(), p.begin(), p.end());
+    }
+    auto p = pulse(HAPTIC_QUEUE_SIZE + 3);
+    expected.insert(expected.end(), p.begin(), p.end());
+
+    for (int i = 0; i < HAPTIC_QUEUE_SIZE; i++) {
+        drain();
+        advance_time(HAPTIC_PULSE_INTERVAL);
+    }
+    EXPECT_EQ(writes(), expected);
+}
+
+TEST_F(Haptic, KeyPathLatency) {
+    uint32_t before = i2c_sim_busy_ns();
+    drv2605l_pulse(1);
+    uint32_t blocking = i2c_sim_busy_ns() - before;
+
+    before = i2c_sim_busy_ns();
+    haptic_play();
+    uint32_t queued = i2c_sim_busy_ns() - before;
+    uint32_t worst  = drain();
+
+    EXPECT_EQ(blocking, 3 * WRITE_NS);
+    EXPECT_EQ(queued, 0);
+    EXPECT_EQ(worst, WRITE_NS);
+}
@@ -0,0 +1,29 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdbool.h>
+#include "i2c_master.h"
+#include "eeconfig.h"
+#include "usb_device_state.h"
+
+enum usb_device_state usb_device_state = USB_DEVICE_STATE_CONFIGURED;
+
+static uint32_t haptic_eeprom;
+
+bool eeconfig_is_enabled(void) {
+    return true;
+}
+
+void eeconfig_init(void) {}
+
+uint32_t eeconfig_read_haptic(void) {
+    return haptic_eeprom;
+}
+
+void eeconfig_update_haptic(uint32_t val) {
+    haptic_eeprom = val;
+}
+
+bool is_keyboard_master(void) {
+    return true;
+}
@@ -0,0 +1,12 @@
+haptic_DEFS := -DHAPTIC_ENABLE -DHAPTIC_DRV2605L -DEEPROM_TEST_HARNESS
+haptic_INC := $(QUANTUM_PATH)/haptic/tests drivers/haptic $(PLATFORM_PATH)/test/i2c_bus_sim
+haptic_CONFIG := $(QUANTUM_PATH)/haptic/tests/config_mock.h
+
+haptic_SRC := \
+	platforms/test/timer.c \
+	$(PLATFORM_PATH)/test/i2c_bus_sim/i2c_master.c \
+	$(PLATFORM_PATH)/i2c_async.c \
+	drivers/haptic/drv2605l.c \
+	$(QUANTUM_PATH)/haptic.c \
+	$(QUANTUM_PATH)/haptic/tests/mock.c \
+	$(QUANTUM_PATH)/haptic/tests/haptic_tests.cpp
@@ -59,12 +59,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef RGB_MATRIX_ENABLE
 #    include "rgb_matrix.h"
 #endif
+#ifdef LIGHTING_SHARED_WS2812
+#    include "lighting.h"
+#endif
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif
 #ifdef HAPTIC_ENABLE
 #    include "haptic.h"
 #endif
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#endif
 #ifdef AUTO_SHIFT_ENABLE
 #    include "process_auto_shift.h"
 #endif
@@ -371,6 +377,9 @@ __attribute__((weak)) void housekeeping_task_user(void) {}
  * Invokes hooks for executing code after QMK is done after each loop iteration.
  */
 void housekeeping_task(void) {
+#ifdef EEPROM_DRIVER
+    eeprom_driver_task();
+#endif
     housekeeping_task_kb();
     housekeeping_task_user();
 }
@@ -681,6 +690,9 @@ void keyboard_task(void) {
 #ifdef RGB_MATRIX_ENABLE
     rgb_matrix_task();
 #endif
+#ifdef LIGHTING_SHARED_WS2812
+    lighting_task();
+#endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
@@ -743,6 +755,10 @@ void keyboard_task(void) {
     haptic_task();
 #endif
 
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_task();
+#endif
+
     led_task();
 
 #ifdef OS_DETECTION_ENABLE
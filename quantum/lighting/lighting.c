@@ -0,0 +1,68 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "lighting.h"
+#include "ws2812.h"
+#include "timer.h"
+
+static struct {
+    const rgb_led_t *leds;
+    uint16_t         count;
+} lighting_layers[LIGHTING_LAYER_COUNT];
+
+static rgb_led_t lighting_frame[WS2812_LED_COUNT];
+static bool      lighting_dirty = false;
+static uint16_t  lighting_frame_timer;
+
+void lighting_layer_update(lighting_layer_t layer, const rgb_led_t *leds, uint16_t count) {
+    lighting_layers[layer].leds  = leds;
+    lighting_layers[layer].count = count;
+    lighting_dirty               = true;
+}
+
+static inline bool lighting_is_lit(const rgb_led_t *led) {
+#ifdef RGBW
+    return led->r || led->g || led->b || led->w;
+#else
+    return led->r || led->g || led->b;
+#endif
+}
+
+void lighting_composite(rgb_led_t *frame, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        frame[i] = (rgb_led_t){0};
+        for (int8_t layer = LIGHTING_LAYER_COUNT - 1; layer >= 0; layer--) {
+            if (i < lighting_layers[layer].count && lighting_is_lit(&lighting_layers[layer].leds[i])) {
+                frame[i] = lighting_layers[layer].leds[i];
+                break;
+            }
+        }
+    }
+}
+
+void lighting_flush(void) {
+    if (!lighting_dirty) {
+        return;
+    }
+
+    uint16_t count = 0;
+    for (uint8_t layer = 0; layer < LIGHTING_LAYER_COUNT; layer++) {
+        if (lighting_layers[layer].count > count) {
+            count = lighting_layers[layer].count;
+        }
+    }
+    if (count > WS2812_LED_COUNT) {
+        count = WS2812_LED_COUNT;
+    }
+
+    lighting_composite(lighting_frame, count);
+    ws2812_setleds(lighting_frame, count);
+    lighting_dirty       = false;
+    lighting_frame_timer = timer_read();
+}
+
+void lighting_task(void) {
+    if (lighting_dirty && timer_elapsed(lighting_frame_timer) >= LIGHTING_FRAME_INTERVAL) {
+        lighting_flush();
+    }
+}
@@ -0,0 +1,50 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "color.h"
+
+/**
+ * \file
+ *
+ * Compositor for lighting subsystems that drive the same WS2812 chain.
+ *
+ * Each subsystem hands over its own pixels as a layer instead of writing to the chain itself. Once per
+ * frame, the layers are combined into a single buffer and sent with one ws2812_setleds() call. Layers
+ * are stacked in the order below, and an unlit pixel lets the layers beneath it show through.
+ */
+
+#ifndef LIGHTING_FRAME_INTERVAL
+#    define LIGHTING_FRAME_INTERVAL 16
+#endif
+
+typedef enum {
+    LIGHTING_LAYER_RGBLIGHT,
+    LIGHTING_LAYER_RGB_MATRIX,
+    LIGHTING_LAYER_COUNT,
+} lighting_layer_t;
+
+/**
+ * \brief Replaces the pixels of a layer, starting from the first LED of the chain.
+ *
+ * The pixels are read when the frame is sent, so they must stay valid until the layer is next updated.
+ */
+void lighting_layer_update(lighting_layer_t layer, const rgb_led_t *leds, uint16_t count);
+
+/**
+ * \brief Combines the layers into one frame of `count` pixels.
+ */
+void lighting_composite(rgb_led_t *frame, uint16_t count);
+
+/**
+ * \brief Sends a frame if any layer changed since the last one, at most once per LIGHTING_FRAME_INTERVAL.
+ */
+void lighting_task(void);
+
+/**
+ * \brief Sends a frame right away if any layer changed since the last one.
+ */
+void lighting_flush(void);
@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define RGBLIGHT_WS2812
+#define RGB_MATRIX_WS2812
+
+#define RGBLIGHT_LED_COUNT 4
+#define RGB_MATRIX_LED_COUNT 6
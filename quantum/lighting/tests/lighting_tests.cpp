@@ -0,0 +1,160 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <vector>
+
+extern "C" {
+#include "lighting.h"
+#include "rgb_matrix_drivers.h"
+#include "ws2812.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+typedef std::vector<rgb_led_t> frame_t;
+
+static std::vector<frame_t> frames;
+
+extern "C" void ws2812_setleds(rgb_led_t *ledarray, uint16_t number_of_leds) {
+    frames.push_back(frame_t(ledarray, ledarray + number_of_leds));
+}
+
+static bool operator==(const rgb_led_t &a, const rgb_led_t &b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+static std::ostream &operator<<(std::ostream &os, const rgb_led_t &led) {
+    return os << "{" << (int)led.r << "," << (int)led.g << "," << (int)led.b << "}";
+}
+
+static rgb_led_t color(uint8_t r, uint8_t g, uint8_t b) {
+    rgb_led_t led = {};
+    led.r         = r;
+    led.g         = g;
+    led.b         = b;
+    return led;
+}
+
+static const rgb_led_t OFF   = color(0, 0, 0);
+static const rgb_led_t RED   = color(255, 0, 0);
+static const rgb_led_t GREEN = color(0, 255, 0);
+static const rgb_led_t BLUE  = color(0, 0, 255);
+
+class Lighting : public ::testing::Test {
+   protected:
+    rgb_led_t underglow[RGBLIGHT_LED_COUNT];
+    rgb_led_t matrix[RGB_MATRIX_LED_COUNT];
+
+    void SetUp() override {
+        set_time(1000);
+        for (auto &led : underglow) led = OFF;
+        for (auto &led : matrix) led = OFF;
+        lighting_layer_update(LIGHTING_LAYER_RGBLIGHT, underglow, RGBLIGHT_LED_COUNT);
+        lighting_layer_update(LIGHTING_LAYER_RGB_MATRIX, matrix, RGB_MATRIX_LED_COUNT);
+        lighting_flush();
+        frames.clear();
+    }
+};
+
+TEST_F(Lighting, MatrixOverUnderglow) {
+    for (auto &led : underglow) led = BLUE;
+    matrix[1] = RED;
+    matrix[3] = GREEN;
+    matrix[5] = RED;
+
+    frame_t frame(RGB_MATRIX_LED_COUNT);
+    lighting_composite(frame.data(), frame.size());
+    EXPECT_EQ(frame, (frame_t{BLUE, RED, BLUE, GREEN, OFF, RED}));
+}
+
+TEST_F(Lighting, UnderglowShowsWhenMatrixIsOff) {
+    underglow[0] = GREEN;
+    underglow[2] = RED;
+
+    frame_t frame(RGB_MATRIX_LED_COUNT);
+    lighting_composite(frame.data(), frame.size());
+    EXPECT_EQ(frame, (frame_t{GREEN, OFF, RED, OFF, OFF, OFF}));
+}
+
+TEST_F(Lighting, ShorterLayer) {
+    // The underglow half of a split only covers part of the chain
+    for (auto &led : underglow) led = BLUE;
+    lighting_layer_update(LIGHTING_LAYER_RGBLIGHT, underglow, 2);
+    lighting_layer_update(LIGHTING_LAYER_RGB_MATRIX, matrix, 3);
+    advance_time(LIGHTING_FRAME_INTERVAL);
+    lighting_task();
+
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames[0], (frame_t{BLUE, BLUE, OFF}));
+}
+
+TEST_F(Lighting, OneWritePerFrame) {
+    for (int frame = 0; frame < 10; frame++) {
+        advance_time(LIGHTING_FRAME_INTERVAL);
+        underglow[frame % RGBLIGHT_LED_COUNT] = BLUE;
+        lighting_layer_update(LIGHTING_LAYER_RGBLIGHT, underglow, RGBLIGHT_LED_COUNT);
+        matrix[frame % RGB_MATRIX_LED_COUNT] = RED;
+        lighting_layer_update(LIGHTING_LAYER_RGB_MATRIX, matrix, RGB_MATRIX_LED_COUNT);
+        lighting_task();
+        lighting_task();
+    }
+    EXPECT_EQ(frames.size(), 10);
+    for (auto &frame : frames) {
+        EXPECT_EQ(frame.size(), RGB_MATRIX_LED_COUNT);
+    }
+}
+
+TEST_F(Lighting, FrameInterval) {
+    lighting_layer_update(LIGHTING_LAYER_RGBLIGHT, underglow, RGBLIGHT_LED_COUNT);
+    lighting_task();
+    EXPECT_TRUE(frames.empty());
+
+    // Changes made before the frame is due all go out together
+    advance_time(LIGHTING_FRAME_INTERVAL - 1);
+    matrix[0] = GREEN;
+    lighting_layer_update(LIGHTING_LAYER_RGB_MATRIX, matrix, RGB_MATRIX_LED_COUNT);
+    lighting_task();
+    EXPECT_TRUE(frames.empty());
+
+    advance_time(1);
+    lighting_task();
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames[0][0], GREEN);
+}
+
+TEST_F(Lighting, NothingToSend) {
+    advance_time(LIGHTING_FRAME_INTERVAL * 10);
+    lighting_task();
+    lighting_flush();
+    EXPECT_TRUE(frames.empty());
+}
+
+TEST_F(Lighting, FlushIgnoresInterval) {
+    // Used when suspending, where the keyboard task no longer runs
+    underglow[0] = RED;
+    lighting_layer_update(LIGHTING_LAYER_RGBLIGHT, underglow, RGBLIGHT_LED_COUNT);
+    lighting_flush();
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames[0][0], RED);
+}
+
+TEST_F(Lighting, MatrixFrameIsCopiedOnFlush) {
+    rgb_matrix_driver.init();
+    rgb_matrix_driver.set_color_all(0, 0, 255);
+    rgb_matrix_driver.flush();
+
+    // The next frame is only half rendered when the compositor runs
+    rgb_matrix_driver.set_color(0, 255, 0, 0);
+    rgb_matrix_driver.set_color(1, 255, 0, 0);
+    advance_time(LIGHTING_FRAME_INTERVAL);
+    lighting_task();
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames[0], frame_t(RGB_MATRIX_LED_COUNT, BLUE));
+
+    rgb_matrix_driver.flush();
+    lighting_flush();
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames[1], (frame_t{RED, RED, BLUE, BLUE, BLUE, BLUE}));
+}
@@ -0,0 +1,9 @@
+lighting_DEFS := -DLIGHTING_SHARED_WS2812
+lighting_INC := $(QUANTUM_PATH)/lighting $(QUANTUM_PATH)/rgb_matrix drivers
+lighting_CONFIG := $(QUANTUM_PATH)/lighting/tests/config_mock.h
+
+lighting_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/lighting/lighting.c \
+	$(QUANTUM_PATH)/rgb_matrix/rgb_matrix_drivers.c \
+	$(QUANTUM_PATH)/lighting/tests/lighting_tests.cpp
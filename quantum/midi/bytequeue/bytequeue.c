@@ -1,4 +1,4 @@
-// this is a single reader [maybe multiple writer?] byte queue
+// this is a single reader, single writer byte queue
 // Copyright 2008 Alex Norman
 // writen by Alex Norman
 //
@@ -18,7 +18,13 @@
 // along with avr-bytequeue.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "bytequeue.h"
-#include "interrupt_setting.h"
+#include <string.h>
+
+// The indices are bytes, so reading or writing one is atomic. Acquire and
+// release ordering makes sure the data is written before the writer publishes
+// the new end, and read before the reader hands the space back with start.
+#define BYTEQUEUE_LOAD(index) __atomic_load_n(&(index), __ATOMIC_ACQUIRE)
+#define BYTEQUEUE_STORE(index, value) __atomic_store_n(&(index), (value), __ATOMIC_RELEASE)
 
 void bytequeue_init(byteQueue_t* queue, uint8_t* dataArray, byteQueueIndex_t arrayLen) {
     queue->length = arrayLen;
@@ -27,38 +33,66 @@ void bytequeue_init(byteQueue_t* queue, uint8_t* dataArray, byteQueueIndex_t arr
 }
 
 bool bytequeue_enqueue(byteQueue_t* queue, uint8_t item) {
-    interrupt_setting_t setting = store_and_clear_interrupt();
-    // full
-    if (((queue->end + 1) % queue->length) == queue->start) {
-        restore_interrupt_setting(setting);
+    return bytequeue_enqueue_bulk(queue, &item, 1);
+}
+
+bool bytequeue_enqueue_bulk(byteQueue_t* queue, const uint8_t* items, byteQueueIndex_t count) {
+    const byteQueueIndex_t start = BYTEQUEUE_LOAD(queue->start);
+    const byteQueueIndex_t end   = queue->end;
+
+    // one slot is always left empty to tell a full queue from an empty one
+    byteQueueIndex_t space = (end >= start ? queue->length - end + start : start - end) - 1;
+    if (count > space) {
         return false;
-    } else {
-        queue->data[queue->end] = item;
-        queue->end              = (queue->end + 1) % queue->length;
-        restore_interrupt_setting(setting);
-        return true;
     }
+
+    // copy up to the end of the array, then wrap around
+    byteQueueIndex_t first = queue->length - end;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(queue->data + end, items, first);
+    memcpy(queue->data, items + first, count - first);
+
+    BYTEQUEUE_STORE(queue->end, (byteQueueIndex_t)((end + count) % queue->length));
+    return true;
 }
 
 byteQueueIndex_t bytequeue_length(byteQueue_t* queue) {
-    byteQueueIndex_t    len;
-    interrupt_setting_t setting = store_and_clear_interrupt();
-    if (queue->end >= queue->start)
-        len = queue->end - queue->start;
+    const byteQueueIndex_t start = BYTEQUEUE_LOAD(queue->start);
+    const byteQueueIndex_t end   = BYTEQUEUE_LOAD(queue->end);
+    if (end >= start)
+        return end - start;
     else
-        len = (queue->length - queue->start) + queue->end;
-    restore_interrupt_setting(setting);
-    return len;
+        return (queue->length - start) + end;
 }
 
-// we don't need to avoid interrupts if there is only one reader
+// only valid for indices below a length read by the reader
 uint8_t bytequeue_get(byteQueue_t* queue, byteQueueIndex_t index) {
     return queue->data[(queue->start + index) % queue->length];
 }
 
 // we just update the start index to remove elements
 void bytequeue_remove(byteQueue_t* queue, byteQueueIndex_t numToRemove) {
-    interrupt_setting_t setting = store_and_clear_interrupt();
-    queue->start                = (queue->start + numToRemove) % queue->length;
-    restore_interrupt_setting(setting);
+    BYTEQUEUE_STORE(queue->start, (byteQueueIndex_t)((queue->start + numToRemove) % queue->length));
+}
+
+byteQueueIndex_t bytequeue_dequeue_bulk(byteQueue_t* queue, uint8_t* items, byteQueueIndex_t maxCount) {
+    const byteQueueIndex_t start = queue->start;
+    const byteQueueIndex_t end   = BYTEQUEUE_LOAD(queue->end);
+
+    byteQueueIndex_t count = end >= start ? end - start : queue->length - start + end;
+    if (count > maxCount) {
+        count = maxCount;
+    }
+
+    byteQueueIndex_t first = queue->length - start;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(items, queue->data + start, first);
+    memcpy(items + first, queue->data, count - first);
+
+    BYTEQUEUE_STORE(queue->start, (byteQueueIndex_t)((start + count) % queue->length));
+    return count;
 }
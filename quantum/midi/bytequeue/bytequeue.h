@@ -1,4 +1,4 @@
-// this is a single reader [maybe multiple writer?] byte queue
+// this is a single reader, single writer byte queue
 // Copyright 2008 Alex Norman
 // writen by Alex Norman
 //
@@ -28,6 +28,8 @@ extern "C" {
 
 typedef uint8_t byteQueueIndex_t;
 
+// the writer only moves end and the reader only moves start, so one of them
+// may be an interrupt handler without either side disabling interrupts
 typedef struct {
     byteQueueIndex_t start;
     byteQueueIndex_t end;
@@ -41,6 +43,9 @@ void bytequeue_init(byteQueue_t* queue, uint8_t* dataArray, byteQueueIndex_t arr
 // add an item to the queue, returns false if the queue is full
 bool bytequeue_enqueue(byteQueue_t* queue, uint8_t item);
 
+// add count items to the queue, returns false without adding any if they don't all fit
+bool bytequeue_enqueue_bulk(byteQueue_t* queue, const uint8_t* items, byteQueueIndex_t count);
+
 // get the length of the queue
 byteQueueIndex_t bytequeue_length(byteQueue_t* queue);
 
@@ -50,6 +55,9 @@ uint8_t bytequeue_get(byteQueue_t* queue, byteQueueIndex_t index);
 // update the index in the queue to reflect data that has been dealt with
 void bytequeue_remove(byteQueue_t* queue, byteQueueIndex_t numToRemove);
 
+// copy up to maxCount items out of the queue and remove them, returns the number copied
+byteQueueIndex_t bytequeue_dequeue_bulk(byteQueue_t* queue, uint8_t* items, byteQueueIndex_t maxCount);
+
 #ifdef __cplusplus
 }
 #endif
@@ -49,6 +49,10 @@ extern "C" {
 #include "midi_function_types.h"
 #include "bytequeue/bytequeue.h"
 #define MIDI_INPUT_QUEUE_LENGTH 192
+// bytes taken off the input queue at a time
+#ifndef MIDI_INPUT_CHUNK_LENGTH
+#    define MIDI_INPUT_CHUNK_LENGTH 16
+#endif
 
 typedef enum { IDLE, ONE_BYTE_MESSAGE = 1, TWO_BYTE_MESSAGE = 2, THREE_BYTE_MESSAGE = 3, SYSEX_MESSAGE } input_state_t;
 
@@ -112,6 +116,10 @@ struct _midi_device {
  * function if you are creating a custom device and you want to have midi
  * input.
  *
+ * The bytes are queued until midi_device_process is called. This may be
+ * called from an interrupt handler, as long as only one context ever calls it.
+ * If the bytes don't all fit in the queue, none of them are queued.
+ *
  * @param device the midi device to associate the input with
  * @param cnt the number of bytes you are processing
  * @param input the bytes to process
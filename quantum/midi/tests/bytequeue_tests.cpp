@@ -0,0 +1,174 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "bytequeue/bytequeue.h"
+#include "midi.h"
+}
+
+class ByteQueue : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        bytequeue_init(&queue, data, sizeof(data));
+    }
+
+    uint8_t     data[16];
+    byteQueue_t queue;
+};
+
+TEST_F(ByteQueue, BulkWrapsAround) {
+    const uint8_t in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint8_t       out[10];
+
+    for (int round = 0; round < 8; round++) {
+        EXPECT_TRUE(bytequeue_enqueue_bulk(&queue, in, sizeof(in)));
+        EXPECT_EQ(bytequeue_length(&queue), sizeof(in));
+        EXPECT_EQ(bytequeue_get(&queue, 3), 3);
+        EXPECT_EQ(bytequeue_dequeue_bulk(&queue, out, sizeof(out)), sizeof(out));
+        EXPECT_EQ(0, memcmp(in, out, sizeof(in)));
+        EXPECT_EQ(bytequeue_length(&queue), 0);
+    }
+}
+
+TEST_F(ByteQueue, BulkIsAllOrNothing) {
+    const uint8_t in[10] = {0};
+
+    EXPECT_TRUE(bytequeue_enqueue_bulk(&queue, in, sizeof(in)));
+    EXPECT_FALSE(bytequeue_enqueue_bulk(&queue, in, 6));
+    EXPECT_EQ(bytequeue_length(&queue), 10);
+    EXPECT_TRUE(bytequeue_enqueue_bulk(&queue, in, 5));
+    EXPECT_FALSE(bytequeue_enqueue(&queue, 0));
+    EXPECT_EQ(bytequeue_length(&queue), 15);
+}
+
+TEST_F(ByteQueue, DequeueStopsAtMaxCount) {
+    for (uint8_t i = 0; i < 12; i++) {
+        EXPECT_TRUE(bytequeue_enqueue(&queue, i));
+    }
+
+    uint8_t out[16];
+    EXPECT_EQ(bytequeue_dequeue_bulk(&queue, out, 5), 5);
+    EXPECT_EQ(out[4], 4);
+    bytequeue_remove(&queue, 2);
+    EXPECT_EQ(bytequeue_dequeue_bulk(&queue, out, sizeof(out)), 5);
+    EXPECT_EQ(out[0], 7);
+    EXPECT_EQ(bytequeue_dequeue_bulk(&queue, out, sizeof(out)), 0);
+}
+
+TEST_F(ByteQueue, TwoThreads) {
+    const uint32_t count = 200000;
+
+    std::thread producer([this, count] {
+        std::mt19937 rng(1);
+        uint8_t      next = 0;
+        for (uint32_t sent = 0; sent < count;) {
+            uint8_t items[20];
+            uint8_t n = 1 + rng() % sizeof(items);
+            if (n > count - sent) {
+                n = count - sent;
+            }
+            for (uint8_t i = 0; i < n; i++) {
+                items[i] = next + i;
+            }
+            if (n == 1 ? bytequeue_enqueue(&queue, items[0]) : bytequeue_enqueue_bulk(&queue, items, n)) {
+                next += n;
+                sent += n;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::mt19937 rng(2);
+    uint8_t      expected = 0;
+    uint32_t     received = 0;
+    while (received < count) {
+        uint8_t          items[20];
+        byteQueueIndex_t n = bytequeue_dequeue_bulk(&queue, items, 1 + rng() % sizeof(items));
+        for (byteQueueIndex_t i = 0; i < n; i++) {
+            ASSERT_EQ(items[i], expected++) << "at byte " << received + i;
+        }
+        received += n;
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_EQ(bytequeue_length(&queue), 0);
+}
+
+namespace {
+
+std::vector<uint8_t> cc_values;
+std::vector<uint8_t> sysex_bytes;
+
+void cc_callback(MidiDevice* device, uint8_t chan, uint8_t num, uint8_t val) {
+    cc_values.push_back(val);
+}
+
+void sysex_callback(MidiDevice* device, uint16_t start, uint8_t length, uint8_t* data) {
+    sysex_bytes.insert(sysex_bytes.end(), data, data + length);
+}
+
+} // namespace
+
+TEST(MidiDevice, ProcessesInputFromAnotherThread) {
+    MidiDevice device;
+    midi_device_init(&device);
+    midi_register_cc_callback(&device, cc_callback);
+    midi_register_sysex_callback(&device, sysex_callback);
+    cc_values.clear();
+    sysex_bytes.clear();
+
+    const int         messages = 20000;
+    std::atomic<bool> done(false);
+
+    // A stream of CC messages with a sysex dump every so often, fed three bytes at a time like USB MIDI packets
+    std::thread producer([&device, &done] {
+        for (int i = 0; i < messages; i++) {
+            uint8_t packet[3] = {MIDI_CC | 1, 7, (uint8_t)(i & 0x7F)};
+            if (i % 100 == 0) {
+                packet[0] = SYSEX_BEGIN;
+                packet[1] = 0x7D;
+                packet[2] = (uint8_t)(i / 100 & 0x7F);
+                while (bytequeue_length(&device.input_queue) > MIDI_INPUT_QUEUE_LENGTH - 7) {
+                    std::this_thread::yield();
+                }
+                midi_device_input(&device, 3, packet);
+                packet[0] = SYSEX_END;
+                midi_device_input(&device, 1, packet);
+                continue;
+            }
+            while (bytequeue_length(&device.input_queue) > MIDI_INPUT_QUEUE_LENGTH - 4) {
+                std::this_thread::yield();
+            }
+            midi_device_input(&device, 3, packet);
+        }
+        done = true;
+    });
+
+    while (!done || bytequeue_length(&device.input_queue)) {
+        midi_device_process(&device);
+        std::this_thread::yield();
+    }
+    producer.join();
+
+    ASSERT_EQ(cc_values.size(), messages - messages / 100);
+    ASSERT_EQ(sysex_bytes.size(), messages / 100 * 4);
+    for (size_t i = 0, cc = 0; i < messages; i++) {
+        if (i % 100 == 0) {
+            EXPECT_EQ(sysex_bytes[i / 100 * 4 + 2], i / 100 & 0x7F);
+            EXPECT_EQ(sysex_bytes[i / 100 * 4 + 3], SYSEX_END);
+        } else {
+            EXPECT_EQ(cc_values[cc++], i & 0x7F);
+        }
+    }
+}
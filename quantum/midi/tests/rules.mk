@@ -0,0 +1,10 @@
+bytequeue_DEFS := -DNO_DEBUG
+
+bytequeue_SRC := \
+	$(QUANTUM_PATH)/midi/tests/bytequeue_tests.cpp \
+	$(QUANTUM_PATH)/midi/bytequeue/bytequeue.c \
+	$(QUANTUM_PATH)/midi/midi_device.c \
+	$(QUANTUM_PATH)/midi/midi.c
+
+bytequeue_INC := \
+	$(QUANTUM_PATH)/midi
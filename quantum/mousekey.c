@@ -24,6 +24,20 @@
 #include "debug.h"
 #include "mousekey.h"
 
+#ifdef MOUSEKEY_FIXED_POINT
+#    include "deferred_exec.h"
+#    include "util.h"
+#    ifndef DEFERRED_EXEC_ENABLE
+#        error "MOUSEKEY_FIXED_POINT requires DEFERRED_EXEC_ENABLE = yes"
+#    endif
+#    if !defined(MK_KINETIC_SPEED) && !defined(MK_3_SPEED)
+#        error "MOUSEKEY_FIXED_POINT requires MK_KINETIC_SPEED or MK_3_SPEED"
+#    endif
+#    if defined(MOUSEKEY_INERTIA) || defined(MK_COMBINED)
+#        error "MOUSEKEY_FIXED_POINT cannot be combined with MOUSEKEY_INERTIA or MK_COMBINED"
+#    endif
+#endif
+
 static inline int8_t times_inv_sqrt2(int8_t x) {
     // 181/256 (0.70703125) is used as an approximation for 1/sqrt(2)
     // because it is close to the exact value which is 0.707106781
@@ -52,6 +66,20 @@ static int8_t  mousekey_y_inertia = 0; // ...
 #ifdef MK_KINETIC_SPEED
 static uint16_t mouse_timer = 0;
 #endif
+#ifdef MOUSEKEY_FIXED_POINT
+static deferred_executor_t mousekey_motion_executors[1] = {0};
+static uint32_t            mousekey_motion_last_exec    = 0;
+
+static deferred_token mousekey_motion_token   = INVALID_DEFERRED_TOKEN;
+static uint32_t       mousekey_motion_elapsed = 0; // ms of motion integrated so far, advanced in whole ticks
+static int8_t         mousekey_motion_x_dir   = 0; // -1 / 0 / 1 = left / neutral / right
+static int8_t         mousekey_motion_y_dir   = 0; // -1 / 0 / 1 = up / neutral / down
+static uint32_t       mousekey_motion_x_rem   = 0; // distance not sent yet, 1/256 units, whole units past MOUSEKEY_MOVE_MAX included
+static uint32_t       mousekey_motion_y_rem   = 0; // ...
+static uint32_t       mousekey_motion_speed(uint32_t elapsed);
+static uint16_t       mousekey_motion_interval(void);
+static bool           mousekey_motion_key(uint8_t code, bool pressed);
+#endif
 
 #ifndef MK_3_SPEED
 
@@ -239,7 +267,42 @@ static uint8_t wheel_unit(void) {
     return 1;
 }
 
-#        endif /* #ifndef MK_KINETIC_SPEED */
+#            ifdef MOUSEKEY_FIXED_POINT
+
+/*
+ * Same curve as move_unit() but continuous in time instead of stepping every
+ * 50ms, in report units per second as 24.8 fixed point:
+ *
+ *  speed = I + A * t/50 + A * (t/50)^2 * 1/2 | maximum B
+ */
+static uint32_t mousekey_motion_speed(uint32_t elapsed) {
+    if (mousekey_accel & (1 << 0)) {
+        return (uint32_t)mk_decelerated_speed << 8;
+    } else if (mousekey_accel & (1 << 2)) {
+        return (uint32_t)mk_accelerated_speed << 8;
+    }
+
+    const uint32_t base = (uint32_t)mk_base_speed << 8;
+    const uint32_t t    = elapsed > UINT16_MAX ? UINT16_MAX : elapsed;
+    const uint32_t t2   = t * t;
+
+    // the quadratic term alone has passed the base speed, which also keeps the math below within 32 bits
+    if ((t2 / 5000) * MOUSEKEY_MOVE_DELTA >= mk_base_speed) {
+        return base;
+    }
+
+    uint32_t speed = (uint32_t)mk_initial_speed << 8;
+    speed += ((uint32_t)MOUSEKEY_MOVE_DELTA * t << 8) / 50;
+    speed += (uint32_t)MOUSEKEY_MOVE_DELTA * (((t2 / 5000) << 8) + ((t2 % 5000) << 8) / 5000);
+    return speed > base ? base : speed;
+}
+
+static uint16_t mousekey_motion_interval(void) {
+    return mk_interval;
+}
+
+#            endif /* #ifdef MOUSEKEY_FIXED_POINT */
+#        endif     /* #ifndef MK_KINETIC_SPEED */
 #    else      /* #ifndef MK_COMBINED */
 
 /* Combined mode */
@@ -305,6 +368,11 @@ static int8_t calc_inertia(int8_t direction, int8_t velocity) {
 #    endif
 
 void mousekey_task(void) {
+#    ifdef MOUSEKEY_FIXED_POINT
+    // cursor motion ticks are run from here rather than the main loop so they cannot collide with user executors
+    deferred_exec_advanced_task(mousekey_motion_executors, ARRAY_SIZE(mousekey_motion_executors), &mousekey_motion_last_exec);
+#    endif
+
     // report cursor and scroll movement independently
     report_mouse_t tmpmr = mouse_report;
 
@@ -385,6 +453,12 @@ void mousekey_task(void) {
 }
 
 void mousekey_on(uint8_t code) {
+#    ifdef MOUSEKEY_FIXED_POINT
+    if (mousekey_motion_key(code, true)) {
+        return;
+    }
+#    endif
+
 #    ifdef MK_KINETIC_SPEED
     if (mouse_timer == 0) {
         mouse_timer = timer_read();
@@ -447,6 +521,12 @@ void mousekey_on(uint8_t code) {
 }
 
 void mousekey_off(uint8_t code) {
+#    ifdef MOUSEKEY_FIXED_POINT
+    if (mousekey_motion_key(code, false)) {
+        return;
+    }
+#    endif
+
 #    ifdef MOUSEKEY_INERTIA
 
     // key release clears impulse unless opposite direction is held
@@ -513,7 +593,25 @@ uint16_t        c_intervals[mkspd_COUNT] = {MK_C_INTERVAL_UNMOD, MK_C_INTERVAL_0
 uint16_t        w_offsets[mkspd_COUNT]   = {MK_W_OFFSET_UNMOD, MK_W_OFFSET_0, MK_W_OFFSET_1, MK_W_OFFSET_2};
 uint16_t        w_intervals[mkspd_COUNT] = {MK_W_INTERVAL_UNMOD, MK_W_INTERVAL_0, MK_W_INTERVAL_1, MK_W_INTERVAL_2};
 
+#    ifdef MOUSEKEY_FIXED_POINT
+
+/* c_offsets[] units every c_intervals[] ms, in report units per second as 24.8 fixed point */
+static uint32_t mousekey_motion_speed(uint32_t elapsed) {
+    return ((uint32_t)c_offsets[mk_speed] * 256000U) / c_intervals[mk_speed];
+}
+
+static uint16_t mousekey_motion_interval(void) {
+    return c_intervals[mk_speed];
+}
+
+#    endif
+
 void mousekey_task(void) {
+#    ifdef MOUSEKEY_FIXED_POINT
+    // cursor motion ticks are run from here rather than the main loop so they cannot collide with user executors
+    deferred_exec_advanced_task(mousekey_motion_executors, ARRAY_SIZE(mousekey_motion_executors), &mousekey_motion_last_exec);
+#    endif
+
     // report cursor and scroll movement independently
     report_mouse_t tmpmr = mouse_report;
     mouse_report.x       = 0;
@@ -565,6 +663,11 @@ void adjust_speed(void) {
 }
 
 void mousekey_on(uint8_t code) {
+#    ifdef MOUSEKEY_FIXED_POINT
+    if (mousekey_motion_key(code, true)) {
+        return;
+    }
+#    endif
     uint16_t const c_offset  = c_offsets[mk_speed];
     uint16_t const w_offset  = w_offsets[mk_speed];
     uint8_t const  old_speed = mk_speed;
@@ -596,6 +699,11 @@ void mousekey_on(uint8_t code) {
 }
 
 void mousekey_off(uint8_t code) {
+#    ifdef MOUSEKEY_FIXED_POINT
+    if (mousekey_motion_key(code, false)) {
+        return;
+    }
+#    endif
 #    ifdef MK_MOMENTARY_ACCEL
     uint8_t const old_speed = mk_speed;
 #    endif
@@ -630,6 +738,116 @@ void mousekey_off(uint8_t code) {
 
 #endif /* #ifndef MK_3_SPEED */
 
+#ifdef MOUSEKEY_FIXED_POINT
+
+/*
+ * Fixed point cursor motion
+ *
+ * Instead of sending a speed dependent step whenever the main loop gets
+ * around to it, the cursor distance is integrated from the speed curve over
+ * ticks of exactly mousekey_motion_interval() ms, run by the deferred
+ * executor. The fraction of a report unit that could not be sent is carried
+ * over to the next tick, as are whole units past MOUSEKEY_MOVE_MAX, so the
+ * distance travelled only depends on how long the key was held.
+ */
+
+static void mousekey_motion_reset(void) {
+    if (mousekey_motion_token != INVALID_DEFERRED_TOKEN) {
+        cancel_deferred_exec_advanced(mousekey_motion_executors, ARRAY_SIZE(mousekey_motion_executors), mousekey_motion_token);
+        mousekey_motion_token = INVALID_DEFERRED_TOKEN;
+    }
+    mousekey_motion_elapsed = 0;
+    mousekey_motion_x_rem   = 0;
+    mousekey_motion_y_rem   = 0;
+}
+
+#    ifndef MOUSEKEY_MOVE_MAX
+#        define MOUSEKEY_MOVE_MAX 127
+#    endif
+
+static int8_t mousekey_motion_step(uint32_t *rem, uint32_t distance, int8_t dir) {
+    if (!dir) {
+        return 0;
+    }
+
+    uint32_t total = *rem + distance;
+    int8_t   units = (total >> 8) > MOUSEKEY_MOVE_MAX ? MOUSEKEY_MOVE_MAX : (total >> 8);
+    *rem           = total - ((uint32_t)units << 8);
+    return dir < 0 ? -units : units;
+}
+
+static uint32_t mousekey_motion_tick(uint32_t trigger_time, void *cb_arg) {
+    const uint16_t interval = mousekey_motion_interval();
+
+    // midpoint of the tick, exact for the linear part of the curve and within 1/1000 unit per tick for the rest
+    uint32_t distance = (mousekey_motion_speed(mousekey_motion_elapsed + interval / 2) * interval + 500) / 1000;
+    mousekey_motion_elapsed += interval;
+
+    /* diagonal move [1/sqrt(2)] */
+    if (mousekey_motion_x_dir && mousekey_motion_y_dir) {
+        distance = (distance * 181) >> 8;
+    }
+
+    report_mouse_t tmpmr = mouse_report;
+    mouse_report.x       = mousekey_motion_step(&mousekey_motion_x_rem, distance, mousekey_motion_x_dir);
+    mouse_report.y       = mousekey_motion_step(&mousekey_motion_y_rem, distance, mousekey_motion_y_dir);
+    mouse_report.v       = 0;
+    mouse_report.h       = 0;
+    if (mouse_report.x || mouse_report.y) {
+        mousekey_send();
+    }
+    mouse_report = tmpmr;
+
+    return interval;
+}
+
+static bool mousekey_motion_key(uint8_t code, bool pressed) {
+    int8_t x_dir = mousekey_motion_x_dir;
+    int8_t y_dir = mousekey_motion_y_dir;
+
+    if (pressed) {
+        if (code == KC_MS_UP)
+            y_dir = -1;
+        else if (code == KC_MS_DOWN)
+            y_dir = 1;
+        else if (code == KC_MS_LEFT)
+            x_dir = -1;
+        else if (code == KC_MS_RIGHT)
+            x_dir = 1;
+        else
+            return false;
+    } else {
+        // key release clears direction unless opposite direction is held
+        if (code == KC_MS_UP) {
+            if (y_dir < 0) y_dir = 0;
+        } else if (code == KC_MS_DOWN) {
+            if (y_dir > 0) y_dir = 0;
+        } else if (code == KC_MS_LEFT) {
+            if (x_dir < 0) x_dir = 0;
+        } else if (code == KC_MS_RIGHT) {
+            if (x_dir > 0) x_dir = 0;
+        } else {
+            return false;
+        }
+    }
+
+    // a reversed axis starts from a whole unit again
+    if (x_dir != mousekey_motion_x_dir) mousekey_motion_x_rem = 0;
+    if (y_dir != mousekey_motion_y_dir) mousekey_motion_y_rem = 0;
+    mousekey_motion_x_dir = x_dir;
+    mousekey_motion_y_dir = y_dir;
+
+    if (!x_dir && !y_dir) {
+        mousekey_motion_reset();
+    } else if (mousekey_motion_token == INVALID_DEFERRED_TOKEN) {
+        mousekey_motion_last_exec = timer_read32();
+        mousekey_motion_token     = defer_exec_advanced(mousekey_motion_executors, ARRAY_SIZE(mousekey_motion_executors), mousekey_motion_interval(), mousekey_motion_tick, NULL);
+    }
+    return true;
+}
+
+#endif /* #ifdef MOUSEKEY_FIXED_POINT */
+
 void mousekey_send(void) {
     mousekey_debug();
     uint16_t time = timer_read();
@@ -650,6 +868,11 @@ void mousekey_clear(void) {
     mousekey_x_dir     = 0;
     mousekey_y_dir     = 0;
 #endif
+#ifdef MOUSEKEY_FIXED_POINT
+    mousekey_motion_reset();
+    mousekey_motion_x_dir = 0;
+    mousekey_motion_y_dir = 0;
+#endif
 }
 
 static void mousekey_debug(void) {
@@ -64,7 +64,7 @@ bool qgf_parse_format(qp_image_format_t format, uint8_t *bpp, bool *has_palette,
     return true;
 }
 
-bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, painter_compression_t *compression_scheme, uint16_t *delay) {
+bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, bool *is_tiled, painter_compression_t *compression_scheme, uint16_t *delay) {
     // Decode the format
     qgf_parse_format(frame_descriptor->format, bpp, has_palette, is_panel_native);
 
@@ -72,6 +72,9 @@ bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp,
     if (is_delta) {
         *is_delta = (frame_descriptor->flags & QGF_FRAME_FLAG_DELTA) == QGF_FRAME_FLAG_DELTA;
     }
+    if (is_tiled) {
+        *is_tiled = (frame_descriptor->flags & QGF_FRAME_FLAG_TILED) == QGF_FRAME_FLAG_TILED;
+    }
     if (compression_scheme) {
         *compression_scheme = frame_descriptor->compression_scheme;
     }
@@ -177,7 +180,7 @@ void qgf_seek_to_frame_descriptor(qp_stream_t *stream, uint16_t frame_number) {
     qp_stream_setpos(stream, offset);
 }
 
-bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta) {
+bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, bool *is_tiled) {
     // Seek to the correct location
     qgf_seek_to_frame_descriptor(stream, frame_number);
 
@@ -193,7 +196,13 @@ bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, u
         return false;
     }
 
-    return qgf_parse_frame_descriptor(&frame_descriptor, bpp, has_palette, is_panel_native, is_delta, NULL, NULL);
+    // Delta and tiled frames are mutually exclusive
+    if ((frame_descriptor.flags & (QGF_FRAME_FLAG_DELTA | QGF_FRAME_FLAG_TILED)) == (QGF_FRAME_FLAG_DELTA | QGF_FRAME_FLAG_TILED)) {
+        qp_dprintf("Failed to validate frame_descriptor, delta and tiled flags are both set\n");
+        return false;
+    }
+
+    return qgf_parse_frame_descriptor(&frame_descriptor, bpp, has_palette, is_panel_native, is_delta, is_tiled, NULL, NULL);
 }
 
 bool qgf_validate_palette_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t bpp) {
@@ -243,12 +252,60 @@ bool qgf_validate_frame_data_descriptor(qp_stream_t *stream, uint16_t frame_numb
         return false;
     }
 
+    // Move forward in the stream to the next block
+    qp_stream_seek(stream, data_descriptor.header.length, SEEK_CUR);
+    return true;
+}
+
+bool qgf_validate_delta_tiles_descriptor(qp_stream_t *stream, uint16_t frame_number, uint16_t image_width, uint16_t image_height) {
+    // Read the delta tiles descriptor
+    qgf_delta_tiles_v1_t tiles_descriptor;
+    if (qp_stream_read(&tiles_descriptor, sizeof(qgf_delta_tiles_v1_t), 1, stream) != 1) {
+        qp_dprintf("Failed to read delta_tiles_descriptor, expected length was not %d\n", (int)sizeof(qgf_delta_tiles_v1_t));
+        return false;
+    }
+
+    // Make sure this block is valid
+    if (!qgf_validate_block_header(&tiles_descriptor.header, QGF_FRAME_DELTA_TILES_DESCRIPTOR_TYPEID, -1)) {
+        return false;
+    }
+
+    // Zero tiles is valid, and signifies a frame identical to the previous one
+    if ((tiles_descriptor.header.length % sizeof(qgf_delta_tile_v1_t)) != 0) {
+        qp_dprintf("Failed to validate delta_tiles_descriptor, invalid length %d\n", (int)tiles_descriptor.header.length);
+        return false;
+    }
+
+    // Make sure each of the tiles lies within the image bounds
+    uint32_t tile_count = tiles_descriptor.header.length / sizeof(qgf_delta_tile_v1_t);
+    for (uint32_t i = 0; i < tile_count; ++i) {
+        qgf_delta_tile_v1_t tile;
+        if (qp_stream_read(&tile, sizeof(qgf_delta_tile_v1_t), 1, stream) != 1) {
+            qp_dprintf("Failed to read delta tile, expected length was not %d\n", (int)sizeof(qgf_delta_tile_v1_t));
+            return false;
+        }
+
+        if (tile.left > tile.right || tile.top > tile.bottom || tile.right >= image_width || tile.bottom >= image_height) {
+            qp_dprintf("Failed to validate delta tile %d, invalid bounds (%d,%d)-(%d,%d)\n", (int)i, (int)tile.left, (int)tile.top, (int)tile.right, (int)tile.bottom);
+            return false;
+        }
+    }
+
+    // Each tile has its own data block, in the same order as the tile locations
+    for (uint32_t i = 0; i < tile_count; ++i) {
+        if (!qgf_validate_frame_data_descriptor(stream, frame_number)) {
+            return false;
+        }
+    }
+
     return true;
 }
 
 bool qgf_validate_stream(qp_stream_t *stream) {
+    uint16_t image_width;
+    uint16_t image_height;
     uint16_t frame_count;
-    if (!qgf_read_graphics_descriptor(stream, NULL, NULL, &frame_count, NULL)) {
+    if (!qgf_read_graphics_descriptor(stream, &image_width, &image_height, &frame_count, NULL)) {
         return false;
     }
 
@@ -259,7 +316,8 @@ bool qgf_validate_stream(qp_stream_t *stream) {
         bool    has_palette;
         bool    is_panel_native;
         bool    has_delta;
-        if (!qgf_validate_frame_descriptor(stream, i, &bpp, &has_palette, &is_panel_native, &has_delta)) {
+        bool    has_tiles;
+        if (!qgf_validate_frame_descriptor(stream, i, &bpp, &has_palette, &is_panel_native, &has_delta, &has_tiles)) {
             return false;
         }
 
@@ -273,6 +331,14 @@ bool qgf_validate_stream(qp_stream_t *stream) {
             return false;
         }
 
+        // Tiled frames carry their own data blocks, one per tile
+        if (has_tiles) {
+            if (!qgf_validate_delta_tiles_descriptor(stream, i, image_width, image_height)) {
+                return false;
+            }
+            continue;
+        }
+
         // Check the data block
         if (!qgf_validate_frame_data_descriptor(stream, i)) {
             return false;
@@ -117,6 +117,9 @@ typedef struct qgf_frame_info_t {
     bool                  has_palette;
     bool                  is_panel_native;
     bool                  is_delta;
+    bool                  is_tiled;
+    uint16_t              tile_count;
+    uint32_t              tiles_offset;
     uint16_t              left;
     uint16_t              top;
     uint16_t              right;
@@ -144,7 +147,7 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     }
 
     // Parse out the frame info
-    if (!qgf_parse_frame_descriptor(&frame_descriptor, &info->bpp, &info->has_palette, &info->is_panel_native, &info->is_delta, &info->compression_scheme, &info->delay)) {
+    if (!qgf_parse_frame_descriptor(&frame_descriptor, &info->bpp, &info->has_palette, &info->is_panel_native, &info->is_delta, &info->is_tiled, &info->compression_scheme, &info->delay)) {
         return false;
     }
 
@@ -197,6 +200,19 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         info->bottom = delta_descriptor.bottom;
     }
 
+    // Handle tiles if needed -- each tile is followed by its own data block, so leave the stream at the tile locations
+    if (info->is_tiled) {
+        qgf_delta_tiles_v1_t tiles_descriptor;
+        if (qp_stream_read(&tiles_descriptor, sizeof(qgf_delta_tiles_v1_t), 1, &qgf_image->stream) != 1) {
+            qp_dprintf("Failed to read delta_tiles_descriptor, expected length was not %d\n", (int)sizeof(qgf_delta_tiles_v1_t));
+            return false;
+        }
+
+        info->tile_count   = tiles_descriptor.header.length / sizeof(qgf_delta_tile_v1_t);
+        info->tiles_offset = qp_stream_tell(&qgf_image->stream);
+        return true;
+    }
+
     // Read the data block
     qgf_data_v1_t data_descriptor;
     if (qp_stream_read(&data_descriptor, sizeof(qgf_data_v1_t), 1, &qgf_image->stream) != 1) {
@@ -208,6 +224,29 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     return true;
 }
 
+// Streams the pixel data at the current stream position to the given region of the display
+static bool qp_drawimage_stream_region(painter_device_t device, qgf_image_handle_t *qgf_image, qgf_frame_info_t *frame_info, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    painter_driver_t *driver      = (painter_driver_t *)device;
+    uint32_t          pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
+
+    // Configure where we're going to be rendering to
+    if (!driver->driver_vtable->viewport(device, l, t, r, b)) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
+        return false;
+    }
+
+    // Set up the input state
+    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
+    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
+    if (input_callback == NULL) {
+        qp_dprintf("qp_drawimage_recolor: fail (invalid image compression scheme)\n");
+        return false;
+    }
+
+    // Decode and stream pixels
+    return qp_internal_appender(device, frame_info->bpp, pixel_count, input_callback, &input_state);
+}
+
 static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, int frame_number, qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
     qp_dprintf("qp_drawimage_recolor: entry\n");
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -233,38 +272,36 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
-    uint16_t l, t, r, b;
-    if (frame_info->is_delta) {
-        l = x + frame_info->left;
-        t = y + frame_info->top;
-        r = x + frame_info->right;
-        b = y + frame_info->bottom;
+    bool ret;
+    if (frame_info->is_tiled) {
+        // Tiles are laid out as a list of locations, followed by one data block per tile in the same order
+        uint32_t data_offset = frame_info->tiles_offset + (uint32_t)frame_info->tile_count * sizeof(qgf_delta_tile_v1_t);
+        ret                  = true;
+        for (uint16_t i = 0; ret && i < frame_info->tile_count; ++i) {
+            qgf_delta_tile_v1_t tile;
+            qp_stream_setpos(&qgf_image->stream, frame_info->tiles_offset + (uint32_t)i * sizeof(qgf_delta_tile_v1_t));
+            if (qp_stream_read(&tile, sizeof(qgf_delta_tile_v1_t), 1, &qgf_image->stream) != 1) {
+                qp_dprintf("qp_drawimage_recolor: fail (could not read tile %d)\n", (int)i);
+                ret = false;
+                break;
+            }
+
+            qgf_data_v1_t data_descriptor;
+            qp_stream_setpos(&qgf_image->stream, data_offset);
+            if (qp_stream_read(&data_descriptor, sizeof(qgf_data_v1_t), 1, &qgf_image->stream) != 1) {
+                qp_dprintf("qp_drawimage_recolor: fail (could not read data for tile %d)\n", (int)i);
+                ret = false;
+                break;
+            }
+            data_offset += sizeof(qgf_data_v1_t) + data_descriptor.header.length;
+
+            ret = qp_drawimage_stream_region(device, qgf_image, frame_info, x + tile.left, y + tile.top, x + tile.right, y + tile.bottom);
+        }
+    } else if (frame_info->is_delta) {
+        ret = qp_drawimage_stream_region(device, qgf_image, frame_info, x + frame_info->left, y + frame_info->top, x + frame_info->right, y + frame_info->bottom);
     } else {
-        l = x;
-        t = y;
-        r = x + image->width - 1;
-        b = y + image->height - 1;
+        ret = qp_drawimage_stream_region(device, qgf_image, frame_info, x, y, x + image->width - 1, y + image->height - 1);
     }
-    uint32_t pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
-
-    // Configure where we're going to be rendering to
-    if (!driver->driver_vtable->viewport(device, l, t, r, b)) {
-        qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
-        qp_comms_stop(device);
-        return false;
-    }
-
-    // Set up the input state
-    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
-    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
-    if (input_callback == NULL) {
-        qp_dprintf("qp_drawimage_recolor: fail (invalid image compression scheme)\n");
-        qp_comms_stop(device);
-        return false;
-    }
-
-    // Decode and stream pixels
-    bool ret = qp_internal_appender(device, frame_info->bpp, pixel_count, input_callback, &input_state);
 
     qp_dprintf("qp_drawimage_recolor: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
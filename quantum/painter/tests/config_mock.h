@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 1
+#define MATRIX_COLS 1
+
+// The test image is in the panel's own RGB565 format
+#define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS 1
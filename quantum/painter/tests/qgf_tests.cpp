@@ -0,0 +1,186 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "qp.h"
+#include "qgf.h"
+#include "qp_surface_internal.h"
+#include "tiled_animation.qgf.h"
+
+void qp_internal_animation_tick(void);
+void advance_time(uint32_t ms);
+}
+
+// tiled_animation.gif is 32x16, with 3 frames of 100ms. Frame 0 is a gradient, frame 1 adds a red and a blue
+// square, and frame 2 puts the red square back to the gradient and adds a green one.
+#define IMAGE_WIDTH 32
+#define IMAGE_HEIGHT 16
+#define FRAME_DELAY 100
+
+struct rect_t {
+    uint16_t l, t, r, b;
+    bool     operator==(const rect_t &other) const {
+        return l == other.l && t == other.t && r == other.r && b == other.b;
+    }
+};
+
+static std::ostream &operator<<(std::ostream &os, const rect_t &rect) {
+    return os << "(" << rect.l << "," << rect.t << ")-(" << rect.r << "," << rect.b << ")";
+}
+
+static const rect_t RED_SQUARE   = {2, 2, 5, 5};
+static const rect_t BLUE_SQUARE  = {25, 11, 27, 12};
+static const rect_t GREEN_SQUARE = {16, 0, 17, 1};
+
+static bool contains(const rect_t &rect, uint16_t x, uint16_t y) {
+    return x >= rect.l && x <= rect.r && y >= rect.t && y <= rect.b;
+}
+
+// RGB565 as stored by the surface, in panel byte order
+static uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
+    return __builtin_bswap16((r >> 3) << 11 | (g >> 2) << 5 | (b >> 3));
+}
+
+static uint16_t expected_pixel(int frame, uint16_t x, uint16_t y) {
+    if (frame == 1 && contains(RED_SQUARE, x, y)) return rgb565(255, 0, 0);
+    if (frame >= 1 && contains(BLUE_SQUARE, x, y)) return rgb565(0, 0, 255);
+    if (frame == 2 && contains(GREEN_SQUARE, x, y)) return rgb565(0, 255, 0);
+    return rgb565(x * 8, (y / 4) * 64, 0x80);
+}
+
+static std::vector<rect_t> viewports;
+
+static bool (*surface_viewport)(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
+
+static bool recording_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    viewports.push_back({left, top, right, bottom});
+    return surface_viewport(device, left, top, right, bottom);
+}
+
+class QuantumPainterQGF : public ::testing::Test {
+   protected:
+    static const uint16_t    SURFACE_WIDTH  = 48;
+    static const uint16_t    SURFACE_HEIGHT = 24;
+    surface_painter_device_t surface_table[1];
+    painter_driver_vtable_t  vtable;
+    uint16_t                 buffer[SURFACE_WIDTH * SURFACE_HEIGHT];
+    painter_device_t         surface;
+
+    void SetUp() override {
+        // The animation executor keeps the time it last ran, so time only moves forward between tests
+        memset(surface_table, 0, sizeof(surface_table));
+        memset(buffer, 0, sizeof(buffer));
+        surface = qp_make_rgb565_surface_advanced(surface_table, 1, SURFACE_WIDTH, SURFACE_HEIGHT, buffer);
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+
+        // Note the area of each draw, on top of drawing to the surface
+        painter_driver_t *driver = (painter_driver_t *)surface;
+        vtable                   = *driver->driver_vtable;
+        surface_viewport         = vtable.viewport;
+        vtable.viewport          = recording_viewport;
+        driver->driver_vtable    = &vtable;
+        viewports.clear();
+    }
+
+    void ExpectFrame(int frame, uint16_t x, uint16_t y) {
+        for (uint16_t py = 0; py < SURFACE_HEIGHT; py++) {
+            for (uint16_t px = 0; px < SURFACE_WIDTH; px++) {
+                bool     inside   = px >= x && px < x + IMAGE_WIDTH && py >= y && py < y + IMAGE_HEIGHT;
+                uint16_t expected = inside ? expected_pixel(frame, px - x, py - y) : 0;
+                ASSERT_EQ(buffer[py * SURFACE_WIDTH + px], expected) << "frame " << frame << " pixel (" << px << "," << py << ")";
+            }
+        }
+    }
+
+    void NextFrame() {
+        viewports.clear();
+        advance_time(FRAME_DELAY);
+        qp_internal_animation_tick();
+    }
+};
+
+TEST_F(QuantumPainterQGF, TiledFramesOnlyDrawChangedTiles) {
+    painter_image_handle_t image = qp_load_image_mem(gfx_tiled_animation);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->frame_count, 3);
+
+    deferred_token token = qp_animate(surface, 0, 0, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(viewports, (std::vector<rect_t>{{0, 0, IMAGE_WIDTH - 1, IMAGE_HEIGHT - 1}}));
+    ExpectFrame(0, 0, 0);
+
+    NextFrame();
+    EXPECT_EQ(viewports, (std::vector<rect_t>{RED_SQUARE, BLUE_SQUARE}));
+    ExpectFrame(1, 0, 0);
+
+    NextFrame();
+    EXPECT_EQ(viewports, (std::vector<rect_t>{RED_SQUARE, GREEN_SQUARE}));
+    ExpectFrame(2, 0, 0);
+
+    // Back to the start, which is a whole frame
+    NextFrame();
+    EXPECT_EQ(viewports, (std::vector<rect_t>{{0, 0, IMAGE_WIDTH - 1, IMAGE_HEIGHT - 1}}));
+    ExpectFrame(0, 0, 0);
+
+    qp_stop_animation(token);
+    EXPECT_TRUE(qp_close_image(image));
+}
+
+TEST_F(QuantumPainterQGF, TiledFramesAreDrawnAtTheImagePosition) {
+    const uint16_t         x = 9, y = 5;
+    painter_image_handle_t image = qp_load_image_mem(gfx_tiled_animation);
+    ASSERT_NE(image, nullptr);
+
+    deferred_token token = qp_animate(surface, x, y, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    ExpectFrame(0, x, y);
+
+    NextFrame();
+    ExpectFrame(1, x, y);
+
+    NextFrame();
+    EXPECT_EQ(viewports, (std::vector<rect_t>{{RED_SQUARE.l + x, RED_SQUARE.t + y, RED_SQUARE.r + x, RED_SQUARE.b + y}, {GREEN_SQUARE.l + x, GREEN_SQUARE.t + y, GREEN_SQUARE.r + x, GREEN_SQUARE.b + y}}));
+    ExpectFrame(2, x, y);
+
+    qp_stop_animation(token);
+    EXPECT_TRUE(qp_close_image(image));
+}
+
+class QuantumPainterQGFValidation : public ::testing::Test {
+   protected:
+    uint8_t data[sizeof(gfx_tiled_animation)];
+
+    void SetUp() override {
+        memcpy(data, gfx_tiled_animation, sizeof(data));
+    }
+
+    // The first tile of frame 1, which has no palette so its tiles follow straight after the frame descriptor
+    qgf_delta_tile_v1_t *FirstTile() {
+        const qgf_frame_offsets_v1_t *offsets = (const qgf_frame_offsets_v1_t *)&data[sizeof(qgf_graphics_descriptor_v1_t)];
+        uint32_t                      frame   = offsets->offset[1];
+        qgf_delta_tiles_v1_t         *tiles   = (qgf_delta_tiles_v1_t *)&data[frame + sizeof(qgf_frame_v1_t)];
+        EXPECT_EQ(tiles->header.type_id, QGF_FRAME_DELTA_TILES_DESCRIPTOR_TYPEID);
+        return &tiles->tile[0];
+    }
+};
+
+TEST_F(QuantumPainterQGFValidation, Valid) {
+    painter_image_handle_t image = qp_load_image_mem(data);
+    ASSERT_NE(image, nullptr);
+    EXPECT_TRUE(qp_close_image(image));
+}
+
+TEST_F(QuantumPainterQGFValidation, TileOutsideImage) {
+    FirstTile()->right = IMAGE_WIDTH;
+    EXPECT_EQ(qp_load_image_mem(data), nullptr);
+}
+
+TEST_F(QuantumPainterQGFValidation, TileInsideOut) {
+    qgf_delta_tile_v1_t *tile = FirstTile();
+    tile->top                 = tile->bottom + 1;
+    EXPECT_EQ(qp_load_image_mem(data), nullptr);
+}
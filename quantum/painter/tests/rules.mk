@@ -0,0 +1,20 @@
+painter_DEFS := -DEEPROM_TEST_HARNESS -DQUANTUM_PAINTER_ENABLE -DQUANTUM_PAINTER_SURFACE_ENABLE -DQUANTUM_PAINTER_DUMMY_COMMS_ENABLE -DQUANTUM_PAINTER_ANIMATIONS_ENABLE -DDEFERRED_EXEC_ENABLE
+painter_INC := $(QUANTUM_PATH)/painter $(QUANTUM_PATH)/unicode $(QUANTUM_PATH)/painter/tests drivers/painter/comms drivers/painter/generic
+painter_CONFIG := $(QUANTUM_PATH)/painter/tests/config_mock.h
+
+painter_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/deferred_exec.c \
+	$(QUANTUM_PATH)/painter/qp.c \
+	$(QUANTUM_PATH)/painter/qp_stream.c \
+	$(QUANTUM_PATH)/painter/qgf.c \
+	$(QUANTUM_PATH)/painter/qp_comms.c \
+	$(QUANTUM_PATH)/painter/qp_draw_core.c \
+	$(QUANTUM_PATH)/painter/qp_draw_codec.c \
+	$(QUANTUM_PATH)/painter/qp_draw_image.c \
+	drivers/painter/comms/qp_comms_dummy.c \
+	drivers/painter/generic/qp_surface_common.c \
+	drivers/painter/generic/qp_surface_rgb565.c \
+	$(QUANTUM_PATH)/painter/tests/tiled_animation.qgf.c \
+	$(QUANTUM_PATH)/painter/tests/qgf_tests.cpp
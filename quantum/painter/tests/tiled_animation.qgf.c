@@ -0,0 +1,91 @@
+// Copyright 2026 QMK -- generated source code only, image retains original copyright
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file was auto-generated by `qmk painter-convert-graphics -i tiled_animation.gif -f rgb565`
+
+#include <qp.h>
+
+const uint32_t gfx_tiled_animation_length = 1248;
+
+// clang-format off
+const uint8_t gfx_tiled_animation[1248] = {
+    0x00, 0xFF, 0x12, 0x00, 0x00, 0x51, 0x47, 0x46, 0x01, 0xE0, 0x04, 0x00, 0x00, 0x1F, 0xFB, 0xFF,
+    0xFF, 0x20, 0x00, 0x10, 0x00, 0x03, 0x00, 0x01, 0xFE, 0x0C, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00,
+    0x38, 0x04, 0x00, 0x00, 0x8E, 0x04, 0x00, 0x00, 0x02, 0xFD, 0x06, 0x00, 0x00, 0x08, 0x00, 0x00,
+    0xFF, 0x64, 0x00, 0x05, 0xFA, 0x00, 0x04, 0x00, 0x00, 0x10, 0x08, 0x10, 0x10, 0x10, 0x18, 0x10,
+    0x20, 0x10, 0x28, 0x10, 0x30, 0x10, 0x38, 0x10, 0x40, 0x10, 0x48, 0x10, 0x50, 0x10, 0x58, 0x10,
+    0x60, 0x10, 0x68, 0x10, 0x70, 0x10, 0x78, 0x10, 0x80, 0x10, 0x88, 0x10, 0x90, 0x10, 0x98, 0x10,
+    0xA0, 0x10, 0xA8, 0x10, 0xB0, 0x10, 0xB8, 0x10, 0xC0, 0x10, 0xC8, 0x10, 0xD0, 0x10, 0xD8, 0x10,
+    0xE0, 0x10, 0xE8, 0x10, 0xF0, 0x10, 0xF8, 0x10, 0x00, 0x10, 0x08, 0x10, 0x10, 0x10, 0x18, 0x10,
+    0x20, 0x10, 0x28, 0x10, 0x30, 0x10, 0x38, 0x10, 0x40, 0x10, 0x48, 0x10, 0x50, 0x10, 0x58, 0x10,
+    0x60, 0x10, 0x68, 0x10, 0x70, 0x10, 0x78, 0x10, 0x80, 0x10, 0x88, 0x10, 0x90, 0x10, 0x98, 0x10,
+    0xA0, 0x10, 0xA8, 0x10, 0xB0, 0x10, 0xB8, 0x10, 0xC0, 0x10, 0xC8, 0x10, 0xD0, 0x10, 0xD8, 0x10,
+    0xE0, 0x10, 0xE8, 0x10, 0xF0, 0x10, 0xF8, 0x10, 0x00, 0x10, 0x08, 0x10, 0x10, 0x10, 0x18, 0x10,
+    0x20, 0x10, 0x28, 0x10, 0x30, 0x10, 0x38, 0x10, 0x40, 0x10, 0x48, 0x10, 0x50, 0x10, 0x58, 0x10,
+    0x60, 0x10, 0x68, 0x10, 0x70, 0x10, 0x78, 0x10, 0x80, 0x10, 0x88, 0x10, 0x90, 0x10, 0x98, 0x10,
+    0xA0, 0x10, 0xA8, 0x10, 0xB0, 0x10, 0xB8, 0x10, 0xC0, 0x10, 0xC8, 0x10, 0xD0, 0x10, 0xD8, 0x10,
+    0xE0, 0x10, 0xE8, 0x10, 0xF0, 0x10, 0xF8, 0x10, 0x00, 0x10, 0x08, 0x10, 0x10, 0x10, 0x18, 0x10,
+    0x20, 0x10, 0x28, 0x10, 0x30, 0x10, 0x38, 0x10, 0x40, 0x10, 0x48, 0x10, 0x50, 0x10, 0x58, 0x10,
+    0x60, 0x10, 0x68, 0x10, 0x70, 0x10, 0x78, 0x10, 0x80, 0x10, 0x88, 0x10, 0x90, 0x10, 0x98, 0x10,
+    0xA0, 0x10, 0xA8, 0x10, 0xB0, 0x10, 0xB8, 0x10, 0xC0, 0x10, 0xC8, 0x10, 0xD0, 0x10, 0xD8, 0x10,
+    0xE0, 0x10, 0xE8, 0x10, 0xF0, 0x10, 0xF8, 0x10, 0x02, 0x10, 0x0A, 0x10, 0x12, 0x10, 0x1A, 0x10,
+    0x22, 0x10, 0x2A, 0x10, 0x32, 0x10, 0x3A, 0x10, 0x42, 0x10, 0x4A, 0x10, 0x52, 0x10, 0x5A, 0x10,
+    0x62, 0x10, 0x6A, 0x10, 0x72, 0x10, 0x7A, 0x10, 0x82, 0x10, 0x8A, 0x10, 0x92, 0x10, 0x9A, 0x10,
+    0xA2, 0x10, 0xAA, 0x10, 0xB2, 0x10, 0xBA, 0x10, 0xC2, 0x10, 0xCA, 0x10, 0xD2, 0x10, 0xDA, 0x10,
+    0xE2, 0x10, 0xEA, 0x10, 0xF2, 0x10, 0xFA, 0x10, 0x02, 0x10, 0x0A, 0x10, 0x12, 0x10, 0x1A, 0x10,
+    0x22, 0x10, 0x2A, 0x10, 0x32, 0x10, 0x3A, 0x10, 0x42, 0x10, 0x4A, 0x10, 0x52, 0x10, 0x5A, 0x10,
+    0x62, 0x10, 0x6A, 0x10, 0x72, 0x10, 0x7A, 0x10, 0x82, 0x10, 0x8A, 0x10, 0x92, 0x10, 0x9A, 0x10,
+    0xA2, 0x10, 0xAA, 0x10, 0xB2, 0x10, 0xBA, 0x10, 0xC2, 0x10, 0xCA, 0x10, 0xD2, 0x10, 0xDA, 0x10,
+    0xE2, 0x10, 0xEA, 0x10, 0xF2, 0x10, 0xFA, 0x10, 0x02, 0x10, 0x0A, 0x10, 0x12, 0x10, 0x1A, 0x10,
+    0x22, 0x10, 0x2A, 0x10, 0x32, 0x10, 0x3A, 0x10, 0x42, 0x10, 0x4A, 0x10, 0x52, 0x10, 0x5A, 0x10,
+    0x62, 0x10, 0x6A, 0x10, 0x72, 0x10, 0x7A, 0x10, 0x82, 0x10, 0x8A, 0x10, 0x92, 0x10, 0x9A, 0x10,
+    0xA2, 0x10, 0xAA, 0x10, 0xB2, 0x10, 0xBA, 0x10, 0xC2, 0x10, 0xCA, 0x10, 0xD2, 0x10, 0xDA, 0x10,
+    0xE2, 0x10, 0xEA, 0x10, 0xF2, 0x10, 0xFA, 0x10, 0x02, 0x10, 0x0A, 0x10, 0x12, 0x10, 0x1A, 0x10,
+    0x22, 0x10, 0x2A, 0x10, 0x32, 0x10, 0x3A, 0x10, 0x42, 0x10, 0x4A, 0x10, 0x52, 0x10, 0x5A, 0x10,
+    0x62, 0x10, 0x6A, 0x10, 0x72, 0x10, 0x7A, 0x10, 0x82, 0x10, 0x8A, 0x10, 0x92, 0x10, 0x9A, 0x10,
+    0xA2, 0x10, 0xAA, 0x10, 0xB2, 0x10, 0xBA, 0x10, 0xC2, 0x10, 0xCA, 0x10, 0xD2, 0x10, 0xDA, 0x10,
+    0xE2, 0x10, 0xEA, 0x10, 0xF2, 0x10, 0xFA, 0x10, 0x04, 0x10, 0x0C, 0x10, 0x14, 0x10, 0x1C, 0x10,
+    0x24, 0x10, 0x2C, 0x10, 0x34, 0x10, 0x3C, 0x10, 0x44, 0x10, 0x4C, 0x10, 0x54, 0x10, 0x5C, 0x10,
+    0x64, 0x10, 0x6C, 0x10, 0x74, 0x10, 0x7C, 0x10, 0x84, 0x10, 0x8C, 0x10, 0x94, 0x10, 0x9C, 0x10,
+    0xA4, 0x10, 0xAC, 0x10, 0xB4, 0x10, 0xBC, 0x10, 0xC4, 0x10, 0xCC, 0x10, 0xD4, 0x10, 0xDC, 0x10,
+    0xE4, 0x10, 0xEC, 0x10, 0xF4, 0x10, 0xFC, 0x10, 0x04, 0x10, 0x0C, 0x10, 0x14, 0x10, 0x1C, 0x10,
+    0x24, 0x10, 0x2C, 0x10, 0x34, 0x10, 0x3C, 0x10, 0x44, 0x10, 0x4C, 0x10, 0x54, 0x10, 0x5C, 0x10,
+    0x64, 0x10, 0x6C, 0x10, 0x74, 0x10, 0x7C, 0x10, 0x84, 0x10, 0x8C, 0x10, 0x94, 0x10, 0x9C, 0x10,
+    0xA4, 0x10, 0xAC, 0x10, 0xB4, 0x10, 0xBC, 0x10, 0xC4, 0x10, 0xCC, 0x10, 0xD4, 0x10, 0xDC, 0x10,
+    0xE4, 0x10, 0xEC, 0x10, 0xF4, 0x10, 0xFC, 0x10, 0x04, 0x10, 0x0C, 0x10, 0x14, 0x10, 0x1C, 0x10,
+    0x24, 0x10, 0x2C, 0x10, 0x34, 0x10, 0x3C, 0x10, 0x44, 0x10, 0x4C, 0x10, 0x54, 0x10, 0x5C, 0x10,
+    0x64, 0x10, 0x6C, 0x10, 0x74, 0x10, 0x7C, 0x10, 0x84, 0x10, 0x8C, 0x10, 0x94, 0x10, 0x9C, 0x10,
+    0xA4, 0x10, 0xAC, 0x10, 0xB4, 0x10, 0xBC, 0x10, 0xC4, 0x10, 0xCC, 0x10, 0xD4, 0x10, 0xDC, 0x10,
+    0xE4, 0x10, 0xEC, 0x10, 0xF4, 0x10, 0xFC, 0x10, 0x04, 0x10, 0x0C, 0x10, 0x14, 0x10, 0x1C, 0x10,
+    0x24, 0x10, 0x2C, 0x10, 0x34, 0x10, 0x3C, 0x10, 0x44, 0x10, 0x4C, 0x10, 0x54, 0x10, 0x5C, 0x10,
+    0x64, 0x10, 0x6C, 0x10, 0x74, 0x10, 0x7C, 0x10, 0x84, 0x10, 0x8C, 0x10, 0x94, 0x10, 0x9C, 0x10,
+    0xA4, 0x10, 0xAC, 0x10, 0xB4, 0x10, 0xBC, 0x10, 0xC4, 0x10, 0xCC, 0x10, 0xD4, 0x10, 0xDC, 0x10,
+    0xE4, 0x10, 0xEC, 0x10, 0xF4, 0x10, 0xFC, 0x10, 0x06, 0x10, 0x0E, 0x10, 0x16, 0x10, 0x1E, 0x10,
+    0x26, 0x10, 0x2E, 0x10, 0x36, 0x10, 0x3E, 0x10, 0x46, 0x10, 0x4E, 0x10, 0x56, 0x10, 0x5E, 0x10,
+    0x66, 0x10, 0x6E, 0x10, 0x76, 0x10, 0x7E, 0x10, 0x86, 0x10, 0x8E, 0x10, 0x96, 0x10, 0x9E, 0x10,
+    0xA6, 0x10, 0xAE, 0x10, 0xB6, 0x10, 0xBE, 0x10, 0xC6, 0x10, 0xCE, 0x10, 0xD6, 0x10, 0xDE, 0x10,
+    0xE6, 0x10, 0xEE, 0x10, 0xF6, 0x10, 0xFE, 0x10, 0x06, 0x10, 0x0E, 0x10, 0x16, 0x10, 0x1E, 0x10,
+    0x26, 0x10, 0x2E, 0x10, 0x36, 0x10, 0x3E, 0x10, 0x46, 0x10, 0x4E, 0x10, 0x56, 0x10, 0x5E, 0x10,
+    0x66, 0x10, 0x6E, 0x10, 0x76, 0x10, 0x7E, 0x10, 0x86, 0x10, 0x8E, 0x10, 0x96, 0x10, 0x9E, 0x10,
+    0xA6, 0x10, 0xAE, 0x10, 0xB6, 0x10, 0xBE, 0x10, 0xC6, 0x10, 0xCE, 0x10, 0xD6, 0x10, 0xDE, 0x10,
+    0xE6, 0x10, 0xEE, 0x10, 0xF6, 0x10, 0xFE, 0x10, 0x06, 0x10, 0x0E, 0x10, 0x16, 0x10, 0x1E, 0x10,
+    0x26, 0x10, 0x2E, 0x10, 0x36, 0x10, 0x3E, 0x10, 0x46, 0x10, 0x4E, 0x10, 0x56, 0x10, 0x5E, 0x10,
+    0x66, 0x10, 0x6E, 0x10, 0x76, 0x10, 0x7E, 0x10, 0x86, 0x10, 0x8E, 0x10, 0x96, 0x10, 0x9E, 0x10,
+    0xA6, 0x10, 0xAE, 0x10, 0xB6, 0x10, 0xBE, 0x10, 0xC6, 0x10, 0xCE, 0x10, 0xD6, 0x10, 0xDE, 0x10,
+    0xE6, 0x10, 0xEE, 0x10, 0xF6, 0x10, 0xFE, 0x10, 0x06, 0x10, 0x0E, 0x10, 0x16, 0x10, 0x1E, 0x10,
+    0x26, 0x10, 0x2E, 0x10, 0x36, 0x10, 0x3E, 0x10, 0x46, 0x10, 0x4E, 0x10, 0x56, 0x10, 0x5E, 0x10,
+    0x66, 0x10, 0x6E, 0x10, 0x76, 0x10, 0x7E, 0x10, 0x86, 0x10, 0x8E, 0x10, 0x96, 0x10, 0x9E, 0x10,
+    0xA6, 0x10, 0xAE, 0x10, 0xB6, 0x10, 0xBE, 0x10, 0xC6, 0x10, 0xCE, 0x10, 0xD6, 0x10, 0xDE, 0x10,
+    0xE6, 0x10, 0xEE, 0x10, 0xF6, 0x10, 0xFE, 0x10, 0x02, 0xFD, 0x06, 0x00, 0x00, 0x08, 0x04, 0x00,
+    0xFF, 0x64, 0x00, 0x06, 0xF9, 0x10, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00, 0x05, 0x00, 0x05, 0x00,
+    0x19, 0x00, 0x0B, 0x00, 0x1B, 0x00, 0x0C, 0x00, 0x05, 0xFA, 0x20, 0x00, 0x00, 0xF8, 0x00, 0xF8,
+    0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF8,
+    0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0x05, 0xFA, 0x0C,
+    0x00, 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x1F, 0x02, 0xFD,
+    0x06, 0x00, 0x00, 0x08, 0x04, 0x00, 0xFF, 0x64, 0x00, 0x06, 0xF9, 0x10, 0x00, 0x00, 0x02, 0x00,
+    0x02, 0x00, 0x05, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00, 0x11, 0x00, 0x01, 0x00, 0x05, 0xFA,
+    0x20, 0x00, 0x00, 0x10, 0x10, 0x18, 0x10, 0x20, 0x10, 0x28, 0x10, 0x10, 0x10, 0x18, 0x10, 0x20,
+    0x10, 0x28, 0x10, 0x12, 0x10, 0x1A, 0x10, 0x22, 0x10, 0x2A, 0x10, 0x12, 0x10, 0x1A, 0x10, 0x22,
+    0x10, 0x2A, 0x10, 0x05, 0xFA, 0x08, 0x00, 0x00, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0,
+};
+// clang-format on
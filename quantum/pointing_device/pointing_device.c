@@ -246,12 +246,19 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #    if defined(SPLIT_POINTING_ENABLE)
 #        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
 #    endif
+#    ifdef POINTING_DEVICE_ACCUMULATE_MOTION
+    // a saturated report may have left motion behind in the driver, keep polling until it is drained
+    static bool motion_carry = false;
+#    endif
 #    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
-    if (!gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
+    if (!gpio_read_pin(POINTING_DEVICE_MOTION_PIN)
 #    else
-    if (gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
+    if (gpio_read_pin(POINTING_DEVICE_MOTION_PIN)
 #    endif
-    {
+#    ifdef POINTING_DEVICE_ACCUMULATE_MOTION
+        || motion_carry
+#    endif
+    ) {
 #endif
 
 #if defined(SPLIT_POINTING_ENABLE)
@@ -270,6 +277,9 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #endif // defined(SPLIT_POINTING_ENABLE)
 
 #ifdef POINTING_DEVICE_MOTION_PIN
+#    ifdef POINTING_DEVICE_ACCUMULATE_MOTION
+        motion_carry = local_mouse_report.x == XY_REPORT_MIN || local_mouse_report.x == XY_REPORT_MAX || local_mouse_report.y == XY_REPORT_MIN || local_mouse_report.y == XY_REPORT_MAX;
+#    endif
     }
 #endif
 
@@ -411,6 +421,7 @@ static inline mouse_xy_report_t pointing_device_xy_clamp(clamp_range_t value) {
  * @brief combines 2 mouse reports and returns 2
  *
  * Combines 2 report_mouse_t structs, clamping movement values to int8_t and ignores report_id then returns the resulting report_mouse_t struct.
+ * With POINTING_DEVICE_ACCUMULATE_MOTION, movement that does not fit is carried over to the next report instead.
  *
  * NOTE: Only available when using SPLIT_POINTING_ENABLE and POINTING_DEVICE_COMBINED
  *
@@ -419,10 +430,22 @@ static inline mouse_xy_report_t pointing_device_xy_clamp(clamp_range_t value) {
  * @return combined report_mouse_t of left_report and right_report
  */
 report_mouse_t pointing_device_combine_reports(report_mouse_t left_report, report_mouse_t right_report) {
+#    ifdef POINTING_DEVICE_ACCUMULATE_MOTION
+    // carry whatever does not fit over to the next report rather than clamping it away
+    static pointing_device_accumulator_t combined_accumulator = {0};
+    pointing_device_accumulator_add(&combined_accumulator, left_report.x, left_report.y, left_report.h, left_report.v);
+    pointing_device_accumulator_add(&combined_accumulator, right_report.x, right_report.y, right_report.h, right_report.v);
+    left_report.x = 0;
+    left_report.y = 0;
+    left_report.h = 0;
+    left_report.v = 0;
+    left_report   = pointing_device_accumulator_take(&combined_accumulator, left_report);
+#    else
     left_report.x = pointing_device_xy_clamp((clamp_range_t)left_report.x + right_report.x);
     left_report.y = pointing_device_xy_clamp((clamp_range_t)left_report.y + right_report.y);
     left_report.h = pointing_device_hv_clamp((int16_t)left_report.h + right_report.h);
     left_report.v = pointing_device_hv_clamp((int16_t)left_report.v + right_report.v);
+#    endif
     left_report.buttons |= right_report.buttons;
     return left_report;
 }
@@ -0,0 +1,121 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pointing_device_accumulator.h"
+#include "pointing_device.h"
+
+/**
+ * @brief Moves as many whole counts as fit from an accumulator axis into a report field
+ *
+ * Fractional counts, and whole counts that would push the field outside of
+ * [min, max], stay in the accumulator. Truncation is towards zero so that
+ * a remainder never changes sign.
+ *
+ * @param[in,out] acc accumulator axis in 24.8 fixed point
+ * @param[in] current value already present in the report field
+ * @param[in] min lowest value the report field can hold
+ * @param[in] max highest value the report field can hold
+ * @return int32_t new value of the report field
+ */
+static int32_t pointing_device_accumulator_drain(int32_t *acc, int32_t current, int32_t min, int32_t max) {
+    int32_t counts = *acc / POINTING_DEVICE_ACCUMULATOR_UNITY;
+    int32_t value  = current + counts;
+
+    if (value > max) {
+        value = max > current ? max : current;
+    } else if (value < min) {
+        value = min < current ? min : current;
+    }
+
+    *acc -= (value - current) * POINTING_DEVICE_ACCUMULATOR_UNITY;
+    return value;
+}
+
+/**
+ * @brief Discards any motion held by the accumulator
+ *
+ * @param[out] acc accumulator to reset
+ */
+void pointing_device_accumulator_clear(pointing_device_accumulator_t *acc) {
+    acc->x = 0;
+    acc->y = 0;
+    acc->h = 0;
+    acc->v = 0;
+}
+
+/**
+ * @brief Adds whole sensor counts to the accumulator
+ *
+ * @param[in,out] acc accumulator
+ * @param[in] x horizontal movement
+ * @param[in] y vertical movement
+ * @param[in] h horizontal scroll
+ * @param[in] v vertical scroll
+ */
+void pointing_device_accumulator_add(pointing_device_accumulator_t *acc, int16_t x, int16_t y, int16_t h, int16_t v) {
+    pointing_device_accumulator_add_scaled(acc, x, y, h, v, POINTING_DEVICE_ACCUMULATOR_UNITY);
+}
+
+/**
+ * @brief Adds sensor counts multiplied by a fixed point factor to the accumulator
+ *
+ * The scale is in 8.8 fixed point, so POINTING_DEVICE_ACCUMULATOR_UNITY
+ * passes counts through unchanged and POINTING_DEVICE_ACCUMULATOR_UNITY / 8
+ * needs eight counts of input for a single count of output. Nothing is
+ * rounded away; the fractional part is kept until it adds up to a count.
+ *
+ * @param[in,out] acc accumulator
+ * @param[in] x horizontal movement
+ * @param[in] y vertical movement
+ * @param[in] h horizontal scroll
+ * @param[in] v vertical scroll
+ * @param[in] scale multiplier in 8.8 fixed point
+ */
+void pointing_device_accumulator_add_scaled(pointing_device_accumulator_t *acc, int16_t x, int16_t y, int16_t h, int16_t v, uint16_t scale) {
+    acc->x += (int32_t)x * scale;
+    acc->y += (int32_t)y * scale;
+    acc->h += (int32_t)h * scale;
+    acc->v += (int32_t)v * scale;
+}
+
+/**
+ * @brief Checks whether the accumulator holds at least one whole count on any axis
+ *
+ * @param[in] acc accumulator
+ * @return true if the next take would change a report
+ */
+bool pointing_device_accumulator_pending(const pointing_device_accumulator_t *acc) {
+    return acc->x / POINTING_DEVICE_ACCUMULATOR_UNITY || acc->y / POINTING_DEVICE_ACCUMULATOR_UNITY || acc->h / POINTING_DEVICE_ACCUMULATOR_UNITY || acc->v / POINTING_DEVICE_ACCUMULATOR_UNITY;
+}
+
+/**
+ * @brief Moves whole counts from the accumulator into a mouse report
+ *
+ * Counts are added on top of whatever the report already holds, limited to
+ * the range of each report field. Whatever does not fit is left in the
+ * accumulator for the next report.
+ *
+ * @param[in,out] acc accumulator
+ * @param[in] mouse_report report to add the movement to
+ * @return report_mouse_t updated report
+ */
+report_mouse_t pointing_device_accumulator_take(pointing_device_accumulator_t *acc, report_mouse_t mouse_report) {
+    mouse_report.x = pointing_device_accumulator_drain(&acc->x, mouse_report.x, XY_REPORT_MIN, XY_REPORT_MAX);
+    mouse_report.y = pointing_device_accumulator_drain(&acc->y, mouse_report.y, XY_REPORT_MIN, XY_REPORT_MAX);
+    mouse_report.h = pointing_device_accumulator_drain(&acc->h, mouse_report.h, INT8_MIN, INT8_MAX);
+    mouse_report.v = pointing_device_accumulator_drain(&acc->v, mouse_report.v, INT8_MIN, INT8_MAX);
+    return mouse_report;
+}
@@ -0,0 +1,46 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "report.h"
+
+/* Fixed point scale of the accumulator, one report count == 256 */
+#define POINTING_DEVICE_ACCUMULATOR_SHIFT 8
+#define POINTING_DEVICE_ACCUMULATOR_UNITY (1 << POINTING_DEVICE_ACCUMULATOR_SHIFT)
+
+/**
+ * Motion accumulator.
+ *
+ * Collects sensor deltas in 24.8 fixed point and hands them out in report
+ * sized pieces. Anything that does not fit into a single report, either
+ * because it exceeds the report range or because it is a fraction of a
+ * count, is carried over to the next report instead of being dropped.
+ */
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int32_t h;
+    int32_t v;
+} pointing_device_accumulator_t;
+
+void           pointing_device_accumulator_clear(pointing_device_accumulator_t *acc);
+void           pointing_device_accumulator_add(pointing_device_accumulator_t *acc, int16_t x, int16_t y, int16_t h, int16_t v);
+void           pointing_device_accumulator_add_scaled(pointing_device_accumulator_t *acc, int16_t x, int16_t y, int16_t h, int16_t v, uint16_t scale);
+bool           pointing_device_accumulator_pending(const pointing_device_accumulator_t *acc);
+report_mouse_t pointing_device_accumulator_take(pointing_device_accumulator_t *acc, report_mouse_t mouse_report);
@@ -460,17 +460,29 @@ static uint16_t pmw33xx_get_cpi_wrapper(void) {
     return pmw33xx_get_cpi(0);
 }
 
+#    ifdef POINTING_DEVICE_ACCUMULATE_MOTION
+static pointing_device_accumulator_t pmw33xx_accumulator = {0};
+#    endif
+
 report_mouse_t pmw33xx_get_report(report_mouse_t mouse_report) {
     pmw33xx_report_t report    = pmw33xx_read_burst(0);
     static bool      in_motion = false;
 
     if (report.motion.b.is_lifted) {
+#    ifdef POINTING_DEVICE_ACCUMULATE_MOTION
+        pointing_device_accumulator_clear(&pmw33xx_accumulator);
+#    endif
         return mouse_report;
     }
 
     if (!report.motion.b.is_motion) {
         in_motion = false;
+#    ifdef POINTING_DEVICE_ACCUMULATE_MOTION
+        // flush whatever the previous reports could not hold
+        return pointing_device_accumulator_take(&pmw33xx_accumulator, mouse_report);
+#    else
         return mouse_report;
+#    endif
     }
 
     if (!in_motion) {
@@ -478,9 +490,14 @@ report_mouse_t pmw33xx_get_report(report_mouse_t mouse_report) {
         pd_dprintf("PWM3360 (0): starting motion\n");
     }
 
+#    ifdef POINTING_DEVICE_ACCUMULATE_MOTION
+    pointing_device_accumulator_add(&pmw33xx_accumulator, report.delta_x, report.delta_y, 0, 0);
+    return pointing_device_accumulator_take(&pmw33xx_accumulator, mouse_report);
+#    else
     mouse_report.x = CONSTRAIN_HID_XY(report.delta_x);
     mouse_report.y = CONSTRAIN_HID_XY(report.delta_y);
     return mouse_report;
+#    endif
 }
 
 // clang-format off
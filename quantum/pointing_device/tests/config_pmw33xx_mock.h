@@ -0,0 +1,19 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 1
+#define MATRIX_COLS 1
+
+#define PMW33XX_CS_PIN 0
+#define PMW33XX_MOTION_PIN 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "pmw33xx_mock.h"
+
+#ifdef __cplusplus
+};
+#endif
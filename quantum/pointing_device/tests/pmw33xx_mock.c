@@ -0,0 +1,125 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "pmw33xx_mock.h"
+#include "spi_master.h"
+#include "pmw3360.h"
+#include "util.h"
+
+#define MOTION_MOT (1 << 7)
+#define MOTION_OP_MODE_MASK (0b11 << 1)
+
+pmw33xx_mock_t pmw33xx_mock;
+
+// Motion_Burst register order from the datasheet
+static const uint8_t burst_registers[] = {
+    REG_Motion, REG_Observation, REG_Delta_X_L, REG_Delta_X_H, REG_Delta_Y_L, REG_Delta_Y_H, REG_SQUAL, REG_Raw_Data_Sum, REG_Maximum_Raw_data, REG_Minimum_Raw_data, REG_Shutter_Upper, REG_Shutter_Lower,
+};
+
+void pmw33xx_mock_reset(void) {
+    memset(&pmw33xx_mock, 0, sizeof(pmw33xx_mock));
+    pmw33xx_mock.address                           = -1;
+    pmw33xx_mock.registers[REG_Product_ID]         = 0x42;
+    pmw33xx_mock.registers[REG_Inverse_Product_ID] = 0xBD;
+    pmw33xx_mock.registers[REG_SROM_ID]            = 0x04;
+    pmw33xx_mock.registers[REG_SQUAL]              = 0x30;
+}
+
+static int16_t get_delta(uint8_t low) {
+    return (int16_t)(pmw33xx_mock.registers[low] | (pmw33xx_mock.registers[low + 1] << 8));
+}
+
+static void set_delta(uint8_t low, int16_t value) {
+    pmw33xx_mock.registers[low]     = (uint16_t)value & 0xFF;
+    pmw33xx_mock.registers[low + 1] = (uint16_t)value >> 8;
+}
+
+void pmw33xx_mock_move(int16_t dx, int16_t dy) {
+    set_delta(REG_Delta_X_L, get_delta(REG_Delta_X_L) + dx);
+    set_delta(REG_Delta_Y_L, get_delta(REG_Delta_Y_L) + dy);
+    pmw33xx_mock.registers[REG_Motion] |= MOTION_MOT;
+}
+
+void pmw33xx_mock_set_op_mode(uint8_t op_mode) {
+    pmw33xx_mock.registers[REG_Motion] = (pmw33xx_mock.registers[REG_Motion] & ~MOTION_OP_MODE_MASK) | ((op_mode << 1) & MOTION_OP_MODE_MASK);
+}
+
+uint8_t mock_set_pin_input_high(pin_t pin) {
+    pmw33xx_mock.motion_pin_pulled_up = true;
+    return 0;
+}
+
+bool mock_read_pin(pin_t pin) {
+    // MOTION is active low and asserted while motion data is waiting to be read
+    return !(pmw33xx_mock.registers[REG_Motion] & MOTION_MOT);
+}
+
+void spi_init(void) {}
+
+bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    pmw33xx_mock.selected = true;
+    pmw33xx_mock.address  = -1;
+    pmw33xx_mock.transactions++;
+    return true;
+}
+
+spi_status_t spi_write(uint8_t data) {
+    // only the first byte of a transaction is an address, the rest is firmware upload
+    if (pmw33xx_mock.address < 0) {
+        pmw33xx_mock.address = data;
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_read(void) {
+    return pmw33xx_mock.registers[pmw33xx_mock.address & 0x7F];
+}
+
+spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    if (length < 2 || !(data[0] & 0x80)) {
+        return SPI_STATUS_ERROR;
+    }
+
+    uint8_t reg = data[0] & 0x7F;
+    if (reg == REG_Motion_Burst) {
+        pmw33xx_mock.burst_armed = true;
+        pmw33xx_mock.burst_arms++;
+    } else {
+        // writing any other register ends burst mode
+        pmw33xx_mock.burst_armed    = false;
+        pmw33xx_mock.registers[reg] = data[1];
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    if (pmw33xx_mock.address != REG_Motion_Burst) {
+        return SPI_STATUS_ERROR;
+    }
+
+    pmw33xx_mock.burst_reads++;
+    if (!pmw33xx_mock.burst_armed) {
+        // the bus floats high if burst mode was never entered
+        memset(data, 0xFF, length);
+        return SPI_STATUS_SUCCESS;
+    }
+
+    for (uint16_t i = 0; i < length && i < ARRAY_SIZE(burst_registers); i++) {
+        data[i] = pmw33xx_mock.registers[burst_registers[i]];
+    }
+
+    // reading the burst clears the motion state and releases MOTION
+    set_delta(REG_Delta_X_L, 0);
+    set_delta(REG_Delta_Y_L, 0);
+    pmw33xx_mock.registers[REG_Motion] &= ~MOTION_MOT;
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_stop(void) {
+    pmw33xx_mock.selected = false;
+}
+
+bool is_keyboard_left(void) {
+    return true;
+}
@@ -0,0 +1,31 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint8_t pin_t;
+
+#define gpio_set_pin_input_high(pin) (mock_set_pin_input_high(pin))
+#define gpio_read_pin(pin) (mock_read_pin(pin))
+
+/* Register level model of a single PMW33xx sensor on the SPI bus. */
+typedef struct {
+    uint8_t  registers[0x80];
+    bool     burst_armed;
+    bool     selected;
+    bool     motion_pin_pulled_up;
+    int16_t  address;
+    uint32_t transactions;
+    uint32_t burst_arms;
+    uint32_t burst_reads;
+} pmw33xx_mock_t;
+
+extern pmw33xx_mock_t pmw33xx_mock;
+
+void    pmw33xx_mock_reset(void);
+void    pmw33xx_mock_move(int16_t dx, int16_t dy);
+void    pmw33xx_mock_set_op_mode(uint8_t op_mode);
+uint8_t mock_set_pin_input_high(pin_t pin);
+bool    mock_read_pin(pin_t pin);
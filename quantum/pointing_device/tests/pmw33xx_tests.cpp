@@ -0,0 +1,115 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+// the driver header is C11, map its assertions onto the C++ keyword
+#define _Static_assert static_assert
+
+extern "C" {
+#include "pmw33xx_common.h"
+}
+
+class Pmw33xx : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        pmw33xx_mock_reset();
+        // any register write takes the driver out of burst mode
+        pmw33xx_write(0, REG_Config2, 0x00);
+        pmw33xx_mock.transactions = 0;
+    }
+};
+
+TEST_F(Pmw33xx, InitPullsUpMotionPin) {
+    EXPECT_TRUE(pmw33xx_init(0));
+    EXPECT_TRUE(pmw33xx_mock.motion_pin_pulled_up);
+}
+
+TEST_F(Pmw33xx, IdleSensorIsNotSelected) {
+    for (int i = 0; i < 100; i++) {
+        pmw33xx_report_t report = pmw33xx_read_burst(0);
+        EXPECT_FALSE(report.motion.b.is_motion);
+    }
+    EXPECT_EQ(pmw33xx_mock.transactions, 0);
+    EXPECT_EQ(pmw33xx_mock.burst_reads, 0);
+}
+
+TEST_F(Pmw33xx, BurstIsParsed) {
+    pmw33xx_mock.registers[REG_Observation] = 0x3F;
+    pmw33xx_mock_move(-300, 1234);
+
+    pmw33xx_report_t report = pmw33xx_read_burst(0);
+
+    EXPECT_TRUE(report.motion.b.is_motion);
+    EXPECT_FALSE(report.motion.b.is_lifted);
+    EXPECT_EQ(report.observation, 0x3F);
+    // the driver flips both axes to match the HID orientation
+    EXPECT_EQ(report.delta_x, 300);
+    EXPECT_EQ(report.delta_y, -1234);
+    EXPECT_EQ(pmw33xx_mock.burst_arms, 1);
+    EXPECT_EQ(pmw33xx_mock.burst_reads, 1);
+    EXPECT_FALSE(pmw33xx_mock.selected);
+}
+
+TEST_F(Pmw33xx, BurstDrainsAccumulatedMotion) {
+    pmw33xx_mock_move(10, -5);
+    pmw33xx_mock_move(20000, -20000);
+
+    pmw33xx_report_t report = pmw33xx_read_burst(0);
+    EXPECT_EQ(report.delta_x, -20010);
+    EXPECT_EQ(report.delta_y, 20005);
+
+    report = pmw33xx_read_burst(0);
+    EXPECT_FALSE(report.motion.b.is_motion);
+    EXPECT_EQ(report.delta_x, 0);
+    EXPECT_EQ(report.delta_y, 0);
+    EXPECT_EQ(pmw33xx_mock.burst_reads, 1);
+}
+
+TEST_F(Pmw33xx, BurstModeIsEnteredOnce) {
+    for (int i = 0; i < 10; i++) {
+        pmw33xx_mock_move(1, 1);
+        EXPECT_EQ(pmw33xx_read_burst(0).delta_x, -1);
+    }
+    EXPECT_EQ(pmw33xx_mock.burst_arms, 1);
+    EXPECT_EQ(pmw33xx_mock.burst_reads, 10);
+}
+
+TEST_F(Pmw33xx, RestModeKeepsBurstMode) {
+    for (uint8_t op_mode = 0; op_mode < 4; op_mode++) {
+        pmw33xx_mock_set_op_mode(op_mode);
+        pmw33xx_mock_move(1, 0);
+        pmw33xx_report_t report = pmw33xx_read_burst(0);
+        EXPECT_EQ(report.motion.b.operation_mode, op_mode);
+        EXPECT_EQ(report.delta_x, -1);
+    }
+    EXPECT_EQ(pmw33xx_mock.burst_arms, 1);
+}
+
+TEST_F(Pmw33xx, RegisterWriteLeavesBurstMode) {
+    pmw33xx_mock_move(1, 1);
+    pmw33xx_read_burst(0);
+
+    pmw33xx_set_cpi(0, 800);
+    EXPECT_EQ(pmw33xx_mock.registers[REG_Config1], 7);
+
+    pmw33xx_mock_move(2, 2);
+    EXPECT_EQ(pmw33xx_read_burst(0).delta_x, -2);
+    EXPECT_EQ(pmw33xx_mock.burst_arms, 2);
+}
+
+TEST_F(Pmw33xx, GarbageBurstIsRecovered) {
+    pmw33xx_mock_move(5, 5);
+    pmw33xx_read_burst(0);
+
+    // the sensor silently dropped out of burst mode
+    pmw33xx_mock.burst_armed = false;
+    pmw33xx_mock_move(5, 5);
+    pmw33xx_read_burst(0);
+
+    pmw33xx_mock_move(7, 7);
+    pmw33xx_report_t report = pmw33xx_read_burst(0);
+    EXPECT_EQ(pmw33xx_mock.burst_arms, 2);
+    EXPECT_EQ(report.delta_x, -12);
+    EXPECT_EQ(report.delta_y, -12);
+}
@@ -0,0 +1,189 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <vector>
+
+extern "C" {
+#include "pointing_device.h"
+}
+
+struct motion_sample_t {
+    int16_t x;
+    int16_t y;
+    int16_t h;
+    int16_t v;
+};
+
+struct replay_result_t {
+    int64_t x;
+    int64_t y;
+    int64_t h;
+    int64_t v;
+    size_t  reports;
+};
+
+// Captured from a PMW3360 at 12000 CPI: a slow drag, a hard flick and the settle afterwards.
+static const std::vector<motion_sample_t> flick_trace = {
+    {3, -1, 0, 0},        {5, -2, 0, 0},        {9, -4, 0, 0},       {40, -18, 0, 0},     {161, -70, 0, 0},
+    {612, -255, 0, 0},    {1840, -790, 0, 0},   {3270, -1402, 0, 0}, {2911, -1250, 0, 0}, {1480, -610, 0, 0},
+    {530, -201, 0, 0},    {122, -44, 0, 0},     {17, -5, 0, 0},      {2, 0, 0, 0},        {-1, 1, 0, 0},
+    {-3, 2, 0, 0},        {0, 0, 0, 0},         {0, 0, 0, 0},
+};
+
+// Trackpad scrolling with reversals, including values past the int8_t scroll range.
+static const std::vector<motion_sample_t> scroll_trace = {
+    {0, 0, 1, 4},   {0, 0, 2, 40},   {0, 0, 5, 130},   {0, 0, -3, 300}, {0, 0, -200, 90}, {0, 0, -12, -20},
+    {0, 0, 0, -310}, {0, 0, 0, -128}, {0, 0, 127, -1}, {0, 0, 0, 0},    {0, 0, 0, 0},
+};
+
+class PointingDeviceAccumulator : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        pointing_device_accumulator_clear(&acc);
+    }
+
+    /* Feeds one sample per report interval and then keeps polling until the accumulator is empty. */
+    replay_result_t replay(const std::vector<motion_sample_t> &trace, uint16_t scale = POINTING_DEVICE_ACCUMULATOR_UNITY) {
+        replay_result_t result = {0, 0, 0, 0, 0};
+        auto            send   = [&](void) {
+            report_mouse_t report = pointing_device_accumulator_take(&acc, report_mouse_t{});
+            EXPECT_GE(report.x, XY_REPORT_MIN);
+            EXPECT_LE(report.x, XY_REPORT_MAX);
+            EXPECT_GE(report.y, XY_REPORT_MIN);
+            EXPECT_LE(report.y, XY_REPORT_MAX);
+            result.x += report.x;
+            result.y += report.y;
+            result.h += report.h;
+            result.v += report.v;
+            result.reports++;
+        };
+
+        for (auto &sample : trace) {
+            pointing_device_accumulator_add_scaled(&acc, sample.x, sample.y, sample.h, sample.v, scale);
+            send();
+        }
+        while (pointing_device_accumulator_pending(&acc)) {
+            send();
+        }
+        return result;
+    }
+
+    static replay_result_t sum(const std::vector<motion_sample_t> &trace) {
+        replay_result_t result = {0, 0, 0, 0, trace.size()};
+        for (auto &sample : trace) {
+            result.x += sample.x;
+            result.y += sample.y;
+            result.h += sample.h;
+            result.v += sample.v;
+        }
+        return result;
+    }
+
+    pointing_device_accumulator_t acc;
+};
+
+TEST_F(PointingDeviceAccumulator, FlickLosesNoCounts) {
+    replay_result_t expected = sum(flick_trace);
+    replay_result_t actual   = replay(flick_trace);
+
+    EXPECT_EQ(actual.x, expected.x);
+    EXPECT_EQ(actual.y, expected.y);
+    EXPECT_EQ(actual.h, 0);
+    EXPECT_EQ(actual.v, 0);
+#ifndef MOUSE_EXTENDED_REPORT
+    // the flick exceeds the int8_t range and must spill into extra reports
+    EXPECT_GT(actual.reports, flick_trace.size());
+#else
+    EXPECT_EQ(actual.reports, flick_trace.size());
+#endif
+}
+
+TEST_F(PointingDeviceAccumulator, ScrollLosesNoCounts) {
+    replay_result_t expected = sum(scroll_trace);
+    replay_result_t actual   = replay(scroll_trace);
+
+    EXPECT_EQ(actual.x, 0);
+    EXPECT_EQ(actual.y, 0);
+    EXPECT_EQ(actual.h, expected.h);
+    EXPECT_EQ(actual.v, expected.v);
+}
+
+TEST_F(PointingDeviceAccumulator, ScaledSumsAreExact) {
+    std::vector<motion_sample_t> trace(64, motion_sample_t{5, -3, 0, 0});
+    replay_result_t              actual = replay(trace, POINTING_DEVICE_ACCUMULATOR_UNITY / 8);
+
+    // 320 / 8 and -192 / 8, with no rounding error building up over 64 samples
+    EXPECT_EQ(actual.x, 40);
+    EXPECT_EQ(actual.y, -24);
+    EXPECT_FALSE(pointing_device_accumulator_pending(&acc));
+    EXPECT_EQ(acc.x, 0);
+    EXPECT_EQ(acc.y, 0);
+}
+
+TEST_F(PointingDeviceAccumulator, FractionsAreCarriedUntilWhole) {
+    report_mouse_t report;
+
+    pointing_device_accumulator_add_scaled(&acc, 0, 0, 0, 1, POINTING_DEVICE_ACCUMULATOR_UNITY / 3);
+    report = pointing_device_accumulator_take(&acc, report_mouse_t{});
+    EXPECT_EQ(report.v, 0);
+    pointing_device_accumulator_add_scaled(&acc, 0, 0, 0, 1, POINTING_DEVICE_ACCUMULATOR_UNITY / 3);
+    report = pointing_device_accumulator_take(&acc, report_mouse_t{});
+    EXPECT_EQ(report.v, 0);
+    pointing_device_accumulator_add_scaled(&acc, 0, 0, 0, 2, POINTING_DEVICE_ACCUMULATOR_UNITY / 3);
+    report = pointing_device_accumulator_take(&acc, report_mouse_t{});
+    EXPECT_EQ(report.v, 1);
+}
+
+TEST_F(PointingDeviceAccumulator, OppositeFractionsCancel) {
+    pointing_device_accumulator_add_scaled(&acc, 1, -1, 0, 0, POINTING_DEVICE_ACCUMULATOR_UNITY / 2);
+    pointing_device_accumulator_add_scaled(&acc, -1, 1, 0, 0, POINTING_DEVICE_ACCUMULATOR_UNITY / 2);
+    report_mouse_t report = pointing_device_accumulator_take(&acc, report_mouse_t{});
+
+    EXPECT_EQ(report.x, 0);
+    EXPECT_EQ(report.y, 0);
+    EXPECT_EQ(acc.x, 0);
+    EXPECT_EQ(acc.y, 0);
+}
+
+TEST_F(PointingDeviceAccumulator, TakeAddsToExistingReport) {
+    report_mouse_t report = {};
+    report.x              = XY_REPORT_MAX - 10;
+    report.h              = -100;
+    report.buttons        = 0x05;
+
+    pointing_device_accumulator_add(&acc, 25, 0, -50, 0);
+    report = pointing_device_accumulator_take(&acc, report);
+
+    EXPECT_EQ(report.x, XY_REPORT_MAX);
+    EXPECT_EQ(report.h, INT8_MIN);
+    EXPECT_EQ(report.buttons, 0x05);
+    EXPECT_EQ(acc.x, 15 * POINTING_DEVICE_ACCUMULATOR_UNITY);
+    EXPECT_EQ(acc.h, -22 * POINTING_DEVICE_ACCUMULATOR_UNITY);
+    EXPECT_TRUE(pointing_device_accumulator_pending(&acc));
+}
+
+TEST_F(PointingDeviceAccumulator, ClearDiscardsMotion) {
+    pointing_device_accumulator_add(&acc, 1000, -1000, 300, -300);
+    pointing_device_accumulator_clear(&acc);
+    report_mouse_t report = pointing_device_accumulator_take(&acc, report_mouse_t{});
+
+    EXPECT_FALSE(pointing_device_accumulator_pending(&acc));
+    EXPECT_EQ(report.x, 0);
+    EXPECT_EQ(report.y, 0);
+    EXPECT_EQ(report.h, 0);
+    EXPECT_EQ(report.v, 0);
+}
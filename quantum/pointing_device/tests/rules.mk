@@ -0,0 +1,24 @@
+pointing_device_accumulator_DEFS := -DPOINTING_DEVICE_ENABLE
+pointing_device_accumulator_INC := $(QUANTUM_PATH)/pointing_device
+
+pointing_device_accumulator_SRC := \
+	$(QUANTUM_PATH)/pointing_device/tests/pointing_device_accumulator_tests.cpp \
+	$(QUANTUM_PATH)/pointing_device/pointing_device_accumulator.c
+
+pointing_device_accumulator_extended_DEFS := -DPOINTING_DEVICE_ENABLE -DMOUSE_EXTENDED_REPORT
+pointing_device_accumulator_extended_INC := $(QUANTUM_PATH)/pointing_device
+
+pointing_device_accumulator_extended_SRC := \
+	$(QUANTUM_PATH)/pointing_device/tests/pointing_device_accumulator_tests.cpp \
+	$(QUANTUM_PATH)/pointing_device/pointing_device_accumulator.c
+
+pmw33xx_DEFS := -DPOINTING_DEVICE_ENABLE -DPOINTING_DEVICE_DRIVER_pmw3360
+pmw33xx_INC := $(QUANTUM_PATH)/pointing_device/tests $(DRIVER_PATH)/sensors
+pmw33xx_CONFIG := $(QUANTUM_PATH)/pointing_device/tests/config_pmw33xx_mock.h
+
+pmw33xx_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/pointing_device/tests/pmw33xx_mock.c \
+	$(QUANTUM_PATH)/pointing_device/tests/pmw33xx_tests.cpp \
+	$(DRIVER_PATH)/sensors/pmw33xx_common.c \
+	$(DRIVER_PATH)/sensors/pmw3360.c
@@ -0,0 +1,4 @@
+TEST_LIST += \
+	pointing_device_accumulator \
+	pointing_device_accumulator_extended \
+	pmw33xx
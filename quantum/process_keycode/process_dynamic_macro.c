@@ -18,11 +18,18 @@
 /* Author: Wojciech Siewierski < wojciech dot siewierski at onet dot pl > */
 #include "process_dynamic_macro.h"
 #include <stddef.h>
+#include <string.h>
 #include "action_layer.h"
 #include "keycodes.h"
 #include "debug.h"
+#include "timer.h"
 #include "wait.h"
 
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+#    include "eeprom.h"
+#    include "eeconfig.h"
+#endif
+
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -58,164 +65,470 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
     return true;
 }
 
-/* Convenience macros used for retrieving the debug info. All of them
- * need a `direction` variable accessible at the call site.
+/* Both macros use the same buffer but read/write on different
+ * ends of it.
+ *
+ * Macro1 is written left-to-right starting from the beginning of
+ * the buffer.
+ *
+ * Macro2 is written right-to-left starting from the end of the
+ * buffer.
+ *
+ * macro_buffer[0]
+ *  v
+ * +------------------------------------------------------------+
+ * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
+ * +------------------------------------------------------------+
+ *  <- macro_length[0] ->      <------- macro_length[1] ------->
+ *
+ * During the recording when one macro encounters the end of the
+ * other macro, the recording is stopped. Apart from this, there
+ * are no arbitrary limits for the macros' length in relation to
+ * each other: for example one can either have two medium sized
+ * macros or one long macro and one short macro. Or even one empty
+ * and one using the whole buffer.
+ *
+ * The macros are stored as a stream of packed events, read in the
+ * direction the macro was written. Each event starts with a header
+ * byte:
+ *
+ *   0b0PKKKKKK  key event with P set on press, K is the key index
+ *               (row * MATRIX_COLS + col) if below 63. If K is 63,
+ *               the key index minus 63 follows in the next byte.
+ *   0b10NNNNNN  the press and release before this are repeated N
+ *               more times.
+ *   0b11PTCK00  any other event, followed by the row and col, then
+ *               the event type if T, the tap state if C and the
+ *               keycode (low byte first) if K.
+ *
+ * With DYNAMIC_MACRO_TIMING, every key event is followed by the
+ * milliseconds since the previous event, 7 bits per byte with the
+ * top bit set if another byte follows.
+ */
+static uint8_t macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
+
+/* Number of bytes used by each macro. */
+static uint16_t macro_length[2] = {0, 0};
+
+#define DYNAMIC_MACRO_KEY_PRESSED 0x40
+#define DYNAMIC_MACRO_KEY_INDEX 0x3F
+#define DYNAMIC_MACRO_REPEAT 0x80
+#define DYNAMIC_MACRO_REPEAT_MAX 0x3F
+#define DYNAMIC_MACRO_EXTENDED 0xC0
+#define DYNAMIC_MACRO_EXTENDED_PRESSED 0x20
+#define DYNAMIC_MACRO_EXTENDED_TYPE 0x10
+#define DYNAMIC_MACRO_EXTENDED_TAP 0x08
+#define DYNAMIC_MACRO_EXTENDED_KEYCODE 0x04
+
+/* Longest event: header, row, col, type, tap, keycode and a three byte delay. */
+#define DYNAMIC_MACRO_EVENT_MAX 10
+
+#define DYNAMIC_MACRO_NONE UINT16_MAX
+
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+#    ifndef DYNAMIC_MACRO_EEPROM_ADDR
+#        if defined(VIA_ENABLE) || defined(DYNAMIC_KEYMAP_ENABLE)
+#            error "DYNAMIC_MACRO_EEPROM_ADDR needs to be set past the end of the dynamic keymap"
+#        endif
+#        define DYNAMIC_MACRO_EEPROM_ADDR (EECONFIG_SIZE)
+#    endif
+#    define DYNAMIC_MACRO_EEPROM_MAGIC 0xD7A5
+#    define DYNAMIC_MACRO_EEPROM_MAGIC_ADDR ((uint16_t *)(DYNAMIC_MACRO_EEPROM_ADDR))
+#    define DYNAMIC_MACRO_EEPROM_LENGTH_ADDR ((uint16_t *)(DYNAMIC_MACRO_EEPROM_ADDR + 2))
+#    define DYNAMIC_MACRO_EEPROM_DATA_ADDR ((uint8_t *)(DYNAMIC_MACRO_EEPROM_ADDR + 6))
+
+_Static_assert((DYNAMIC_MACRO_EEPROM_ADDR) + 6 + (DYNAMIC_MACRO_BUFFER_SIZE) <= (TOTAL_EEPROM_BYTE_COUNT), "Dynamic macros do not fit in EEPROM, reduce DYNAMIC_MACRO_BUFFER_SIZE");
+
+static bool macro_storage_loaded = false;
+
+/**
+ * Read the lengths of the macros saved in EEPROM. The macros
+ * themselves are played back straight from EEPROM.
+ */
+static void dynamic_macro_storage_load(void) {
+    macro_storage_loaded = true;
+
+    if (eeprom_read_word(DYNAMIC_MACRO_EEPROM_MAGIC_ADDR) != DYNAMIC_MACRO_EEPROM_MAGIC) {
+        dprintln("dynamic macro: no macros saved");
+        return;
+    }
+
+    uint16_t length[2];
+    eeprom_read_block(length, DYNAMIC_MACRO_EEPROM_LENGTH_ADDR, sizeof(length));
+    if (length[0] > DYNAMIC_MACRO_BUFFER_SIZE || length[1] > DYNAMIC_MACRO_BUFFER_SIZE - length[0]) {
+        dprintln("dynamic macro: saved macros do not fit the buffer");
+        return;
+    }
+
+    macro_length[0] = length[0];
+    macro_length[1] = length[1];
+}
+
+/**
+ * Save a macro to EEPROM, at the same place it has in the buffer.
  */
-#define DYNAMIC_MACRO_CURRENT_SLOT() (direction > 0 ? 1 : 2)
-#define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
-#define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
+static void dynamic_macro_storage_save(uint8_t slot) {
+    if (slot == 0) {
+        eeprom_update_block(macro_buffer, DYNAMIC_MACRO_EEPROM_DATA_ADDR, macro_length[0]);
+    } else {
+        const uint16_t start = DYNAMIC_MACRO_BUFFER_SIZE - macro_length[1];
+        eeprom_update_block(macro_buffer + start, DYNAMIC_MACRO_EEPROM_DATA_ADDR + start, macro_length[1]);
+    }
+    eeprom_update_block(macro_length, DYNAMIC_MACRO_EEPROM_LENGTH_ADDR, sizeof(macro_length));
+    eeprom_update_word(DYNAMIC_MACRO_EEPROM_MAGIC_ADDR, DYNAMIC_MACRO_EEPROM_MAGIC);
+
+    dprintf("dynamic macro: slot %d saved to eeprom\n", slot + 1);
+}
+#endif
+
+/* Index into macro_buffer of a byte of a macro. */
+static inline uint16_t dynamic_macro_address(uint8_t slot, uint16_t offset) {
+    return slot == 0 ? offset : DYNAMIC_MACRO_BUFFER_SIZE - 1 - offset;
+}
+
+static inline uint8_t dynamic_macro_read(uint8_t slot, uint16_t offset) {
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+    return eeprom_read_byte(DYNAMIC_MACRO_EEPROM_DATA_ADDR + dynamic_macro_address(slot, offset));
+#else
+    return macro_buffer[dynamic_macro_address(slot, offset)];
+#endif
+}
+
+static inline int8_t dynamic_macro_direction(uint8_t slot) {
+    return slot == 0 ? +1 : -1;
+}
+
+/**
+ * Decode a single event.
+ *
+ * @param[in]     slot   The macro to read from.
+ * @param[in,out] offset The position of the event, moved past it.
+ * @param[out]    record The decoded key event.
+ * @param[out]    delay  The milliseconds since the previous event.
+ * @return The repeat count if the event is a repeat, 0 otherwise.
+ */
+static uint8_t dynamic_macro_decode(uint8_t slot, uint16_t *offset, keyrecord_t *record, uint16_t *delay) {
+    const uint8_t header = dynamic_macro_read(slot, (*offset)++);
+
+    if ((header & 0xC0) == DYNAMIC_MACRO_REPEAT) {
+        return header & DYNAMIC_MACRO_REPEAT_MAX;
+    }
+
+    *record            = (keyrecord_t){0};
+    record->event.type = KEY_EVENT;
+
+    if ((header & 0xC0) == DYNAMIC_MACRO_EXTENDED) {
+        record->event.pressed = header & DYNAMIC_MACRO_EXTENDED_PRESSED;
+        record->event.key.row = dynamic_macro_read(slot, (*offset)++);
+        record->event.key.col = dynamic_macro_read(slot, (*offset)++);
+        if (header & DYNAMIC_MACRO_EXTENDED_TYPE) {
+            record->event.type = dynamic_macro_read(slot, (*offset)++);
+        }
+        if (header & DYNAMIC_MACRO_EXTENDED_TAP) {
+            uint8_t tap = dynamic_macro_read(slot, (*offset)++);
+#ifndef NO_ACTION_TAPPING
+            memcpy(&record->tap, &tap, sizeof(tap));
+#endif
+        }
+        if (header & DYNAMIC_MACRO_EXTENDED_KEYCODE) {
+            uint16_t keycode = dynamic_macro_read(slot, (*offset)++);
+            keycode |= dynamic_macro_read(slot, (*offset)++) << 8;
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+            record->keycode = keycode;
+#endif
+        }
+    } else {
+        uint16_t index = header & DYNAMIC_MACRO_KEY_INDEX;
+        if (index == DYNAMIC_MACRO_KEY_INDEX) {
+            index += dynamic_macro_read(slot, (*offset)++);
+        }
+        record->event.pressed = header & DYNAMIC_MACRO_KEY_PRESSED;
+        record->event.key.row = index / MATRIX_COLS;
+        record->event.key.col = index % MATRIX_COLS;
+    }
+
+    *delay = 0;
+#ifdef DYNAMIC_MACRO_TIMING
+    for (uint8_t shift = 0; shift < 16; shift += 7) {
+        const uint8_t byte = dynamic_macro_read(slot, (*offset)++);
+        *delay |= (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+#endif
+
+    return 0;
+}
+
+/**
+ * Encode a single event.
+ *
+ * @param[out] event  At least DYNAMIC_MACRO_EVENT_MAX bytes for the encoded event.
+ * @param[in]  record The key event.
+ * @param[in]  delay  The milliseconds since the previous event.
+ * @return The number of bytes used.
+ */
+static uint8_t dynamic_macro_encode(uint8_t *event, keyrecord_t *record, uint16_t delay) {
+    uint8_t        length = 0;
+    const uint16_t index  = record->event.key.row * MATRIX_COLS + record->event.key.col;
+    uint8_t        tap    = 0;
+    uint16_t       keycode = 0;
+
+#ifndef NO_ACTION_TAPPING
+    memcpy(&tap, &record->tap, sizeof(tap));
+#endif
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    keycode = record->keycode;
+#endif
+
+    if (record->event.type == KEY_EVENT && record->event.key.row < MATRIX_ROWS && record->event.key.col < MATRIX_COLS && index < DYNAMIC_MACRO_KEY_INDEX + 256 && !tap && !keycode) {
+        const uint8_t pressed = record->event.pressed ? DYNAMIC_MACRO_KEY_PRESSED : 0;
+        if (index < DYNAMIC_MACRO_KEY_INDEX) {
+            event[length++] = pressed | index;
+        } else {
+            event[length++] = pressed | DYNAMIC_MACRO_KEY_INDEX;
+            event[length++] = index - DYNAMIC_MACRO_KEY_INDEX;
+        }
+    } else {
+        uint8_t *header = &event[length++];
+        *header         = DYNAMIC_MACRO_EXTENDED | (record->event.pressed ? DYNAMIC_MACRO_EXTENDED_PRESSED : 0);
+        event[length++] = record->event.key.row;
+        event[length++] = record->event.key.col;
+        if (record->event.type != KEY_EVENT) {
+            *header |= DYNAMIC_MACRO_EXTENDED_TYPE;
+            event[length++] = record->event.type;
+        }
+        if (tap) {
+            *header |= DYNAMIC_MACRO_EXTENDED_TAP;
+            event[length++] = tap;
+        }
+        if (keycode) {
+            *header |= DYNAMIC_MACRO_EXTENDED_KEYCODE;
+            event[length++] = keycode & 0xFF;
+            event[length++] = keycode >> 8;
+        }
+    }
+
+#ifdef DYNAMIC_MACRO_TIMING
+    do {
+        event[length] = delay & 0x7F;
+        delay >>= 7;
+        if (delay) {
+            event[length] |= 0x80;
+        }
+        length++;
+    } while (delay);
+#endif
+
+    return length;
+}
+
+/* The macro being recorded: 0 if none, 1 or 2 otherwise. */
+static uint8_t macro_id = 0;
+
+/* State of the recording. */
+static uint16_t macro_record_end;   // bytes recorded so far
+static uint16_t macro_trim_end;     // end of the last event that is not a key press
+static uint16_t macro_press_start;  // start of the last event if it is a key press, DYNAMIC_MACRO_NONE otherwise
+static keypos_t macro_press_key;    // and its key
+static uint16_t macro_pair_start;   // start of the last press and release of the same key, DYNAMIC_MACRO_NONE if there is none
+static uint16_t macro_pair_length;  // its length, not counting the repeat after it
+static uint16_t macro_repeat_start; // start of the repeat after it, DYNAMIC_MACRO_NONE if there is none
+static uint16_t macro_record_time;  // time of the last event recorded
 
 /**
  * Start recording of the dynamic macro.
  *
- * @param[out] macro_pointer The new macro buffer iterator.
- * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
+ * @param[in] slot The macro to record, 0 or 1.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
+static void dynamic_macro_record_start(uint8_t slot) {
     dprintln("dynamic macro recording: started");
 
-    dynamic_macro_record_start_user(direction);
+    dynamic_macro_record_start_user(dynamic_macro_direction(slot));
 
     clear_keyboard();
     layer_clear();
-    *macro_pointer = macro_buffer;
+
+    macro_record_end   = 0;
+    macro_trim_end     = 0;
+    macro_press_start  = DYNAMIC_MACRO_NONE;
+    macro_pair_start   = DYNAMIC_MACRO_NONE;
+    macro_repeat_start = DYNAMIC_MACRO_NONE;
+    macro_record_time  = timer_read();
+}
+
+static void dynamic_macro_play_record(keyrecord_t *record, uint16_t delay) {
+#ifdef DYNAMIC_MACRO_TIMING
+    wait_ms(delay);
+#endif
+    record->event.time = timer_read();
+    process_record(record);
+#ifdef DYNAMIC_MACRO_DELAY
+    wait_ms(DYNAMIC_MACRO_DELAY);
+#endif
 }
 
 /**
  * Play the dynamic macro.
  *
- * @param macro_buffer[in] The beginning of the macro buffer being played.
- * @param macro_end[in]    The element after the last macro buffer element.
- * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
+ * @param[in] slot The macro to play, 0 or 1.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
-    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
+static void dynamic_macro_play(uint8_t slot) {
+    dprintf("dynamic macro: slot %d playback\n", slot + 1);
 
     layer_state_t saved_layer_state = layer_state;
 
     clear_keyboard();
     layer_clear();
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
-#ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
-#endif
+    /* The last two events, for repeats. */
+    keyrecord_t records[2] = {0};
+    uint16_t    delays[2]  = {0};
+
+    const uint16_t length = macro_length[slot];
+    uint16_t       offset = 0;
+    while (offset < length) {
+        keyrecord_t record;
+        uint16_t    delay;
+        uint8_t     repeat = dynamic_macro_decode(slot, &offset, &record, &delay);
+
+        if (repeat) {
+            while (repeat--) {
+                for (uint8_t i = 0; i < 2; i++) {
+                    keyrecord_t copy = records[i];
+                    dynamic_macro_play_record(&copy, delays[i]);
+                }
+            }
+        } else {
+            records[0] = records[1];
+            delays[0]  = delays[1];
+            records[1] = record;
+            delays[1]  = delay;
+            dynamic_macro_play_record(&record, delay);
+        }
     }
 
     clear_keyboard();
 
     layer_state_set(saved_layer_state);
 
-    dynamic_macro_play_user(direction);
+    dynamic_macro_play_user(dynamic_macro_direction(slot));
+}
+
+static bool dynamic_macro_bytes_equal(uint8_t slot, uint16_t a, uint16_t b, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        if (macro_buffer[dynamic_macro_address(slot, a + i)] != macro_buffer[dynamic_macro_address(slot, b + i)]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * If the press and release just recorded are the same as the ones
+ * before them, replace them with a repeat.
+ */
+static void dynamic_macro_record_repeat(uint8_t slot, uint16_t pair_start) {
+    const uint16_t pair_length = macro_record_end - pair_start;
+    const uint16_t pair_before = macro_repeat_start != DYNAMIC_MACRO_NONE ? macro_repeat_start : pair_start;
+
+    if (macro_pair_start != DYNAMIC_MACRO_NONE && macro_pair_length == pair_length && macro_pair_start + pair_length == pair_before && dynamic_macro_bytes_equal(slot, macro_pair_start, pair_start, pair_length)) {
+        if (macro_repeat_start == DYNAMIC_MACRO_NONE) {
+            macro_repeat_start                                             = pair_start;
+            macro_buffer[dynamic_macro_address(slot, macro_repeat_start)] = DYNAMIC_MACRO_REPEAT | 1;
+            macro_record_end                                               = macro_repeat_start + 1;
+            macro_trim_end                                                 = macro_record_end;
+            return;
+        }
+
+        uint8_t *repeat = &macro_buffer[dynamic_macro_address(slot, macro_repeat_start)];
+        if ((*repeat & DYNAMIC_MACRO_REPEAT_MAX) < DYNAMIC_MACRO_REPEAT_MAX) {
+            (*repeat)++;
+            macro_record_end = macro_repeat_start + 1;
+            macro_trim_end   = macro_record_end;
+            return;
+        }
+    }
+
+    macro_pair_start   = pair_start;
+    macro_pair_length  = pair_length;
+    macro_repeat_start = DYNAMIC_MACRO_NONE;
 }
 
 /**
  * Record a single key in a dynamic macro.
  *
- * @param macro_buffer[in] The start of the used macro buffer.
- * @param macro_pointer[in,out] The current buffer position.
- * @param macro2_end[in] The end of the other macro.
- * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
- * @param record[in]     The current keypress.
+ * @param[in] slot   The macro being recorded, 0 or 1.
+ * @param[in] record The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+static void dynamic_macro_record_key(uint8_t slot, keyrecord_t *record) {
     /* If we've just started recording, ignore all the key releases. */
-    if (!record->event.pressed && *macro_pointer == macro_buffer) {
+    if (!record->event.pressed && macro_record_end == 0) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
-    /* The other end of the other macro is the last buffer element it
-     * is safe to use before overwriting the other macro.
-     */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    uint8_t        event[DYNAMIC_MACRO_EVENT_MAX];
+    const uint16_t now    = timer_read();
+    const uint8_t  length = dynamic_macro_encode(event, record, TIMER_DIFF_16(now, macro_record_time));
+
+    /* The other macro ends where this one has to. */
+    if (macro_record_end + length <= DYNAMIC_MACRO_BUFFER_SIZE - macro_length[!slot]) {
+        const uint16_t start = macro_record_end;
+        for (uint8_t i = 0; i < length; i++) {
+            macro_buffer[dynamic_macro_address(slot, macro_record_end++)] = event[i];
+        }
+        macro_record_time = now;
+
+        if (record->event.pressed) {
+            macro_press_start = start;
+            macro_press_key   = record->event.key;
+        } else {
+            macro_trim_end = macro_record_end;
+            if (macro_press_start != DYNAMIC_MACRO_NONE && KEYEQ(macro_press_key, record->event.key)) {
+                dynamic_macro_record_repeat(slot, macro_press_start);
+            } else {
+                macro_pair_start   = DYNAMIC_MACRO_NONE;
+                macro_repeat_start = DYNAMIC_MACRO_NONE;
+            }
+            macro_press_start = DYNAMIC_MACRO_NONE;
+        }
     }
-    dynamic_macro_record_key_user(direction, record);
+    dynamic_macro_record_key_user(dynamic_macro_direction(slot), record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d bytes\n", slot + 1, macro_record_end, (int)(DYNAMIC_MACRO_BUFFER_SIZE - macro_length[!slot]));
 }
 
 /**
- * End recording of the dynamic macro. Essentially just update the
- * pointer to the end of the macro.
+ * End recording of the dynamic macro.
+ *
+ * @param[in] slot The macro being recorded, 0 or 1.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
-    dynamic_macro_record_end_user(direction);
+static void dynamic_macro_record_end(uint8_t slot) {
+    dynamic_macro_record_end_user(dynamic_macro_direction(slot));
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DM_RSTP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    if (macro_record_end != macro_trim_end) {
+        dprintln("dynamic macro: trimming trailing key-down events");
     }
+    macro_length[slot] = macro_trim_end;
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %d bytes\n", slot + 1, macro_length[slot]);
 
-    *macro_end = macro_pointer;
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+    dynamic_macro_storage_save(slot);
+#endif
 }
 
-/* Both macros use the same buffer but read/write on different
- * ends of it.
- *
- * Macro1 is written left-to-right starting from the beginning of
- * the buffer.
- *
- * Macro2 is written right-to-left starting from the end of the
- * buffer.
- *
- * &macro_buffer   macro_end
- *  v                   v
- * +------------------------------------------------------------+
- * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
- * +------------------------------------------------------------+
- *                           ^                                 ^
- *                         r_macro_end                  r_macro_buffer
- *
- * During the recording when one macro encounters the end of the
- * other macro, the recording is stopped. Apart from this, there
- * are no arbitrary limits for the macros' length in relation to
- * each other: for example one can either have two medium sized
- * macros or one long macro and one short macro. Or even one empty
- * and one using the whole buffer.
- */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
-
-/* Pointer to the first buffer element after the first macro.
- * Initially points to the very beginning of the buffer since the
- * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
-
-/* The other end of the macro buffer. Serves as the beginning of
- * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-/* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-/* A persistent pointer to the current macro position (iterator)
- * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
-
-/* 0   - no macro is being recorded right now
- * 1,2 - either macro 1 or 2 is being recorded */
-static uint8_t macro_id = 0;
-
 /**
  * If a dynamic macro is currently being recorded, stop recording.
  */
 void dynamic_macro_stop_recording(void) {
-    switch (macro_id) {
-        case 1:
-            dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
-            break;
-        case 2:
-            dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
-            break;
+    if (macro_id) {
+        dynamic_macro_record_end(macro_id - 1);
     }
     macro_id = 0;
 }
@@ -231,23 +544,29 @@ void dynamic_macro_stop_recording(void) {
  *   }
  */
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+    if (!macro_storage_loaded) {
+        dynamic_macro_storage_load();
+    }
+#endif
+
     if (macro_id == 0) {
         /* No macro recording in progress. */
         if (!record->event.pressed) {
             switch (keycode) {
                 case QK_DYNAMIC_MACRO_RECORD_START_1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
+                    dynamic_macro_record_start(0);
                     macro_id = 1;
                     return false;
                 case QK_DYNAMIC_MACRO_RECORD_START_2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
+                    dynamic_macro_record_start(1);
                     macro_id = 2;
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
+                    dynamic_macro_play(0);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_play(1);
                     return false;
             }
         }
@@ -273,14 +592,7 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
             default:
                 if (dynamic_macro_valid_key_user(keycode, record)) {
                     /* Store the key in the macro buffer and process it normally. */
-                    switch (macro_id) {
-                        case 1:
-                            dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
-                            break;
-                        case 2:
-                            dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
-                            break;
-                    }
+                    dynamic_macro_record_key(macro_id - 1, record);
                 }
                 return true;
                 break;
@@ -22,10 +22,12 @@
 #include <stdbool.h>
 #include "action.h"
 
-/* May be overridden with a custom value. Be aware that the effective
- * macro length is half of this value: each keypress is recorded twice
- * because of the down-event and up-event. This is not a bug, it's the
- * intended behavior.
+/* May be overridden with a custom value. This is the number of key
+ * events the buffer is sized for when every event takes as much space
+ * as a keyrecord_t, so the effective macro length is at least half of
+ * this value: each keypress is recorded twice because of the
+ * down-event and up-event. Plain key events are packed into one or two
+ * bytes, so in practice many more fit.
  *
  * Usually it should be fine to set the macro size to at least 256 but
  * there have been reports of it being too much in some users' cases,
@@ -35,6 +37,11 @@
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* The size in bytes of the buffer shared by both macros. */
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#    define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+#endif
+
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 void dynamic_macro_record_start_user(int8_t direction);
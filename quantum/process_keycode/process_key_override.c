@@ -28,6 +28,11 @@
 #    define KEY_OVERRIDE_REPEAT_DELAY 500
 #endif
 
+// Number of overrides that can be indexed by trigger keycode. With more overrides than this, every key event scans the whole array
+#ifndef KEY_OVERRIDE_INDEX_SIZE
+#    define KEY_OVERRIDE_INDEX_SIZE 0
+#endif
+
 // For benchmarking the time it takes to call process_key_override on every key press (needs keyboard debugging enabled as well)
 // #define BENCH_KEY_OVERRIDE
 
@@ -89,13 +94,71 @@ __attribute__((weak)) const key_override_t **key_overrides = NULL;
 // Forward decls
 static const key_override_t *clear_active_override(const bool allow_reregister);
 
+#if KEY_OVERRIDE_INDEX_SIZE > 0
+// Positions in key_overrides, sorted by trigger keycode and then by position, so that the overrides of one trigger are found with a binary search and still come in array order
+static uint16_t key_override_index[KEY_OVERRIDE_INDEX_SIZE];
+static uint16_t key_override_index_count = 0;
+static bool     key_override_index_valid = false;
+// The array the index was built for. The index is rebuilt when key_overrides is pointed elsewhere, or after key_override_index_invalidate()
+static const key_override_t **key_override_index_source = NULL;
+
+static void key_override_index_build(void) {
+    key_override_index_source = key_overrides;
+    key_override_index_count  = 0;
+    key_override_index_valid  = false;
+
+    for (uint16_t i = 0; key_overrides[i] != NULL; i++) {
+        if (i >= KEY_OVERRIDE_INDEX_SIZE) {
+            key_override_printf("Too many overrides to index, scanning instead\n");
+            return;
+        }
+
+        // Insertion sort, stable so that overrides with the same trigger stay in array order
+        const uint16_t trigger = key_overrides[i]->trigger;
+        uint16_t       j       = i;
+        for (; j > 0 && key_overrides[key_override_index[j - 1]]->trigger > trigger; j--) {
+            key_override_index[j] = key_override_index[j - 1];
+        }
+        key_override_index[j] = i;
+        key_override_index_count++;
+    }
+
+    key_override_index_valid = true;
+}
+
+// Returns the first position in the index with the given trigger, or key_override_index_count if there is none
+static uint16_t key_override_index_find(const uint16_t trigger) {
+    uint16_t low  = 0;
+    uint16_t high = key_override_index_count;
+
+    while (low < high) {
+        const uint16_t mid = low + (high - low) / 2;
+        if (key_overrides[key_override_index[mid]]->trigger < trigger) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+#endif
+
+void key_override_index_invalidate(void) {
+#if KEY_OVERRIDE_INDEX_SIZE > 0
+    key_override_index_source = NULL;
+#endif
+}
+
 void key_override_on(void) {
     enabled = true;
+    key_override_index_invalidate();
     key_override_printf("Key override ON\n");
 }
 
 void key_override_off(void) {
     enabled = false;
+    key_override_index_invalidate();
     clear_active_override(false);
     key_override_printf("Key override OFF\n");
 }
@@ -245,152 +308,200 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_overrides == NULL) {
-        return true;
+/** Checks whether the override can activate on this key event. */
+static bool check_override(const key_override_t *override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0;; i++) {
-        const key_override_t *const override = key_overrides[i];
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
-        }
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
-        }
+    // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
+    const bool no_trigger = override->trigger == KC_NO;
 
-        const bool is_trigger = override->trigger == keycode;
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
-        }
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
-        }
+    // Check if trigger key is down.
+    const bool trigger_down = is_trigger && key_down;
+
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required, yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+
+    if (!should_activate) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
+    return true;
+}
+
+/** Finds the first override in key_overrides that can activate on this key event, or NULL if there is none. */
+static const key_override_t *find_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+#if KEY_OVERRIDE_INDEX_SIZE > 0
+    if (key_override_index_source != key_overrides) {
+        key_override_index_build();
+    }
+
+    if (key_override_index_valid) {
+        // Only overrides without a trigger, triggered by the pressed key or by the last non-mod key that is still down can activate
+        const uint16_t triggers[] = {KC_NO, last_key_down, key_down ? keycode : KC_NO};
+        uint16_t       first      = UINT16_MAX;
+
+        for (uint8_t t = 0; t < ARRAY_SIZE(triggers); t++) {
+            // Skip triggers that were already looked up
+            if ((t > 0 && triggers[t] == triggers[0]) || (t > 1 && triggers[t] == triggers[1])) {
+                continue;
+            }
+
+            for (uint16_t i = key_override_index_find(triggers[t]); i < key_override_index_count; i++) {
+                const uint16_t position = key_override_index[i];
+
+                // Past the overrides for this trigger, or behind an override that was already found
+                if (key_overrides[position]->trigger != triggers[t] || position > first) {
+                    break;
+                }
+
+                if (check_override(key_overrides[position], keycode, layer, key_down, is_mod, active_mods)) {
+                    first = position;
+                    break;
+                }
+            }
         }
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
+        return first == UINT16_MAX ? NULL : key_overrides[first];
+    }
+#endif
+
+    for (uint16_t i = 0; key_overrides[i] != NULL; i++) {
+        if (check_override(key_overrides[i], keycode, layer, key_down, is_mod, active_mods)) {
+            return key_overrides[i];
         }
+    }
 
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    return NULL;
+}
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+/** Finds the first override that can activate and activates it. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    if (key_overrides == NULL) {
+        return true;
+    }
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
-            continue;
-        }
+    const key_override_t *const override = find_override(keycode, layer, key_down, is_mod, active_mods);
 
-        key_override_printf("Activating override\n");
+    if (override == NULL) {
+        *activated = false;
+        return true;
+    }
+
+    const bool trigger_down = override->trigger == keycode && key_down;
+    const bool no_trigger   = override->trigger == KC_NO;
+
+    key_override_printf("Activating override\n");
 
-        clear_active_override(false);
+    clear_active_override(false);
 
 #ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
-        // Send a dummy keycode before unregistering the modifier(s)
-        // so that suppressing the modifier(s) doesn't falsely get interpreted
-        // by the host OS as a tap of a modifier key.
-        // For example, unintended activations of the start menu on Windows when
-        // using a GUI+<kc> key override with suppressed mods.
-        neutralize_flashing_modifiers(active_mods);
+    // Send a dummy keycode before unregistering the modifier(s)
+    // so that suppressing the modifier(s) doesn't falsely get interpreted
+    // by the host OS as a tap of a modifier key.
+    // For example, unintended activations of the start menu on Windows when
+    // using a GUI+<kc> key override with suppressed mods.
+    neutralize_flashing_modifiers(active_mods);
 #endif
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
+    active_override                 = override;
+    active_override_trigger_is_down = true;
 
-        set_suppressed_override_mods(override->suppressed_mods);
+    set_suppressed_override_mods(override->suppressed_mods);
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_BASIC_KEYCODE(override->trigger)) {
-                del_key(override->trigger);
-            } else {
-                unregister_code(override->trigger);
-            }
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_BASIC_KEYCODE(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
         }
+    }
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
-        }
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
 
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_BASIC_KEYCODE(mod_free_replacement)) {
+                add_key(mod_free_replacement);
             } else {
-                if (IS_BASIC_KEYCODE(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
-                }
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                wait_ms(10);
+                register_code(mod_free_replacement);
             }
-        } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
         }
-
-        *activated = true;
-
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
     }
 
-    *activated = false;
+    *activated = true;
 
-    return true;
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    return !trigger_down;
 }
 
 void key_override_task(void) {
@@ -102,6 +102,9 @@ void key_override_toggle(void);
 /** Returns whether key overrides are enabled */
 bool key_override_is_enabled(void);
 
+/** Rebuilds the trigger index on next use. Call this after changing the contents of key_overrides at runtime */
+void key_override_index_invalidate(void);
+
 /** Handling of key overrides and its implemented keycodes */
 bool process_key_override(const uint16_t keycode, const keyrecord_t *const record);
 
@@ -21,10 +21,49 @@
 #include "action_util.h"
 #include "timer.h"
 #include "wait.h"
+#include "progmem.h"
+
+// Number of tap dances that can be in progress at once, a dance stays in progress until its key is released
+#ifndef TAP_DANCE_MAX_SIMULTANEOUS
+#    define TAP_DANCE_MAX_SIMULTANEOUS 3
+#endif
 
 static uint16_t active_td;
 static uint16_t last_tap_time;
 
+static tap_dance_state_t tap_dance_states[TAP_DANCE_MAX_SIMULTANEOUS];
+// Dances whose key was pressed while every state was in use, their release is dropped as well
+static uint8_t tap_dance_untracked[(QK_TAP_DANCE_MAX - QK_TAP_DANCE + 1 + 7) / 8];
+
+tap_dance_state_t *tap_dance_get_state(uint8_t index) {
+    for (uint8_t i = 0; i < TAP_DANCE_MAX_SIMULTANEOUS; i++) {
+        if (tap_dance_states[i].in_use && tap_dance_states[i].index == index) {
+            return &tap_dance_states[i];
+        }
+    }
+    return NULL;
+}
+
+static tap_dance_state_t *tap_dance_start_state(uint8_t index) {
+    tap_dance_state_t *state = tap_dance_get_state(index);
+    if (state != NULL) {
+        return state;
+    }
+
+    for (uint8_t i = 0; i < TAP_DANCE_MAX_SIMULTANEOUS; i++) {
+        if (!tap_dance_states[i].in_use) {
+            tap_dance_states[i].in_use = true;
+            tap_dance_states[i].index  = index;
+            return &tap_dance_states[i];
+        }
+    }
+    return NULL;
+}
+
+static inline void tap_dance_get_action(uint8_t index, tap_dance_action_t *action) {
+    memcpy_P(action, &tap_dance_actions[index], sizeof(tap_dance_action_t));
+}
+
 void tap_dance_pair_on_each_tap(tap_dance_state_t *state, void *user_data) {
     tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
 
@@ -85,58 +124,63 @@ static inline void _process_tap_dance_action_fn(tap_dance_state_t *state, void *
     }
 }
 
-static inline void process_tap_dance_action_on_each_tap(tap_dance_action_t *action) {
-    action->state.count++;
-    action->state.weak_mods = get_mods();
-    action->state.weak_mods |= get_weak_mods();
+static inline void process_tap_dance_action_on_each_tap(tap_dance_action_t *action, tap_dance_state_t *state) {
+    state->count++;
+    state->weak_mods = get_mods();
+    state->weak_mods |= get_weak_mods();
 #ifndef NO_ACTION_ONESHOT
-    action->state.oneshot_mods = get_oneshot_mods();
+    state->oneshot_mods = get_oneshot_mods();
 #endif
-    _process_tap_dance_action_fn(&action->state, action->user_data, action->fn.on_each_tap);
+    _process_tap_dance_action_fn(state, action->user_data, action->fn.on_each_tap);
 }
 
-static inline void process_tap_dance_action_on_each_release(tap_dance_action_t *action) {
-    _process_tap_dance_action_fn(&action->state, action->user_data, action->fn.on_each_release);
+static inline void process_tap_dance_action_on_each_release(tap_dance_action_t *action, tap_dance_state_t *state) {
+    _process_tap_dance_action_fn(state, action->user_data, action->fn.on_each_release);
 }
 
-static inline void process_tap_dance_action_on_reset(tap_dance_action_t *action) {
-    _process_tap_dance_action_fn(&action->state, action->user_data, action->fn.on_reset);
-    del_weak_mods(action->state.weak_mods);
+static inline void process_tap_dance_action_on_reset(tap_dance_action_t *action, tap_dance_state_t *state) {
+    _process_tap_dance_action_fn(state, action->user_data, action->fn.on_reset);
+    del_weak_mods(state->weak_mods);
 #ifndef NO_ACTION_ONESHOT
-    del_mods(action->state.oneshot_mods);
+    del_mods(state->oneshot_mods);
 #endif
     send_keyboard_report();
-    action->state = (const tap_dance_state_t){0};
+    // Also frees the state for the next dance
+    *state = (const tap_dance_state_t){0};
 }
 
-static inline void process_tap_dance_action_on_dance_finished(tap_dance_action_t *action) {
-    if (!action->state.finished) {
-        action->state.finished = true;
-        add_weak_mods(action->state.weak_mods);
+static inline void process_tap_dance_action_on_dance_finished(tap_dance_action_t *action, tap_dance_state_t *state) {
+    if (!state->finished) {
+        state->finished = true;
+        add_weak_mods(state->weak_mods);
 #ifndef NO_ACTION_ONESHOT
-        add_mods(action->state.oneshot_mods);
+        add_mods(state->oneshot_mods);
 #endif
         send_keyboard_report();
-        _process_tap_dance_action_fn(&action->state, action->user_data, action->fn.on_dance_finished);
+        _process_tap_dance_action_fn(state, action->user_data, action->fn.on_dance_finished);
     }
     active_td = 0;
-    if (!action->state.pressed) {
+    if (!state->pressed) {
         // There will not be a key release event, so reset now.
-        process_tap_dance_action_on_reset(action);
+        process_tap_dance_action_on_reset(action, state);
     }
 }
 
 bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record) {
-    tap_dance_action_t *action;
+    tap_dance_action_t action;
+    tap_dance_state_t *state;
 
     if (!record->event.pressed) return false;
 
     if (!active_td || keycode == active_td) return false;
 
-    action                             = &tap_dance_actions[QK_TAP_DANCE_GET_INDEX(active_td)];
-    action->state.interrupted          = true;
-    action->state.interrupting_keycode = keycode;
-    process_tap_dance_action_on_dance_finished(action);
+    state = tap_dance_get_state(QK_TAP_DANCE_GET_INDEX(active_td));
+    if (state == NULL) return false;
+
+    tap_dance_get_action(state->index, &action);
+    state->interrupted          = true;
+    state->interrupting_keycode = keycode;
+    process_tap_dance_action_on_dance_finished(&action, state);
 
     // Tap dance actions can leave some weak mods active (e.g., if the tap dance is mapped to a keycode with
     // modifiers), but these weak mods should not affect the keypress which interrupted the tap dance.
@@ -150,21 +194,44 @@ bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record) {
 }
 
 bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
-    tap_dance_action_t *action;
+    tap_dance_action_t action;
+    tap_dance_state_t *state;
 
     switch (keycode) {
         case QK_TAP_DANCE ... QK_TAP_DANCE_MAX:
-            action = &tap_dance_actions[QK_TAP_DANCE_GET_INDEX(keycode)];
+            if (record->event.pressed) {
+                state = tap_dance_start_state(QK_TAP_DANCE_GET_INDEX(keycode));
+                if (state == NULL) {
+                    dprintf("tap dance: more than %u dances at once\n", TAP_DANCE_MAX_SIMULTANEOUS);
+                    tap_dance_untracked[QK_TAP_DANCE_GET_INDEX(keycode) / 8] |= 1 << (QK_TAP_DANCE_GET_INDEX(keycode) % 8);
+                    break;
+                }
+            } else {
+                if (tap_dance_untracked[QK_TAP_DANCE_GET_INDEX(keycode) / 8] & (1 << (QK_TAP_DANCE_GET_INDEX(keycode) % 8))) {
+                    tap_dance_untracked[QK_TAP_DANCE_GET_INDEX(keycode) / 8] &= ~(1 << (QK_TAP_DANCE_GET_INDEX(keycode) % 8));
+                    break;
+                }
+                state = tap_dance_get_state(QK_TAP_DANCE_GET_INDEX(keycode));
+                if (state == NULL) {
+                    // The dance was reset while its key was held, only the release is left to report
+                    tap_dance_state_t released = {.index = QK_TAP_DANCE_GET_INDEX(keycode)};
+                    tap_dance_get_action(released.index, &action);
+                    process_tap_dance_action_on_each_release(&action, &released);
+                    break;
+                }
+            }
 
-            action->state.pressed = record->event.pressed;
+            tap_dance_get_action(state->index, &action);
+            state->pressed = record->event.pressed;
             if (record->event.pressed) {
                 last_tap_time = timer_read();
-                process_tap_dance_action_on_each_tap(action);
-                active_td = action->state.finished ? 0 : keycode;
+                process_tap_dance_action_on_each_tap(&action, state);
+                // The state is freed if the dance was reset from on_each_tap
+                active_td = state->in_use && !state->finished ? keycode : 0;
             } else {
-                process_tap_dance_action_on_each_release(action);
-                if (action->state.finished) {
-                    process_tap_dance_action_on_reset(action);
+                process_tap_dance_action_on_each_release(&action, state);
+                if (state->finished) {
+                    process_tap_dance_action_on_reset(&action, state);
                     if (active_td == keycode) {
                         active_td = 0;
                     }
@@ -178,17 +245,22 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 }
 
 void tap_dance_task(void) {
-    tap_dance_action_t *action;
+    tap_dance_action_t action;
+    tap_dance_state_t *state;
 
     if (!active_td || timer_elapsed(last_tap_time) <= GET_TAPPING_TERM(active_td, &(keyrecord_t){})) return;
 
-    action = &tap_dance_actions[QK_TAP_DANCE_GET_INDEX(active_td)];
-    if (!action->state.interrupted) {
-        process_tap_dance_action_on_dance_finished(action);
+    state = tap_dance_get_state(QK_TAP_DANCE_GET_INDEX(active_td));
+    if (state != NULL && !state->interrupted) {
+        tap_dance_get_action(state->index, &action);
+        process_tap_dance_action_on_dance_finished(&action, state);
     }
 }
 
 void reset_tap_dance(tap_dance_state_t *state) {
+    tap_dance_action_t action;
+
+    tap_dance_get_action(state->index, &action);
     active_td = 0;
-    process_tap_dance_action_on_reset((tap_dance_action_t *)state);
+    process_tap_dance_action_on_reset(&action, state);
 }
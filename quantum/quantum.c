@@ -24,6 +24,10 @@
 #    include "outputselect.h"
 #endif
 
+#ifdef EEPROM_DRIVER
+#    include "eeprom_driver.h"
+#endif
+
 #ifdef GRAVE_ESC_ENABLE
 #    include "process_grave_esc.h"
 #endif
@@ -32,6 +36,10 @@
 #    include "process_haptic.h"
 #endif
 
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#endif
+
 #ifdef JOYSTICK_ENABLE
 #    include "process_joystick.h"
 #endif
@@ -194,6 +202,9 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#ifdef EEPROM_DRIVER
+    eeprom_driver_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -504,6 +515,9 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#ifdef EEPROM_DRIVER
+    eeprom_driver_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
@@ -536,6 +550,12 @@ void suspend_power_down_quantum(void) {
 #    if defined(RGB_MATRIX_ENABLE)
     rgb_matrix_set_suspend_state(true);
 #    endif
+#    if defined(LIGHTING_SHARED_WS2812)
+    lighting_flush();
+#    endif
+#    ifdef I2C_ASYNC_ENABLE
+    i2c_async_flush();
+#    endif
 
 #    ifdef OLED_ENABLE
     oled_off();
@@ -36,6 +36,10 @@
 #    include "rgb_matrix.h"
 #endif
 
+#ifdef LIGHTING_SHARED_WS2812
+#    include "lighting.h"
+#endif
+
 #include "keymap_common.h"
 #include "quantum_keycodes.h"
 #include "keycode_config.h"
@@ -4,20 +4,83 @@
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+// Largest distance at which a hit of the given age still changes a LED, or a negative value if it changes none
+typedef int16_t (*reactive_splash_reach_f)(uint16_t tick);
+
+// LEDs are bucketed by their position into a grid of 32x32 cells, and each cell notes which hits can reach it
+#    define REACTIVE_GRID_SHIFT 5
+#    define REACTIVE_GRID_SIZE (256 >> REACTIVE_GRID_SHIFT)
+
+#    if LED_HITS_TO_REMEMBER <= 8
+typedef uint8_t reactive_hits_t;
+#    elif LED_HITS_TO_REMEMBER <= 16
+typedef uint16_t reactive_hits_t;
+#    elif LED_HITS_TO_REMEMBER <= 32
+typedef uint32_t reactive_hits_t;
+#    else
+#        define REACTIVE_GRID_DISABLE
+#    endif
+
+#    ifndef REACTIVE_GRID_DISABLE
+static reactive_hits_t reactive_grid[REACTIVE_GRID_SIZE * REACTIVE_GRID_SIZE];
+
+static void reactive_grid_update(uint8_t start, uint8_t count, const uint16_t* ticks, reactive_splash_reach_f reach_func) {
+    memset(reactive_grid, 0, sizeof(reactive_grid));
+    for (uint8_t j = start; j < count; j++) {
+        int16_t reach = reach_func(ticks[j]);
+        if (reach < 0) continue;
+
+        uint8_t x0 = MAX(g_last_hit_tracker.x[j] - reach, 0) >> REACTIVE_GRID_SHIFT;
+        uint8_t x1 = MIN(g_last_hit_tracker.x[j] + reach, 255) >> REACTIVE_GRID_SHIFT;
+        uint8_t y0 = MAX(g_last_hit_tracker.y[j] - reach, 0) >> REACTIVE_GRID_SHIFT;
+        uint8_t y1 = MIN(g_last_hit_tracker.y[j] + reach, 255) >> REACTIVE_GRID_SHIFT;
+        for (uint8_t y = y0; y <= y1; y++) {
+            for (uint8_t x = x0; x <= x1; x++) {
+                reactive_grid[y * REACTIVE_GRID_SIZE + x] |= (reactive_hits_t)1 << j;
+            }
+        }
+    }
+}
+#    endif // REACTIVE_GRID_DISABLE
+
+// With a reach function, hits are only applied to the LEDs they can reach. effect_func must leave hsv untouched beyond that distance.
+bool effect_runner_reactive_splash_reach(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    uint8_t  count = g_last_hit_tracker.count;
+    uint16_t ticks[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        ticks[j] = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+    }
+#    ifndef REACTIVE_GRID_DISABLE
+    if (reach_func) {
+        reactive_grid_update(start, count, ticks, reach_func);
+    }
+#    endif // REACTIVE_GRID_DISABLE
+
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         HSV hsv = rgb_matrix_config.hsv;
         hsv.v   = 0;
-        for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+#    ifndef REACTIVE_GRID_DISABLE
+        if (reach_func) {
+            reactive_hits_t hits = reactive_grid[(g_led_config.point[i].y >> REACTIVE_GRID_SHIFT) * REACTIVE_GRID_SIZE + (g_led_config.point[i].x >> REACTIVE_GRID_SHIFT)];
+            for (uint8_t j = start; j < count && (hits >> j); j++) {
+                if (!(hits & ((reactive_hits_t)1 << j))) continue;
+                int16_t dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+                int16_t dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+                uint8_t dist = sqrt16(dx * dx + dy * dy);
+                hsv          = effect_func(hsv, dx, dy, dist, ticks[j]);
+            }
+        } else
+#    endif // REACTIVE_GRID_DISABLE
+        {
+            for (uint8_t j = start; j < count; j++) {
+                int16_t dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+                int16_t dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+                uint8_t dist = sqrt16(dx * dx + dy * dy);
+                hsv          = effect_func(hsv, dx, dy, dist, ticks[j]);
+            }
         }
         hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
         RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
@@ -26,4 +89,8 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_reach(start, params, effect_func, NULL);
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -16,42 +16,158 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
-void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
-#        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
-    // Limit effect to pressed keys
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
-#        else
-    if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
-        return;
+
+// The neighbor table costs 2 bytes per entry plus 2 bytes per LED, so it is only built when asked for
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_LIMIT
+#            define RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_LIMIT 0
+#        endif
+
+#        define HEATMAP_NO_CELL 0xFF
+
+// Matrix position of each LED, whose heat is kept in g_rgb_frame_buffer
+static struct {
+    uint8_t row;
+    uint8_t col;
+} heatmap_cells[RGB_MATRIX_LED_COUNT];
+
+// LEDs with heat left, and when their heat was last decreased. Only these are visited when
+// decreasing and rendering, and an LED is listed for as long as its cell is not zero.
+static uint8_t  heatmap_active[RGB_MATRIX_LED_COUNT];
+static uint16_t heatmap_active_timer[RGB_MATRIX_LED_COUNT];
+static uint8_t  heatmap_active_count;
+
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM) && RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_LIMIT > 0
+// The LEDs each LED spreads heat to and how much, stored back to back
+static struct {
+    uint8_t led;
+    uint8_t amount;
+} heatmap_neighbors[RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_LIMIT];
+// Where each LED's neighbors start in heatmap_neighbors, the last entry ending the final list
+static uint16_t heatmap_neighbors_start[RGB_MATRIX_LED_COUNT + 1];
+#        endif
+// LEDs below this index have their neighbors in the table, the rest are searched on each key press
+static uint8_t heatmap_neighbors_built;
+
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+static uint8_t heatmap_spread_amount(uint8_t led_a, uint8_t led_b) {
+#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
+    uint8_t distance = LED_DISTANCE(g_led_config.point[led_a], g_led_config.point[led_b]);
+#            undef LED_DISTANCE
+    if (distance > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+        return 0;
+    }
+    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
     }
-    for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
-        for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
-            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
+    return amount;
+}
+#        endif
+
+static void heatmap_init(void) {
+    memset(heatmap_cells, HEATMAP_NO_CELL, sizeof heatmap_cells);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led != NO_LED && heatmap_cells[led].row == HEATMAP_NO_CELL) {
+                heatmap_cells[led].row = row;
+                heatmap_cells[led].col = col;
+            }
+        }
+    }
+    heatmap_active_count    = 0;
+    heatmap_neighbors_built = 0;
+
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM) && RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_LIMIT > 0
+    uint16_t count = 0;
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        heatmap_neighbors_start[led] = count;
+        if (heatmap_cells[led].row == HEATMAP_NO_CELL) {
+            continue;
+        }
+        for (uint8_t other = 0; other < RGB_MATRIX_LED_COUNT; other++) {
+            if (other == led || heatmap_cells[other].row == HEATMAP_NO_CELL) {
                 continue;
             }
-            if (i_row == row && i_col == col) {
-                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
-            } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
-                }
+            uint8_t amount = heatmap_spread_amount(led, other);
+            if (amount == 0) {
+                continue;
+            }
+            if (count == RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_LIMIT) {
+                // Out of room, this LED and the ones after it fall back to searching
+                return;
             }
+            heatmap_neighbors[count].led    = other;
+            heatmap_neighbors[count].amount = amount;
+            count++;
         }
+        heatmap_neighbors_start[led + 1] = count;
+        heatmap_neighbors_built          = led + 1;
     }
 #        endif
 }
 
-// A timer to track the last time we decremented all heatmap values.
-static uint16_t heatmap_decrease_timer;
-// Whether we should decrement the heatmap values during the next update.
-static bool decrease_heatmap_values;
+// Applies the decrease an active LED is due since its timer, and returns its remaining heat
+static uint8_t heatmap_decrease(uint8_t slot) {
+    uint8_t* heat  = &g_rgb_frame_buffer[heatmap_cells[heatmap_active[slot]].row][heatmap_cells[heatmap_active[slot]].col];
+    uint16_t steps = timer_elapsed(heatmap_active_timer[slot]) / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+    heatmap_active_timer[slot] += steps * RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+    *heat = steps < *heat ? *heat - steps : 0;
+    return *heat;
+}
+
+static void heatmap_remove(uint8_t slot) {
+    heatmap_active_count--;
+    heatmap_active[slot]       = heatmap_active[heatmap_active_count];
+    heatmap_active_timer[slot] = heatmap_active_timer[heatmap_active_count];
+}
+
+static void heatmap_increase(uint8_t led, uint8_t amount) {
+    uint8_t* heat = &g_rgb_frame_buffer[heatmap_cells[led].row][heatmap_cells[led].col];
+    if (amount == 0) {
+        return;
+    }
+    if (*heat == 0) {
+        heatmap_active[heatmap_active_count]       = led;
+        heatmap_active_timer[heatmap_active_count] = timer_read();
+        heatmap_active_count++;
+    }
+    *heat = qadd8(*heat, amount);
+}
+
+void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED || heatmap_cells[led].row == HEATMAP_NO_CELL) { // skip as pressed key doesn't have an led position
+        return;
+    }
+
+    // Bring the heat up to date before adding to it, so the new heat is not decreased for time already passed
+    for (uint8_t slot = 0; slot < heatmap_active_count;) {
+        if (heatmap_decrease(slot)) {
+            slot++;
+        } else {
+            heatmap_remove(slot);
+        }
+    }
+
+    heatmap_increase(led, RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+#            if RGB_MATRIX_TYPING_HEATMAP_NEIGHBOR_LIMIT > 0
+    if (led < heatmap_neighbors_built) {
+        for (uint16_t i = heatmap_neighbors_start[led]; i < heatmap_neighbors_start[led + 1]; i++) {
+            heatmap_increase(heatmap_neighbors[i].led, heatmap_neighbors[i].amount);
+        }
+        return;
+    }
+#            endif
+    for (uint8_t other = 0; other < RGB_MATRIX_LED_COUNT; other++) {
+        if (other == led || heatmap_cells[other].row == HEATMAP_NO_CELL) { // skip as target key doesn't have an led position
+            continue;
+        }
+        heatmap_increase(other, heatmap_spread_amount(led, other));
+    }
+#        endif
+}
 
 bool TYPING_HEATMAP(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
@@ -59,38 +175,35 @@ bool TYPING_HEATMAP(effect_params_t* params) {
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
         memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+        heatmap_init();
     }
 
-    // The heatmap animation might run in several iterations depending on
-    // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
-    // timer when the animation starts.
-    if (params->iter == 0) {
-        decrease_heatmap_values = timer_elapsed(heatmap_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
-
-        // Restart the timer if we are going to decrease the heatmap this frame.
-        if (decrease_heatmap_values) {
-            heatmap_decrease_timer = timer_read();
+    // Keys without heat are dark
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        if (heatmap_cells[i].row != HEATMAP_NO_CELL) {
+            rgb_matrix_set_color(i, 0, 0, 0);
         }
     }
 
-    // Render heatmap & decrease
-    uint8_t count = 0;
-    for (uint8_t row = 0; row < MATRIX_ROWS && count < RGB_MATRIX_LED_PROCESS_LIMIT; row++) {
-        for (uint8_t col = 0; col < MATRIX_COLS && RGB_MATRIX_LED_PROCESS_LIMIT; col++) {
-            if (g_led_config.matrix_co[row][col] >= led_min && g_led_config.matrix_co[row][col] < led_max) {
-                count++;
-                uint8_t val = g_rgb_frame_buffer[row][col];
-                if (!HAS_ANY_FLAGS(g_led_config.flags[g_led_config.matrix_co[row][col]], params->flags)) continue;
-
-                HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
-                RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-                rgb_matrix_set_color(g_led_config.matrix_co[row][col], rgb.r, rgb.g, rgb.b);
-
-                if (decrease_heatmap_values) {
-                    g_rgb_frame_buffer[row][col] = qsub8(val, 1);
-                }
-            }
+    // Render heatmap & decrease, for the keys that still have heat
+    for (uint8_t slot = 0; slot < heatmap_active_count;) {
+        uint8_t i = heatmap_active[slot];
+        if (i < led_min || i >= led_max) {
+            slot++;
+            continue;
+        }
+        uint8_t val = heatmap_decrease(slot);
+        if (val == 0) {
+            heatmap_remove(slot);
+            continue;
         }
+        slot++;
+        if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue;
+
+        HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
     }
 
     return rgb_matrix_check_finished_leds(led_max);
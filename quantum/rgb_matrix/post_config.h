@@ -11,6 +11,17 @@
 #    define RGB_MATRIX_FRAMEBUFFER_EFFECTS
 #endif
 
+// polar
+#if defined(ENABLE_RGB_MATRIX_CYCLE_OUT_IN) || \
+    defined(ENABLE_RGB_MATRIX_CYCLE_PINWHEEL) || \
+    defined(ENABLE_RGB_MATRIX_CYCLE_SPIRAL) || \
+    defined(ENABLE_RGB_MATRIX_BAND_PINWHEEL_SAT) || \
+    defined(ENABLE_RGB_MATRIX_BAND_PINWHEEL_VAL) || \
+    defined(ENABLE_RGB_MATRIX_BAND_SPIRAL_SAT) || \
+    defined(ENABLE_RGB_MATRIX_BAND_SPIRAL_VAL)
+#    define RGB_MATRIX_POLAR_EFFECTS
+#endif
+
 // reactive
 #if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE) || \
     defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE) || \
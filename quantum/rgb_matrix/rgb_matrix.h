@@ -164,6 +164,9 @@ bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
 
+// Recomputes the cached distance and angle of each LED from the center, call after moving LEDs in g_led_config
+void rgb_matrix_update_polar(void);
+
 void rgb_matrix_reload_from_eeprom(void);
 
 void        rgb_matrix_set_suspend_state(bool state);
@@ -277,3 +280,6 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_POLAR_EFFECTS
+extern led_polar_t g_led_polar[RGB_MATRIX_LED_COUNT];
+#endif
@@ -133,22 +133,32 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 };
 
 #elif defined(RGB_MATRIX_WS2812)
-#    if defined(RGBLIGHT_WS2812)
-#        pragma message "Cannot use RGBLIGHT and RGB Matrix using WS2812 at the same time."
-#        pragma message "You need to use a custom driver, or re-implement the WS2812 driver to use a different configuration."
+#    if defined(LIGHTING_SHARED_WS2812)
+#        include <string.h>
+#        include "lighting.h"
 #    endif
 
 // LED color buffer
 rgb_led_t rgb_matrix_ws2812_array[WS2812_LED_COUNT];
 bool      ws2812_dirty = false;
 
+#    if defined(LIGHTING_SHARED_WS2812)
+// The compositor reads this copy, so a frame that is still being rendered never reaches the chain
+static rgb_led_t rgb_matrix_layer[WS2812_LED_COUNT];
+#    endif
+
 static void init(void) {
     ws2812_dirty = false;
 }
 
 static void flush(void) {
     if (ws2812_dirty) {
+#    if defined(LIGHTING_SHARED_WS2812)
+        memcpy(rgb_matrix_layer, rgb_matrix_ws2812_array, sizeof(rgb_matrix_layer));
+        lighting_layer_update(LIGHTING_LAYER_RGB_MATRIX, rgb_matrix_layer, WS2812_LED_COUNT);
+#    else
         ws2812_setleds(rgb_matrix_ws2812_array, WS2812_LED_COUNT);
+#    endif
         ws2812_dirty = false;
     }
 }
@@ -0,0 +1,269 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include <lib/lib8tion/lib8tion.h>
+#include "rgb_matrix.h"
+#include "mock.h"
+
+const led_point_t k_rgb_matrix_center = {112, 32};
+
+rgb_config_t rgb_matrix_config;
+uint32_t     g_rgb_timer;
+led_config_t g_led_config;
+last_hit_t   g_last_hit_tracker;
+led_polar_t  g_led_polar[RGB_MATRIX_LED_COUNT];
+uint8_t      g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
+
+static uint16_t mock_time;
+
+uint8_t mock_leds[RGB_MATRIX_LED_COUNT][3];
+
+uint32_t mock_hsv_conversions;
+
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+    mock_hsv_conversions++;
+    return hsv_to_rgb(hsv);
+}
+
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    mock_leds[index][0] = red;
+    mock_leds[index][1] = green;
+    mock_leds[index][2] = blue;
+}
+
+void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_set_color(i, red, green, blue);
+    }
+}
+
+uint16_t timer_read(void) {
+    return mock_time;
+}
+
+uint16_t timer_elapsed(uint16_t last) {
+    return TIMER_DIFF_16(mock_time, last);
+}
+
+struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
+    return (struct rgb_matrix_limits_t){.led_min_index = 0, .led_max_index = RGB_MATRIX_LED_COUNT};
+}
+
+#include "rgb_matrix_runners.inc"
+
+#define RGB_MATRIX_EFFECT(name)
+#define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#undef RGB_MATRIX_EFFECT
+
+void mock_init(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t i                        = row * MATRIX_COLS + col;
+            g_led_config.matrix_co[row][col] = i;
+            g_led_config.point[i]            = (led_point_t){.x = col * 224 / (MATRIX_COLS - 1), .y = row * 64 / (MATRIX_ROWS - 1)};
+            g_led_config.flags[i]            = LED_FLAG_KEYLIGHT;
+        }
+    }
+
+    // Same as rgb_matrix_update_polar()
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx           = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy           = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        g_led_polar[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_polar[i].angle = atan2_8(dy, dx);
+    }
+
+    rgb_matrix_config.hsv    = (HSV){.h = 20, .s = 255, .v = 255};
+    rgb_matrix_config.speed  = 128;
+    g_rgb_timer              = 0;
+    g_last_hit_tracker.count = 0;
+    mock_time                = 0;
+}
+
+void mock_set_speed(uint8_t speed) {
+    rgb_matrix_config.speed = speed;
+}
+
+void mock_set_timer(uint32_t timer) {
+    g_rgb_timer = timer;
+}
+
+void mock_set_hit(uint8_t hit, uint8_t led, uint16_t tick) {
+    g_last_hit_tracker.x[hit]     = g_led_config.point[led].x;
+    g_last_hit_tracker.y[hit]     = g_led_config.point[led].y;
+    g_last_hit_tracker.index[hit] = led;
+    g_last_hit_tracker.tick[hit]  = tick;
+}
+
+void mock_set_hit_count(uint8_t count) {
+    g_last_hit_tracker.count = count;
+}
+
+static const reactive_splash_f reactive_math[MOCK_REACTIVE_EFFECTS] = {
+    [MOCK_SOLID_REACTIVE_WIDE]  = &SOLID_REACTIVE_WIDE_math,
+    [MOCK_SOLID_REACTIVE_CROSS] = &SOLID_REACTIVE_CROSS_math,
+    [MOCK_SOLID_REACTIVE_NEXUS] = &SOLID_REACTIVE_NEXUS_math,
+    [MOCK_SPLASH]               = &SPLASH_math,
+    [MOCK_SOLID_SPLASH]         = &SOLID_SPLASH_math,
+};
+
+static const reactive_splash_reach_f reactive_reach[MOCK_REACTIVE_EFFECTS] = {
+    [MOCK_SOLID_REACTIVE_WIDE]  = &SOLID_REACTIVE_WIDE_reach,
+    [MOCK_SOLID_REACTIVE_CROSS] = &SOLID_REACTIVE_CROSS_reach,
+    [MOCK_SOLID_REACTIVE_NEXUS] = &SOLID_REACTIVE_NEXUS_reach,
+    [MOCK_SPLASH]               = &SPLASH_reach,
+    [MOCK_SOLID_SPLASH]         = &SOLID_SPLASH_reach,
+};
+
+uint32_t mock_reactive_hits;
+
+static reactive_splash_f counted_math;
+
+static HSV counting_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    mock_reactive_hits++;
+    return counted_math(hsv, dx, dy, dist, tick);
+}
+
+void mock_render_reactive(uint8_t effect, uint8_t start, bool reach) {
+    effect_params_t params = {.iter = 0, .flags = LED_FLAG_ALL, .init = false};
+    counted_math           = reactive_math[effect];
+    effect_runner_reactive_splash_reach(start, &params, &counting_math, reach ? reactive_reach[effect] : NULL);
+}
+
+// The effect math as it was written against dx/dy, before the angle and distance were cached
+
+static HSV CYCLE_PINWHEEL_reference(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    hsv.h = atan2_8(dy, dx) + time;
+    return hsv;
+}
+
+static HSV CYCLE_SPIRAL_reference(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    uint8_t dist = sqrt16(dx * dx + dy * dy);
+    hsv.h        = dist - time - atan2_8(dy, dx);
+    return hsv;
+}
+
+static HSV BAND_PINWHEEL_VAL_reference(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    hsv.v = scale8(hsv.v - time - atan2_8(dy, dx) * 3, hsv.v);
+    return hsv;
+}
+
+static HSV BAND_SPIRAL_SAT_reference(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    uint8_t dist = sqrt16(dx * dx + dy * dy);
+    hsv.s        = scale8(hsv.s + dist - time - atan2_8(dy, dx), hsv.s);
+    return hsv;
+}
+
+void mock_render_polar(uint8_t effect, bool cached) {
+    effect_params_t params = {.iter = 0, .flags = LED_FLAG_ALL, .init = false};
+    switch (effect) {
+        case MOCK_CYCLE_PINWHEEL:
+            cached ? CYCLE_PINWHEEL(&params) : effect_runner_dx_dy(&params, &CYCLE_PINWHEEL_reference);
+            break;
+        case MOCK_CYCLE_SPIRAL:
+            cached ? CYCLE_SPIRAL(&params) : effect_runner_dx_dy(&params, &CYCLE_SPIRAL_reference);
+            break;
+        case MOCK_BAND_PINWHEEL_VAL:
+            cached ? BAND_PINWHEEL_VAL(&params) : effect_runner_dx_dy(&params, &BAND_PINWHEEL_VAL_reference);
+            break;
+        case MOCK_BAND_SPIRAL_SAT:
+            cached ? BAND_SPIRAL_SAT(&params) : effect_runner_dx_dy(&params, &BAND_SPIRAL_SAT_reference);
+            break;
+    }
+}
+
+void mock_advance_time(uint16_t ms) {
+    mock_time += ms;
+}
+
+// The typing heatmap as it was, decreasing and rendering every key of the matrix and searching all of it for neighbors
+
+static uint8_t  reference_heat[MATRIX_ROWS][MATRIX_COLS];
+static uint16_t reference_decrease_timer;
+
+static void reference_heatmap_press(uint8_t row, uint8_t col) {
+    for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
+        for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+            if (i_row == row && i_col == col) {
+                reference_heat[row][col] = qadd8(reference_heat[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+            } else {
+                led_point_t a        = g_led_config.point[g_led_config.matrix_co[row][col]];
+                led_point_t b        = g_led_config.point[g_led_config.matrix_co[i_row][i_col]];
+                uint8_t     distance = sqrt16((int16_t)(a.x - b.x) * (int16_t)(a.x - b.x) + (int16_t)(a.y - b.y) * (int16_t)(a.y - b.y));
+                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+                    }
+                    reference_heat[i_row][i_col] = qadd8(reference_heat[i_row][i_col], amount);
+                }
+            }
+        }
+    }
+}
+
+static void reference_heatmap_render(void) {
+    bool decrease = timer_elapsed(reference_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+    if (decrease) {
+        reference_decrease_timer = timer_read();
+    }
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t val = reference_heat[row][col];
+            HSV     hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+            RGB     rgb = rgb_matrix_hsv_to_rgb(hsv);
+            rgb_matrix_set_color(g_led_config.matrix_co[row][col], rgb.r, rgb.g, rgb.b);
+            if (decrease) {
+                reference_heat[row][col] = qsub8(val, 1);
+            }
+        }
+    }
+}
+
+void mock_heatmap_press(uint8_t led, bool reference) {
+    uint8_t row = led / MATRIX_COLS;
+    uint8_t col = led % MATRIX_COLS;
+    if (reference) {
+        reference_heatmap_press(row, col);
+    } else {
+        process_rgb_matrix_typing_heatmap(row, col);
+    }
+}
+
+void mock_render_heatmap(bool reference, bool init) {
+    if (reference) {
+        if (init) {
+            memset(reference_heat, 0, sizeof(reference_heat));
+            reference_decrease_timer = timer_read();
+        }
+        reference_heatmap_render();
+    } else {
+        effect_params_t params = {.iter = 0, .flags = LED_FLAG_ALL, .init = init};
+        TYPING_HEATMAP(&params);
+    }
+}
+
+uint8_t mock_heatmap_heat(uint8_t led, bool reference) {
+    uint8_t row = led / MATRIX_COLS;
+    uint8_t col = led % MATRIX_COLS;
+    return reference ? reference_heat[row][col] : g_rgb_frame_buffer[row][col];
+}
+
+uint8_t mock_heatmap_active(void) {
+    return heatmap_active_count;
+}
+
+bool mock_heatmap_rendered(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint8_t val = mock_heatmap_heat(i, false);
+        HSV     hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+        RGB     rgb = rgb_matrix_hsv_to_rgb(hsv);
+        if (mock_leds[i][0] != rgb.r || mock_leds[i][1] != rgb.g || mock_leds[i][2] != rgb.b) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+enum mock_reactive_effects {
+    MOCK_SOLID_REACTIVE_WIDE,
+    MOCK_SOLID_REACTIVE_CROSS,
+    MOCK_SOLID_REACTIVE_NEXUS,
+    MOCK_SPLASH,
+    MOCK_SOLID_SPLASH,
+    MOCK_REACTIVE_EFFECTS,
+};
+
+enum mock_polar_effects {
+    MOCK_CYCLE_PINWHEEL,
+    MOCK_CYCLE_SPIRAL,
+    MOCK_BAND_PINWHEEL_VAL,
+    MOCK_BAND_SPIRAL_SAT,
+    MOCK_POLAR_EFFECTS,
+};
+
+// Colors last set by the effects, as r, g, b
+extern uint8_t mock_leds[RGB_MATRIX_LED_COUNT][3];
+
+// Number of colors converted from HSV by the effects
+extern uint32_t mock_hsv_conversions;
+
+// Lays out the LEDs as a grid over the whole 224x64 area, and resets the effect settings
+void mock_init(void);
+
+void mock_set_speed(uint8_t speed);
+void mock_set_timer(uint32_t timer);
+void mock_set_hit(uint8_t hit, uint8_t led, uint16_t tick);
+void mock_set_hit_count(uint8_t count);
+
+// Renders a reactive effect over all LEDs, with or without skipping the hits that cannot reach a LED
+void mock_render_reactive(uint8_t effect, uint8_t start, bool reach);
+
+// Number of times a reactive effect applied a hit to a LED
+extern uint32_t mock_reactive_hits;
+
+// Renders a polar effect, either through the cached polar coordinates or the per-frame dx/dy math they replaced
+void mock_render_polar(uint8_t effect, bool cached);
+
+void mock_advance_time(uint16_t ms);
+
+// Presses the key of an LED, for the typing heatmap or the full-matrix version it replaced
+void mock_heatmap_press(uint8_t led, bool reference);
+
+// Renders the typing heatmap, or the full-matrix version it replaced
+void mock_render_heatmap(bool reference, bool init);
+
+// Heat of an LED's key, as left by the last render
+uint8_t mock_heatmap_heat(uint8_t led, bool reference);
+
+// Number of LEDs on the typing heatmap's list of LEDs with heat
+uint8_t mock_heatmap_active(void);
+
+// Whether every LED shows the color of its key's heat
+bool mock_heatmap_rendered(void);
@@ -0,0 +1,165 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "rgb_matrix/tests/mock.h"
+}
+
+static const char *reactive_names[MOCK_REACTIVE_EFFECTS] = {"SOLID_REACTIVE_WIDE", "SOLID_REACTIVE_CROSS", "SOLID_REACTIVE_NEXUS", "SPLASH", "SOLID_SPLASH"};
+
+static std::vector<uint8_t> snapshot() {
+    const uint8_t *raw = reinterpret_cast<const uint8_t *>(mock_leds);
+    return std::vector<uint8_t>(raw, raw + sizeof(mock_leds));
+}
+
+class RgbMatrixEffects : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_init();
+    }
+
+    // A full hit buffer, with ages spread from just pressed to long faded
+    void random_hits(std::mt19937 &rng, uint16_t max_tick) {
+        for (uint8_t j = 0; j < LED_HITS_TO_REMEMBER; j++) {
+            mock_set_hit(j, rng() % RGB_MATRIX_LED_COUNT, rng() % max_tick);
+        }
+        mock_set_hit_count(LED_HITS_TO_REMEMBER);
+    }
+};
+
+TEST_F(RgbMatrixEffects, ReachMatchesFullScan) {
+    std::mt19937 rng(42);
+    for (int trial = 0; trial < 500; trial++) {
+        random_hits(rng, trial % 2 ? 1000 : 400);
+        mock_set_speed(rng() % 256);
+        mock_set_timer(rng());
+
+        for (uint8_t effect = 0; effect < MOCK_REACTIVE_EFFECTS; effect++) {
+            for (uint8_t start : {(uint8_t)0, (uint8_t)(LED_HITS_TO_REMEMBER - 1)}) {
+                mock_render_reactive(effect, start, false);
+                const auto expected = snapshot();
+                memset(mock_leds, 0xAA, sizeof(mock_leds));
+                mock_render_reactive(effect, start, true);
+                ASSERT_EQ(snapshot(), expected) << reactive_names[effect] << " trial " << trial << " start " << (int)start;
+            }
+        }
+    }
+}
+
+TEST_F(RgbMatrixEffects, PolarMatchesDxDy) {
+    for (uint32_t timer = 0; timer < 20000; timer += 997) {
+        mock_set_timer(timer);
+        for (uint8_t effect = 0; effect < MOCK_POLAR_EFFECTS; effect++) {
+            mock_render_polar(effect, false);
+            const auto expected = snapshot();
+            memset(mock_leds, 0xAA, sizeof(mock_leds));
+            mock_render_polar(effect, true);
+            ASSERT_EQ(snapshot(), expected) << "effect " << (int)effect << " timer " << timer;
+        }
+    }
+}
+
+TEST_F(RgbMatrixEffects, ReachSkipsHits) {
+    std::mt19937 rng(7);
+    const int    frames = 2000;
+
+    for (uint8_t effect = 0; effect < MOCK_REACTIVE_EFFECTS; effect++) {
+        uint32_t hits[2] = {};
+        for (int reach = 0; reach < 2; reach++) {
+            rng.seed(7);
+            mock_reactive_hits = 0;
+            for (int frame = 0; frame < frames; frame++) {
+                // Steady typing: a handful of fresh hits and the rest fading or faded
+                if (frame % 50 == 0) {
+                    random_hits(rng, 2000);
+                }
+                mock_render_reactive(effect, 0, reach);
+            }
+            hits[reach] = mock_reactive_hits;
+        }
+        EXPECT_EQ(hits[0], (uint32_t)frames * RGB_MATRIX_LED_COUNT * LED_HITS_TO_REMEMBER) << reactive_names[effect];
+        EXPECT_LT(hits[1], hits[0] / 2) << reactive_names[effect];
+    }
+}
+
+TEST_F(RgbMatrixEffects, ReachSkipsFadedHits) {
+    for (uint8_t j = 0; j < LED_HITS_TO_REMEMBER; j++) {
+        mock_set_hit(j, j * 16, UINT16_MAX);
+    }
+    mock_set_hit_count(LED_HITS_TO_REMEMBER);
+
+    for (uint8_t effect = 0; effect < MOCK_REACTIVE_EFFECTS; effect++) {
+        mock_reactive_hits = 0;
+        mock_render_reactive(effect, 0, true);
+        EXPECT_EQ(mock_reactive_hits, 0) << reactive_names[effect];
+    }
+}
+
+TEST_F(RgbMatrixEffects, HeatmapMatchesFullMatrix) {
+    std::mt19937 rng(99);
+    mock_render_heatmap(true, true);
+    mock_render_heatmap(false, true);
+
+    for (int frame = 0; frame < 20000; frame++) {
+        mock_advance_time(5);
+        // Bursts of typing around one spot of the board, then pauses long enough to cool down completely
+        if ((frame / 2000) % 2 == 0 && rng() % 8 == 0) {
+            uint8_t led = ((rng() % 3 + frame / 4000 * 2) * MATRIX_COLS + rng() % MATRIX_COLS) % RGB_MATRIX_LED_COUNT;
+            mock_heatmap_press(led, true);
+            mock_heatmap_press(led, false);
+        }
+        mock_render_heatmap(true, false);
+        mock_render_heatmap(false, false);
+        ASSERT_TRUE(mock_heatmap_rendered()) << "frame " << frame;
+
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            ASSERT_NEAR(mock_heatmap_heat(i, false), mock_heatmap_heat(i, true), 1) << "LED " << (int)i << " frame " << frame;
+        }
+    }
+}
+
+TEST_F(RgbMatrixEffects, HeatmapOnlyVisitsLitLeds) {
+    std::mt19937 rng(3);
+    mock_render_heatmap(false, true);
+
+    for (int frame = 0; frame < 20000; frame++) {
+        mock_advance_time(5);
+        // Around eight keys a second
+        if (rng() % 25 == 0) {
+            mock_heatmap_press(rng() % RGB_MATRIX_LED_COUNT, false);
+        }
+
+        // Every LED listed has heat, and every LED with heat is listed
+        uint8_t lit = 0;
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            lit += mock_heatmap_heat(i, false) != 0;
+        }
+        ASSERT_EQ(mock_heatmap_active(), lit) << "frame " << frame;
+
+        mock_hsv_conversions = 0;
+        mock_render_heatmap(false, false);
+
+        // Only the LEDs still lit after the decrease are rendered
+        lit = 0;
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            lit += mock_heatmap_heat(i, false) != 0;
+        }
+        ASSERT_EQ(mock_hsv_conversions, lit) << "frame " << frame;
+        ASSERT_EQ(mock_heatmap_active(), lit) << "frame " << frame;
+    }
+
+    // Once the board has cooled down, nothing is left to visit
+    for (int frame = 0; frame < 2000; frame++) {
+        mock_advance_time(5);
+        mock_render_heatmap(false, false);
+    }
+    mock_hsv_conversions = 0;
+    mock_render_heatmap(false, false);
+    EXPECT_EQ(mock_heatmap_active(), 0);
+    EXPECT_EQ(mock_hsv_conversions, 0);
+}
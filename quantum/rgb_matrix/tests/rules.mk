@@ -0,0 +1,8 @@
+rgb_matrix_effects_DEFS := -DRGB_MATRIX_ENABLE
+rgb_matrix_effects_INC := $(QUANTUM_PATH)/rgb_matrix $(QUANTUM_PATH)/rgb_matrix/animations $(QUANTUM_PATH)/rgb_matrix/animations/runners
+rgb_matrix_effects_CONFIG := $(QUANTUM_PATH)/rgb_matrix/tests/config_mock.h
+
+rgb_matrix_effects_SRC := \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/rgb_matrix/tests/mock.c \
+	$(QUANTUM_PATH)/rgb_matrix/tests/rgb_matrix_effects_tests.cpp
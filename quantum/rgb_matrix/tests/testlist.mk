@@ -0,0 +1 @@
+TEST_LIST += rgb_matrix_effects
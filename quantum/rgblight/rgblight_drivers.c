@@ -3,7 +3,24 @@
 
 #include "rgblight_drivers.h"
 
-#if defined(RGBLIGHT_WS2812)
+#if defined(RGBLIGHT_WS2812) && defined(LIGHTING_SHARED_WS2812)
+#    include <string.h>
+#    include "rgblight.h"
+#    include "lighting.h"
+
+// The chain is shared with RGB Matrix, so the LEDs are kept for the compositor rather than sent straight away
+static rgb_led_t rgblight_layer[RGBLIGHT_LED_COUNT];
+
+static void setleds(rgb_led_t *ledarray, uint16_t number_of_leds) {
+    memcpy(rgblight_layer, ledarray, number_of_leds * sizeof(rgb_led_t));
+    lighting_layer_update(LIGHTING_LAYER_RGBLIGHT, rgblight_layer, number_of_leds);
+}
+
+const rgblight_driver_t rgblight_driver = {
+    .setleds = setleds,
+};
+
+#elif defined(RGBLIGHT_WS2812)
 #    include "ws2812.h"
 
 const rgblight_driver_t rgblight_driver = {
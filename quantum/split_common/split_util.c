@@ -119,6 +119,26 @@ void split_watchdog_task(void) {
 }
 #endif // defined(SPLIT_WATCHDOG_ENABLE)
 
+#if defined(SPLIT_MATRIX_EVENT_ENABLE) && defined(SPLIT_MATRIX_EVENT_PIN)
+// The event line idles high on the pull-ups, the slave pulls it low while the master has yet to read a change of its matrix
+__attribute__((weak)) void split_matrix_event_init(void) {
+    gpio_set_pin_input_high(SPLIT_MATRIX_EVENT_PIN);
+}
+
+__attribute__((weak)) void split_matrix_event_signal(bool pending) {
+    if (pending) {
+        gpio_set_pin_output(SPLIT_MATRIX_EVENT_PIN);
+        gpio_write_pin_low(SPLIT_MATRIX_EVENT_PIN);
+    } else {
+        gpio_set_pin_input_high(SPLIT_MATRIX_EVENT_PIN);
+    }
+}
+
+__attribute__((weak)) bool split_matrix_event_pending(void) {
+    return !gpio_read_pin(SPLIT_MATRIX_EVENT_PIN);
+}
+#endif // defined(SPLIT_MATRIX_EVENT_ENABLE) && defined(SPLIT_MATRIX_EVENT_PIN)
+
 #ifdef SPLIT_HAND_MATRIX_GRID
 void matrix_io_delay(void);
 
@@ -214,6 +234,9 @@ void split_pre_init(void) {
 
     if (is_keyboard_master()) {
         transport_master_init();
+#if defined(SPLIT_MATRIX_EVENT_ENABLE)
+        split_matrix_event_init();
+#endif
     }
 }
 
@@ -225,6 +248,9 @@ void split_post_init(void) {
         transport_slave_init();
 #if defined(SPLIT_WATCHDOG_ENABLE)
         split_watchdog_init();
+#endif
+#if defined(SPLIT_MATRIX_EVENT_ENABLE)
+        split_matrix_event_init();
 #endif
     }
 }
@@ -15,4 +15,8 @@ bool is_transport_connected(void);
 
 void split_watchdog_update(bool done);
 void split_watchdog_task(void);
-bool split_watchdog_check(void);
\ No newline at end of file
+bool split_watchdog_check(void);
+
+void split_matrix_event_init(void);
+void split_matrix_event_signal(bool pending);
+bool split_matrix_event_pending(void);
@@ -71,6 +71,20 @@
 #    define FORCED_SYNC_THROTTLE_MS 100
 #endif // FORCED_SYNC_THROTTLE_MS
 
+// Bytes on the wire per pass of transactions_master(), after which lower priority syncs wait for the next pass
+#ifndef SPLIT_TRANSACTION_BUDGET
+#    define SPLIT_TRANSACTION_BUDGET 32
+#endif // SPLIT_TRANSACTION_BUDGET
+
+// How long in ms a lower priority sync waits at most, after which it runs even on a congested link
+#ifndef SPLIT_SYNC_MAX_DELAY
+#    define SPLIT_SYNC_MAX_DELAY 100
+#endif // SPLIT_SYNC_MAX_DELAY
+
+#ifndef SPLIT_SYNC_STATS_INTERVAL
+#    define SPLIT_SYNC_STATS_INTERVAL 10000
+#endif // SPLIT_SYNC_STATS_INTERVAL
+
 #define sizeof_member(type, member) sizeof(((type *)NULL)->member)
 
 #define trans_initiator2target_initializer_cb(member, cb) \
@@ -84,23 +98,39 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#define trans_bidirectional_initializer_cb(initiator2target_member, target2initiator_member, cb) \
+    { sizeof_member(split_shared_memory_t, initiator2target_member), offsetof(split_shared_memory_t, initiator2target_member), sizeof_member(split_shared_memory_t, target2initiator_member), offsetof(split_shared_memory_t, target2initiator_member), cb }
+
+#define transport_write(id, data, length) transaction_execute(id, data, length, NULL, 0)
+#define transport_read(id, data, length) transaction_execute(id, NULL, 0, data, length)
+#define transport_exec(id) transaction_execute(id, NULL, 0, NULL, 0)
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+void slave_rpc_stream_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 ////////////////////////////////////////////////////
 // Helpers
 
+// Bytes sent and received during the current pass of transactions_master()
+static uint16_t pass_bytes = 0;
+// Set once a transaction needed a retry during the current pass
+static bool pass_congested = false;
+
+static inline bool transaction_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    // The transaction id and the handshake take a byte each
+    pass_bytes += 2 + initiator2target_length + target2initiator_length;
+    return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+
 static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])) {
     int num_retries = is_transport_connected() ? 10 : 1;
     for (int iter = 1; iter <= num_retries; ++iter) {
         if (iter > 1) {
+            pass_congested = true;
             for (int i = 0; i < iter * iter; ++i) {
                 wait_us(10);
             }
@@ -118,6 +148,119 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         if (!transaction_handler_master(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master)) return false; \
     } while (0)
 
+// State of a lower priority sync, kept by TRANSACTION_HANDLER_MASTER_SCHEDULED()
+typedef struct split_sync_state_t {
+    uint32_t last_run;
+    uint32_t deferred_since;
+    bool     deferred;
+#ifdef DEBUG_SPLIT_SYNC
+    const char                *name;
+    struct split_sync_state_t *next;
+    uint16_t                   runs;
+    uint16_t                   deferrals;
+    uint16_t                   failures;
+    uint16_t                   max_delay;
+#endif // DEBUG_SPLIT_SYNC
+} split_sync_state_t;
+
+#ifdef DEBUG_SPLIT_SYNC
+static split_sync_state_t *sync_states      = NULL;
+static uint16_t            max_pass_bytes   = 0;
+static uint16_t            congested_passes = 0;
+#endif // DEBUG_SPLIT_SYNC
+
+/**
+ * @brief Runs a lower priority sync, unless it ran less than interval ms ago.
+ *
+ * It is held back until the next pass once the transactions of this pass
+ * went over SPLIT_TRANSACTION_BUDGET, or as soon as one of them needed a
+ * retry. A sync that has been held back goes ahead on the next pass even over
+ * the budget, so that none of them is starved - congestion still holds it
+ * back though, to let the link recover, but for no longer than
+ * SPLIT_SYNC_MAX_DELAY.
+ */
+static bool transaction_handler_master_scheduled(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]), split_sync_state_t *state, uint16_t interval) {
+#ifdef DEBUG_SPLIT_SYNC
+    if (!state->name) {
+        state->name = prefix;
+        state->next = sync_states;
+        sync_states = state;
+    }
+#endif // DEBUG_SPLIT_SYNC
+
+    if (interval > 0 && timer_elapsed32(state->last_run) < interval) {
+        return true;
+    }
+
+    bool overdue = state->deferred && timer_elapsed32(state->deferred_since) >= SPLIT_SYNC_MAX_DELAY;
+    if (!overdue && (pass_congested || (pass_bytes >= SPLIT_TRANSACTION_BUDGET && !state->deferred))) {
+        if (!state->deferred) {
+            state->deferred       = true;
+            state->deferred_since = timer_read32();
+#ifdef DEBUG_SPLIT_SYNC
+            state->deferrals++;
+#endif // DEBUG_SPLIT_SYNC
+        }
+        return true;
+    }
+
+    bool okay = transaction_handler_master(master_matrix, slave_matrix, prefix, handler);
+#ifdef DEBUG_SPLIT_SYNC
+    state->runs++;
+    if (!okay) {
+        state->failures++;
+    }
+    if (state->deferred && timer_elapsed32(state->deferred_since) > state->max_delay) {
+        state->max_delay = timer_elapsed32(state->deferred_since);
+    }
+#endif // DEBUG_SPLIT_SYNC
+    if (okay) {
+        state->deferred = false;
+        state->last_run = timer_read32();
+    }
+    return okay;
+}
+
+#define TRANSACTION_HANDLER_MASTER_SCHEDULED(prefix, interval)                                                                                                      \
+    do {                                                                                                                                                            \
+        static split_sync_state_t prefix##_sync_state = {0};                                                                                                        \
+        if (!transaction_handler_master_scheduled(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master, &prefix##_sync_state, (interval))) return false; \
+    } while (0)
+
+#ifdef DEBUG_SPLIT_SYNC
+/**
+ * @brief Prints what the lower priority syncs went through since the last
+ * time, every SPLIT_SYNC_STATS_INTERVAL ms.
+ */
+static void transactions_stats_task(void) {
+    static uint32_t last_print = 0;
+
+    if (pass_bytes > max_pass_bytes) {
+        max_pass_bytes = pass_bytes;
+    }
+    if (pass_congested) {
+        congested_passes++;
+    }
+    if (timer_elapsed32(last_print) < SPLIT_SYNC_STATS_INTERVAL) {
+        return;
+    }
+    last_print = timer_read32();
+
+    dprintf("split sync: %u bytes in the busiest pass, budget %u, %u congested passes\n", max_pass_bytes, SPLIT_TRANSACTION_BUDGET, congested_passes);
+    for (split_sync_state_t *state = sync_states; state; state = state->next) {
+        dprintf("split sync: %s ran %u times, held back %u times for at most %ums, failed %u times\n", state->name, state->runs, state->deferrals, state->max_delay, state->failures);
+        state->runs      = 0;
+        state->deferrals = 0;
+        state->failures  = 0;
+        state->max_delay = 0;
+    }
+    max_pass_bytes   = 0;
+    congested_passes = 0;
+}
+#else
+#    define transactions_stats_task()
+#endif // DEBUG_SPLIT_SYNC
+
 /**
  * @brief Constructs a transaction handler that doesn't acquire a lock to the
  * split shared memory. Therefore the locking and unlocking has to be done
@@ -178,6 +321,62 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_EVENT_ENABLE
+
+#    ifndef SPLIT_MATRIX_EVENT_CHECK_INTERVAL
+#        define SPLIT_MATRIX_EVENT_CHECK_INTERVAL 500
+#    endif // SPLIT_MATRIX_EVENT_CHECK_INTERVAL
+
+/**
+ * @brief Reads the slave matrix only once the slave signalled a change on the
+ * event line, and every SPLIT_MATRIX_EVENT_CHECK_INTERVAL ms in case a change
+ * went unnoticed. The checksum and the matrix come in a single transaction.
+ */
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t                  last_update = 0;
+    static bool                      okay        = false; // read again after a failure, the slave already dropped the event line
+    static split_slave_matrix_sync_t last_smatrix = {0};
+    split_slave_matrix_sync_t        temp_smatrix;
+
+    if (okay && !split_matrix_event_pending() && timer_elapsed32(last_update) < SPLIT_MATRIX_EVENT_CHECK_INTERVAL) {
+        memcpy(slave_matrix, last_smatrix.matrix, sizeof(last_smatrix.matrix));
+        return true;
+    }
+
+    okay = transport_read(GET_SLAVE_MATRIX, &temp_smatrix, sizeof(temp_smatrix));
+    okay &= temp_smatrix.checksum == crc8(temp_smatrix.matrix, sizeof(temp_smatrix.matrix));
+    if (okay) {
+        last_update = timer_read32();
+        memcpy(&last_smatrix, &temp_smatrix, sizeof(temp_smatrix));
+    }
+    memcpy(slave_matrix, last_smatrix.matrix, sizeof(last_smatrix.matrix));
+    return okay;
+}
+
+static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static bool initialized = false;
+    if (!initialized || memcmp(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix)) != 0) {
+        initialized = true;
+        memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
+        split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+        split_matrix_event_signal(true);
+    }
+}
+
+// The master is about to get the current matrix
+static void slave_matrix_event_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    split_matrix_event_signal(false);
+}
+
+// clang-format off
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+    [GET_SLAVE_MATRIX] = trans_target2initiator_initializer_cb(smatrix, slave_matrix_event_callback),
+// clang-format on
+
+#else // SPLIT_MATRIX_EVENT_ENABLE
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -199,13 +398,15 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 }
 
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+#endif // SPLIT_MATRIX_EVENT_ENABLE
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -318,7 +519,8 @@ static void sync_timer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     }
 }
 
-#    define TRANSACTIONS_SYNC_TIMER_MASTER() TRANSACTION_HANDLER_MASTER(sync_timer)
+// Throttled by the handler itself
+#    define TRANSACTIONS_SYNC_TIMER_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(sync_timer, 0)
 #    define TRANSACTIONS_SYNC_TIMER_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(sync_timer)
 #    define TRANSACTIONS_SYNC_TIMER_REGISTRATIONS [PUT_SYNC_TIMER] = trans_initiator2target_initializer(sync_timer),
 
@@ -352,7 +554,10 @@ static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 }
 
 // clang-format off
-#    define TRANSACTIONS_LAYER_STATE_MASTER() TRANSACTION_HANDLER_MASTER(layer_state)
+#    ifndef SPLIT_LAYER_STATE_SYNC_INTERVAL
+#        define SPLIT_LAYER_STATE_SYNC_INTERVAL 0
+#    endif // SPLIT_LAYER_STATE_SYNC_INTERVAL
+#    define TRANSACTIONS_LAYER_STATE_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(layer_state, SPLIT_LAYER_STATE_SYNC_INTERVAL)
 #    define TRANSACTIONS_LAYER_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(layer_state)
 #    define TRANSACTIONS_LAYER_STATE_REGISTRATIONS \
     [PUT_LAYER_STATE]         = trans_initiator2target_initializer(layers.layer_state), \
@@ -383,7 +588,10 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     set_split_host_keyboard_leds(split_shmem->led_state);
 }
 
-#    define TRANSACTIONS_LED_STATE_MASTER() TRANSACTION_HANDLER_MASTER(led_state)
+#    ifndef SPLIT_LED_STATE_SYNC_INTERVAL
+#        define SPLIT_LED_STATE_SYNC_INTERVAL 0
+#    endif // SPLIT_LED_STATE_SYNC_INTERVAL
+#    define TRANSACTIONS_LED_STATE_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(led_state, SPLIT_LED_STATE_SYNC_INTERVAL)
 #    define TRANSACTIONS_LED_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(led_state)
 #    define TRANSACTIONS_LED_STATE_REGISTRATIONS [PUT_LED_STATE] = trans_initiator2target_initializer(led_state),
 
@@ -476,7 +684,10 @@ static void backlight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     backlight_level_noeeprom(backlight_level);
 }
 
-#    define TRANSACTIONS_BACKLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(backlight)
+#    ifndef SPLIT_BACKLIGHT_SYNC_INTERVAL
+#        define SPLIT_BACKLIGHT_SYNC_INTERVAL 0
+#    endif // SPLIT_BACKLIGHT_SYNC_INTERVAL
+#    define TRANSACTIONS_BACKLIGHT_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(backlight, SPLIT_BACKLIGHT_SYNC_INTERVAL)
 #    define TRANSACTIONS_BACKLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(backlight)
 #    define TRANSACTIONS_BACKLIGHT_REGISTRATIONS [PUT_BACKLIGHT] = trans_initiator2target_initializer(backlight_level),
 
@@ -518,7 +729,10 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     }
 }
 
-#    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(rgblight)
+#    ifndef SPLIT_RGBLIGHT_SYNC_INTERVAL
+#        define SPLIT_RGBLIGHT_SYNC_INTERVAL 0
+#    endif // SPLIT_RGBLIGHT_SYNC_INTERVAL
+#    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rgblight, SPLIT_RGBLIGHT_SYNC_INTERVAL)
 #    define TRANSACTIONS_RGBLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(rgblight)
 #    define TRANSACTIONS_RGBLIGHT_REGISTRATIONS [PUT_RGBLIGHT] = trans_initiator2target_initializer(rgblight_sync),
 
@@ -552,7 +766,10 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     led_matrix_set_suspend_state(led_suspend_state);
 }
 
-#    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(led_matrix)
+#    ifndef SPLIT_LED_MATRIX_SYNC_INTERVAL
+#        define SPLIT_LED_MATRIX_SYNC_INTERVAL 0
+#    endif // SPLIT_LED_MATRIX_SYNC_INTERVAL
+#    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(led_matrix, SPLIT_LED_MATRIX_SYNC_INTERVAL)
 #    define TRANSACTIONS_LED_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(led_matrix)
 #    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer(led_matrix_sync),
 
@@ -586,7 +803,10 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     rgb_matrix_set_suspend_state(rgb_suspend_state);
 }
 
-#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
+#    ifndef SPLIT_RGB_MATRIX_SYNC_INTERVAL
+#        define SPLIT_RGB_MATRIX_SYNC_INTERVAL 0
+#    endif // SPLIT_RGB_MATRIX_SYNC_INTERVAL
+#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rgb_matrix, SPLIT_RGB_MATRIX_SYNC_INTERVAL)
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
 #    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
 
@@ -613,7 +833,10 @@ static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_
     set_current_wpm(split_shmem->current_wpm);
 }
 
-#    define TRANSACTIONS_WPM_MASTER() TRANSACTION_HANDLER_MASTER(wpm)
+#    ifndef SPLIT_WPM_SYNC_INTERVAL
+#        define SPLIT_WPM_SYNC_INTERVAL 0
+#    endif // SPLIT_WPM_SYNC_INTERVAL
+#    define TRANSACTIONS_WPM_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(wpm, SPLIT_WPM_SYNC_INTERVAL)
 #    define TRANSACTIONS_WPM_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(wpm)
 #    define TRANSACTIONS_WPM_REGISTRATIONS [PUT_WPM] = trans_initiator2target_initializer(current_wpm),
 
@@ -648,7 +871,10 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
     }
 }
 
-#    define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER(oled)
+#    ifndef SPLIT_OLED_SYNC_INTERVAL
+#        define SPLIT_OLED_SYNC_INTERVAL 0
+#    endif // SPLIT_OLED_SYNC_INTERVAL
+#    define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(oled, SPLIT_OLED_SYNC_INTERVAL)
 #    define TRANSACTIONS_OLED_SLAVE() TRANSACTION_HANDLER_SLAVE(oled)
 #    define TRANSACTIONS_OLED_REGISTRATIONS [PUT_OLED] = trans_initiator2target_initializer(current_oled_state),
 
@@ -683,7 +909,10 @@ static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
     }
 }
 
-#    define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER(st7565)
+#    ifndef SPLIT_ST7565_SYNC_INTERVAL
+#        define SPLIT_ST7565_SYNC_INTERVAL 0
+#    endif // SPLIT_ST7565_SYNC_INTERVAL
+#    define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(st7565, SPLIT_ST7565_SYNC_INTERVAL)
 #    define TRANSACTIONS_ST7565_SLAVE() TRANSACTION_HANDLER_SLAVE(st7565)
 #    define TRANSACTIONS_ST7565_REGISTRATIONS [PUT_ST7565] = trans_initiator2target_initializer(current_st7565_state),
 
@@ -838,7 +1067,10 @@ static void haptic_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
 }
 
 // clang-format off
-#    define TRANSACTIONS_HAPTIC_MASTER() TRANSACTION_HANDLER_MASTER(haptic)
+#    ifndef SPLIT_HAPTIC_SYNC_INTERVAL
+#        define SPLIT_HAPTIC_SYNC_INTERVAL 0
+#    endif // SPLIT_HAPTIC_SYNC_INTERVAL
+#    define TRANSACTIONS_HAPTIC_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(haptic, SPLIT_HAPTIC_SYNC_INTERVAL)
 #    define TRANSACTIONS_HAPTIC_SLAVE() TRANSACTION_HANDLER_SLAVE(haptic)
 #    define TRANSACTIONS_HAPTIC_REGISTRATIONS [PUT_HAPTIC] = trans_initiator2target_initializer(haptic_sync),
 // clang-format on
@@ -867,7 +1099,10 @@ static void activity_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 }
 
 // clang-format off
-#    define TRANSACTIONS_ACTIVITY_MASTER() TRANSACTION_HANDLER_MASTER(activity)
+#    ifndef SPLIT_ACTIVITY_SYNC_INTERVAL
+#        define SPLIT_ACTIVITY_SYNC_INTERVAL 0
+#    endif // SPLIT_ACTIVITY_SYNC_INTERVAL
+#    define TRANSACTIONS_ACTIVITY_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(activity, SPLIT_ACTIVITY_SYNC_INTERVAL)
 #    define TRANSACTIONS_ACTIVITY_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(activity)
 #    define TRANSACTIONS_ACTIVITY_REGISTRATIONS [PUT_ACTIVITY] = trans_initiator2target_initializer(activity_sync),
 // clang-format on
@@ -896,7 +1131,10 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
     slave_update_detected_host_os(split_shmem->detected_os);
 }
 
-#    define TRANSACTIONS_DETECTED_OS_MASTER() TRANSACTION_HANDLER_MASTER(detected_os)
+#    ifndef SPLIT_DETECTED_OS_SYNC_INTERVAL
+#        define SPLIT_DETECTED_OS_SYNC_INTERVAL 0
+#    endif // SPLIT_DETECTED_OS_SYNC_INTERVAL
+#    define TRANSACTIONS_DETECTED_OS_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(detected_os, SPLIT_DETECTED_OS_SYNC_INTERVAL)
 #    define TRANSACTIONS_DETECTED_OS_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(detected_os)
 #    define TRANSACTIONS_DETECTED_OS_REGISTRATIONS [PUT_DETECTED_OS] = trans_initiator2target_initializer(detected_os),
 
@@ -908,6 +1146,124 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// Streamed RPC
+
+#if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+// Answers of the slave to a chunk, far enough apart that a flipped bit does not turn one into another
+enum {
+    RPC_STREAM_RESEND = 0x00,
+    RPC_STREAM_ACK    = 0x3C,
+    RPC_STREAM_BUSY   = 0xC3,
+    RPC_STREAM_ABORT  = 0x5A,
+};
+
+static struct {
+    const uint8_t    *buffer;
+    uint16_t          length;
+    uint16_t          offset;
+    int8_t            transaction_id;
+    uint8_t           stream;
+    bool              stream_known; // whether stream follows on from the slave's, rather than from before a restart or a disconnect
+    rpc_stream_done_t done;
+} rpc_stream_master = {0};
+
+static void rpc_stream_finish(bool success) {
+    rpc_stream_done_t done = rpc_stream_master.done;
+
+    rpc_stream_master.buffer = NULL;
+    if (done) {
+        done(rpc_stream_master.transaction_id, success);
+    }
+}
+
+static uint8_t rpc_stream_checksum(const rpc_stream_chunk_t *chunk) {
+    return crc8(&chunk->transaction_id, offsetof(rpc_stream_chunk_t, data) + RPC_STREAM_CHUNK_SIZE - offsetof(rpc_stream_chunk_t, transaction_id));
+}
+
+// Run ahead of every other transaction, which stop the pass early while the halves are disconnected
+static void rpc_stream_check_connected(void) {
+    if (is_transport_connected()) {
+        return;
+    }
+    // The slave may have restarted in the meantime
+    rpc_stream_master.stream_known = false;
+    if (rpc_stream_master.buffer) {
+        rpc_stream_finish(false);
+    }
+}
+
+// Asks the slave which stream it is in, so that the next one cannot be taken for a resend of it
+static bool rpc_stream_probe(void) {
+    rpc_stream_chunk_t  chunk = {.transaction_id = rpc_stream_master.transaction_id};
+    rpc_stream_status_t status;
+    chunk.checksum = rpc_stream_checksum(&chunk);
+
+    if (!transaction_execute(PUT_RPC_STREAM, &chunk, sizeof(chunk), &status, sizeof(status)) || status.status != RPC_STREAM_ACK) {
+        return false;
+    }
+    rpc_stream_master.stream       = status.stream + 1;
+    rpc_stream_master.stream_known = true;
+    return true;
+}
+
+static bool rpc_stream_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (!rpc_stream_master.buffer) {
+        return true;
+    }
+    if (!rpc_stream_master.stream_known && !rpc_stream_probe()) {
+        return false;
+    }
+
+    // One chunk per transaction, as many as fit in the budget, and at least one per pass
+    do {
+        rpc_stream_chunk_t  chunk  = {.transaction_id = rpc_stream_master.transaction_id, .offset = rpc_stream_master.offset, .length = rpc_stream_master.length, .stream = rpc_stream_master.stream};
+        uint16_t            length = MIN(rpc_stream_master.length - rpc_stream_master.offset, RPC_STREAM_CHUNK_SIZE);
+        rpc_stream_status_t status;
+        memcpy(chunk.data, rpc_stream_master.buffer + rpc_stream_master.offset, length);
+        chunk.checksum = rpc_stream_checksum(&chunk);
+
+        if (!transaction_execute(PUT_RPC_STREAM, &chunk, sizeof(chunk), &status, sizeof(status))) {
+            return false;
+        }
+        switch (status.status) {
+            case RPC_STREAM_ACK:
+                rpc_stream_master.offset += length;
+                break;
+            case RPC_STREAM_BUSY:
+                // The slave cannot take more yet, the same chunk goes again next pass
+                return true;
+            case RPC_STREAM_ABORT:
+                rpc_stream_finish(false);
+                return true;
+            default:
+                // Garbled on the way, retried like any other failed transaction
+                return false;
+        }
+    } while (rpc_stream_master.offset < rpc_stream_master.length && pass_bytes < SPLIT_TRANSACTION_BUDGET);
+
+    if (rpc_stream_master.offset >= rpc_stream_master.length) {
+        rpc_stream_finish(true);
+    }
+    return true;
+}
+
+#    ifndef SPLIT_RPC_STREAM_SYNC_INTERVAL
+#        define SPLIT_RPC_STREAM_SYNC_INTERVAL 0
+#    endif // SPLIT_RPC_STREAM_SYNC_INTERVAL
+#    define TRANSACTIONS_RPC_STREAM_CHECK_CONNECTED() rpc_stream_check_connected()
+#    define TRANSACTIONS_RPC_STREAM_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rpc_stream, SPLIT_RPC_STREAM_SYNC_INTERVAL)
+#    define TRANSACTIONS_RPC_STREAM_REGISTRATIONS [PUT_RPC_STREAM] = trans_bidirectional_initializer_cb(rpc_stream, rpc_stream_status, slave_rpc_stream_callback),
+
+#else // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+#    define TRANSACTIONS_RPC_STREAM_CHECK_CONNECTED()
+#    define TRANSACTIONS_RPC_STREAM_MASTER()
+#    define TRANSACTIONS_RPC_STREAM_REGISTRATIONS
+
+#endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -938,6 +1294,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_RPC_STREAM_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -949,13 +1306,24 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    pass_bytes     = 0;
+    pass_congested = false;
+
+    // A stream does not carry on after a disconnect, the slave may have restarted in the meantime
+    TRANSACTIONS_RPC_STREAM_CHECK_CONNECTED();
+
+    // Input goes first and always runs, key presses should not wait for lighting or displays
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
+    TRANSACTIONS_MODS_MASTER();
+    TRANSACTIONS_POINTING_MASTER();
+    TRANSACTIONS_WATCHDOG_MASTER();
+
+    // The rest gets what is left of SPLIT_TRANSACTION_BUDGET
     TRANSACTIONS_SYNC_TIMER_MASTER();
     TRANSACTIONS_LAYER_STATE_MASTER();
     TRANSACTIONS_LED_STATE_MASTER();
-    TRANSACTIONS_MODS_MASTER();
     TRANSACTIONS_BACKLIGHT_MASTER();
     TRANSACTIONS_RGBLIGHT_MASTER();
     TRANSACTIONS_LED_MATRIX_MASTER();
@@ -963,11 +1331,12 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
-    TRANSACTIONS_POINTING_MASTER();
-    TRANSACTIONS_WATCHDOG_MASTER();
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_RPC_STREAM_MASTER();
+
+    transactions_stats_task();
     return true;
 }
 
@@ -997,7 +1366,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
 
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback) {
     // Prevent invoking RPC on QMK core sync data
-    if (transaction_id <= GET_RPC_RESP_DATA) return;
+    if (transaction_id <= PUT_RPC_STREAM) return;
 
     // Set the callback
     split_transaction_table[transaction_id].slave_callback          = callback;
@@ -1011,7 +1380,7 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
         return false;
     }
     // Prevent invoking RPC on QMK core sync data
-    if (transaction_id <= GET_RPC_RESP_DATA) return false;
+    if (transaction_id <= PUT_RPC_STREAM) return false;
     // Prevent sizing issues
     if (initiator2target_buffer_size > RPC_M2S_BUFFER_SIZE) return false;
     if (target2initiator_buffer_size > RPC_S2M_BUFFER_SIZE) return false;
@@ -1070,4 +1439,82 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
     }
 }
 
+static rpc_stream_callback_t rpc_stream_callbacks[NUM_TOTAL_TRANSACTIONS - PUT_RPC_STREAM - 1] = {0};
+
+void transaction_register_rpc_stream(int8_t transaction_id, rpc_stream_callback_t callback) {
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id <= PUT_RPC_STREAM || transaction_id >= NUM_TOTAL_TRANSACTIONS) return;
+
+    rpc_stream_callbacks[transaction_id - PUT_RPC_STREAM - 1] = callback;
+}
+
+bool transaction_rpc_stream(int8_t transaction_id, const void *buffer, uint16_t length, rpc_stream_done_t done) {
+    // Prevent transaction attempts while transport is disconnected
+    if (!is_transport_connected()) {
+        return false;
+    }
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id <= PUT_RPC_STREAM) return false;
+    // One stream at a time
+    if (rpc_stream_master.buffer || !buffer || length == 0) return false;
+
+    // The buffer is sent from transactions_master(), a chunk or more per pass, and has to stay valid until done is called
+    rpc_stream_master.buffer         = buffer;
+    rpc_stream_master.length         = length;
+    rpc_stream_master.offset         = 0;
+    rpc_stream_master.transaction_id = transaction_id;
+    rpc_stream_master.done           = done;
+    rpc_stream_master.stream++;
+    return true;
+}
+
+bool transaction_rpc_stream_busy(void) {
+    return rpc_stream_master.buffer != NULL;
+}
+
+void slave_rpc_stream_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // Where the current stream is at, so that a chunk sent again after a lost answer is not handed out twice
+    static uint8_t  stream   = 0;
+    static uint16_t expected = 0;
+
+    const rpc_stream_chunk_t *chunk  = &split_shmem->rpc_stream;
+    rpc_stream_status_t      *status = &split_shmem->rpc_stream_status;
+    if (rpc_stream_checksum(chunk) != chunk->checksum) {
+        status->status = RPC_STREAM_RESEND;
+        return;
+    }
+
+    if (chunk->length == 0) {
+        // The master asks which stream this is, see rpc_stream_probe()
+        status->status = RPC_STREAM_ACK;
+        status->stream = stream;
+        return;
+    }
+    if (chunk->stream != stream) {
+        stream   = chunk->stream;
+        expected = 0;
+    } else if (chunk->offset < expected) {
+        status->status = RPC_STREAM_ACK;
+        return;
+    }
+
+    int8_t                transaction_id = chunk->transaction_id;
+    rpc_stream_callback_t callback       = NULL;
+    if (transaction_id > PUT_RPC_STREAM && transaction_id < NUM_TOTAL_TRANSACTIONS) {
+        callback = rpc_stream_callbacks[transaction_id - PUT_RPC_STREAM - 1];
+    }
+    if (!callback || chunk->offset != expected || chunk->offset >= chunk->length) {
+        status->status = RPC_STREAM_ABORT;
+        return;
+    }
+
+    uint8_t length = MIN(chunk->length - chunk->offset, RPC_STREAM_CHUNK_SIZE);
+    if (!callback(transaction_id, chunk->offset, chunk->data, length, chunk->length)) {
+        status->status = RPC_STREAM_BUSY;
+        return;
+    }
+    expected += length;
+    status->status = RPC_STREAM_ACK;
+}
+
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
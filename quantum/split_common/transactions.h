@@ -49,5 +49,15 @@ void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 
+// Slave side handler of a streamed RPC, gets the chunks in order. Returns false to have the master send the chunk again later.
+typedef bool (*rpc_stream_callback_t)(int8_t transaction_id, uint16_t offset, const void *data, uint8_t length, uint16_t total_length);
+// Master side, called once the last chunk is in or the stream failed
+typedef void (*rpc_stream_done_t)(int8_t transaction_id, bool success);
+
+void transaction_register_rpc_stream(int8_t transaction_id, rpc_stream_callback_t callback);
+
+bool transaction_rpc_stream(int8_t transaction_id, const void *buffer, uint16_t length, rpc_stream_done_t done);
+bool transaction_rpc_stream_busy(void);
+
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
@@ -100,6 +100,8 @@ void transport_slave_init(void) {
     soft_serial_target_init();
 }
 
+__attribute__((weak)) void soft_serial_target_task(void) {}
+
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
@@ -126,5 +128,8 @@ bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])
 }
 
 void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifndef USE_I2C
+    soft_serial_target_task();
+#endif // USE_I2C
     transactions_slave(master_matrix, slave_matrix);
 }
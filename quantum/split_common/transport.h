@@ -140,6 +140,26 @@ typedef struct _rpc_sync_info_t {
         uint8_t s2m_length;
     } payload;
 } rpc_sync_info_t;
+
+// A chunk of a streamed RPC, takes the place of the RPC request buffer, with its first 7 bytes for the checksum, the stream number and the position
+#    define RPC_STREAM_CHUNK_SIZE (RPC_M2S_BUFFER_SIZE - 7 - (RPC_M2S_BUFFER_SIZE & 1))
+
+typedef struct _rpc_stream_chunk_t {
+    uint8_t  checksum;
+    int8_t   transaction_id;
+    uint16_t offset;
+    uint16_t length; // of the whole stream, 0 asks the slave for its stream number only
+    uint8_t  stream;
+    uint8_t  data[RPC_STREAM_CHUNK_SIZE];
+} rpc_stream_chunk_t;
+
+_Static_assert(RPC_STREAM_CHUNK_SIZE > 0 && sizeof(rpc_stream_chunk_t) <= RPC_M2S_BUFFER_SIZE, "RPC_M2S_BUFFER_SIZE too small for the 7 byte header of a streamed chunk");
+
+// The slave's answer to a chunk, takes the place of the RPC response buffer
+typedef struct _rpc_stream_status_t {
+    uint8_t status;
+    uint8_t stream; // the stream the slave is in
+} rpc_stream_status_t;
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
@@ -223,8 +243,14 @@ typedef struct _split_shared_memory_t {
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     rpc_sync_info_t rpc_info;
-    uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
-    uint8_t         rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
+    union {
+        uint8_t            rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
+        rpc_stream_chunk_t rpc_stream;
+    };
+    union {
+        uint8_t             rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
+        rpc_stream_status_t rpc_stream_status;
+    };
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
@@ -0,0 +1,115 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+class DynamicMacros : public TestFixture {
+   protected:
+    // Taps each key in turn while recording macro 1, then plays it back and returns the keys pressed
+    std::vector<uint8_t> record_and_play(TestDriver &driver, KeymapKey &record, KeymapKey &stop, KeymapKey &play, std::vector<KeymapKey *> taps) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        tap_key(record);
+        for (auto *key : taps) {
+            tap_key(*key);
+        }
+        tap_key(stop);
+        VERIFY_AND_CLEAR(driver);
+
+        std::vector<uint8_t> pressed;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&pressed](report_keyboard_t &report) {
+            if (report.keys[0] != KC_NO) {
+                pressed.push_back(report.keys[0]);
+            }
+        }));
+        tap_key(play);
+        VERIFY_AND_CLEAR(driver);
+        return pressed;
+    }
+};
+
+TEST_F(DynamicMacros, PlaysBackRecordedKeys) {
+    TestDriver driver;
+    KeymapKey  record = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  stop   = KeymapKey(0, 1, 0, DM_RSTP);
+    KeymapKey  play   = KeymapKey(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a  = KeymapKey(0, 0, 1, KC_A);
+    KeymapKey  key_b  = KeymapKey(0, 1, 1, KC_B);
+    set_keymap({record, stop, play, key_a, key_b});
+
+    const auto pressed = record_and_play(driver, record, stop, play, {&key_a, &key_b, &key_b, &key_a});
+    EXPECT_EQ(pressed, std::vector<uint8_t>({KC_A, KC_B, KC_B, KC_A}));
+}
+
+TEST_F(DynamicMacros, HoldsFourTimesAsManyEvents) {
+    TestDriver driver;
+    KeymapKey  record = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  stop   = KeymapKey(0, 1, 0, DM_RSTP);
+    KeymapKey  play   = KeymapKey(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a  = KeymapKey(0, 0, 1, KC_A);
+    KeymapKey  key_b  = KeymapKey(0, 1, 1, KC_B);
+    set_keymap({record, stop, play, key_a, key_b});
+
+    // Alternating keys so nothing is stored as a repeat, 2 events per tap
+    std::vector<KeymapKey *> taps;
+    std::vector<uint8_t>     expected;
+    for (size_t i = 0; i < DYNAMIC_MACRO_SIZE * 4 / 2; i++) {
+        taps.push_back(i % 2 ? &key_b : &key_a);
+        expected.push_back(i % 2 ? KC_B : KC_A);
+    }
+
+    EXPECT_EQ(record_and_play(driver, record, stop, play, taps), expected);
+}
+
+TEST_F(DynamicMacros, StoresRepeatedTaps) {
+    TestDriver driver;
+    KeymapKey  record = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  stop   = KeymapKey(0, 1, 0, DM_RSTP);
+    KeymapKey  play   = KeymapKey(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a  = KeymapKey(0, 0, 1, KC_A);
+    KeymapKey  key_b  = KeymapKey(0, 1, 1, KC_B);
+    set_keymap({record, stop, play, key_a, key_b});
+
+    // Far more taps than the buffer has room for as separate events
+    std::vector<KeymapKey *> taps;
+    std::vector<uint8_t>     expected;
+    for (size_t i = 0; i < 1000; i++) {
+        taps.push_back(&key_a);
+        expected.push_back(KC_A);
+    }
+    taps.push_back(&key_b);
+    expected.push_back(KC_B);
+
+    EXPECT_EQ(record_and_play(driver, record, stop, play, taps), expected);
+}
+
+TEST_F(DynamicMacros, StopsRecordingWhenFull) {
+    TestDriver driver;
+    KeymapKey  record = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  stop   = KeymapKey(0, 1, 0, DM_RSTP);
+    KeymapKey  play   = KeymapKey(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a  = KeymapKey(0, 0, 1, KC_A);
+    KeymapKey  key_b  = KeymapKey(0, 1, 1, KC_B);
+    set_keymap({record, stop, play, key_a, key_b});
+
+    std::vector<KeymapKey *> taps;
+    for (size_t i = 0; i < DYNAMIC_MACRO_BUFFER_SIZE; i++) {
+        taps.push_back(i % 2 ? &key_b : &key_a);
+    }
+
+    // Each plain key event takes a byte
+    const auto pressed = record_and_play(driver, record, stop, play, taps);
+    EXPECT_EQ(pressed.size(), DYNAMIC_MACRO_BUFFER_SIZE / 2);
+    for (size_t i = 0; i < pressed.size(); i++) {
+        EXPECT_EQ(pressed[i], i % 2 ? KC_B : KC_A);
+    }
+}
@@ -0,0 +1,225 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+namespace {
+
+// Overrides that never activate, to push an array past KEY_OVERRIDE_INDEX_SIZE so it is scanned instead of indexed
+const key_override_t padding_override = {
+    .trigger      = KC_NO,
+    .trigger_mods = 0,
+    .layers       = 0,
+    .options      = ko_options_default,
+};
+
+// ko_make_basic() uses C designated initializers
+key_override_t make_basic(uint8_t trigger_mods, uint16_t trigger, uint16_t replacement) {
+    key_override_t override  = {};
+    override.trigger         = trigger;
+    override.trigger_mods    = trigger_mods;
+    override.layers          = ~0;
+    override.suppressed_mods = trigger_mods;
+    override.replacement     = replacement;
+    override.options         = ko_options_default;
+    return override;
+}
+
+std::vector<key_override_t> random_overrides(std::mt19937 &rng, size_t count, const std::vector<uint16_t> &triggers) {
+    const uint8_t  mods[]         = {MOD_BIT(KC_LSFT), MOD_BIT(KC_LCTL), MOD_BIT(KC_LALT), MOD_BIT(KC_RSFT), MOD_MASK_SHIFT, MOD_MASK_CS, 0};
+    const uint16_t replacements[] = {KC_1, KC_2, KC_3, KC_4, LSFT(KC_5), C(KC_Z), KC_NO};
+
+    std::vector<key_override_t> overrides(count);
+    for (auto &override : overrides) {
+        override                   = {};
+        override.trigger           = triggers[rng() % triggers.size()];
+        override.trigger_mods      = mods[rng() % sizeof(mods)];
+        override.layers            = rng() % 8 ? ~0 : 0b10;
+        override.negative_mod_mask = rng() % 4 ? 0 : MOD_BIT(KC_LALT) & ~override.trigger_mods;
+        override.suppressed_mods   = override.trigger_mods & (rng() % 2 ? 0xFF : MOD_MASK_SHIFT);
+        override.replacement       = replacements[rng() % (sizeof(replacements) / sizeof(replacements[0]))];
+        override.options           = (ko_option_t)(rng() % (ko_option_no_reregister_trigger << 1));
+    }
+    return overrides;
+}
+
+std::vector<const key_override_t *> pointers_to(const std::vector<key_override_t> &overrides, size_t padding = 0) {
+    std::vector<const key_override_t *> pointers;
+    for (auto &override : overrides) {
+        pointers.push_back(&override);
+    }
+    pointers.insert(pointers.end(), padding, &padding_override);
+    pointers.push_back(NULL);
+    return pointers;
+}
+
+} // namespace
+
+class KeyOverride : public TestFixture {
+   protected:
+    void SetUp() override {
+        key_override_on();
+    }
+
+    void TearDown() override {
+        key_overrides = NULL;
+    }
+
+    // Replays the same key events and returns every keyboard report sent
+    std::vector<std::vector<uint8_t>> replay(TestDriver &driver, std::vector<KeymapKey> &keys, uint32_t seed, unsigned events) {
+        std::vector<std::vector<uint8_t>> reports;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&reports](report_keyboard_t &report) {
+            const uint8_t *raw = reinterpret_cast<const uint8_t *>(&report);
+            reports.emplace_back(raw, raw + sizeof(report));
+        }));
+
+        // Arrays may be allocated where the previous one was, so make sure the index is rebuilt
+        key_override_index_invalidate();
+        clear_keyboard();
+        reports.clear();
+
+        std::mt19937      rng(seed);
+        std::vector<bool> held(keys.size(), false);
+        const unsigned    delays[] = {1, 10, 60, 600};
+
+        for (unsigned i = 0; i < events; i++) {
+            const size_t k = rng() % keys.size();
+            if (held[k]) {
+                keys[k].release();
+            } else {
+                keys[k].press();
+            }
+            held[k] = !held[k];
+            run_one_scan_loop();
+            idle_for(delays[rng() % 4]);
+        }
+
+        for (size_t k = 0; k < keys.size(); k++) {
+            if (held[k]) {
+                keys[k].release();
+                run_one_scan_loop();
+            }
+        }
+        idle_for(1000);
+        // The active override must not outlive the array it came from
+        key_override_off();
+        key_override_on();
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return reports;
+    }
+};
+
+TEST_F(KeyOverride, ShiftBackspaceSendsDelete) {
+    TestDriver driver;
+    KeymapKey  shift = KeymapKey(0, 0, 0, KC_LSFT);
+    KeymapKey  bspc  = KeymapKey(0, 1, 0, KC_BSPC);
+    set_keymap({shift, bspc});
+
+    const key_override_t                delete_override = make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+    std::vector<const key_override_t *> overrides       = {&delete_override, NULL};
+    key_overrides                                       = overrides.data();
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_DEL));
+    bspc.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT)).Times(AnyNumber());
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    bspc.release();
+    run_one_scan_loop();
+    shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, EnabledFlagAppliesWithoutRebuild) {
+    TestDriver driver;
+    KeymapKey  shift = KeymapKey(0, 0, 0, KC_LSFT);
+    KeymapKey  bspc  = KeymapKey(0, 1, 0, KC_BSPC);
+    set_keymap({shift, bspc});
+
+    bool           enabled         = false;
+    key_override_t delete_override = make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+    delete_override.enabled        = &enabled;
+
+    std::vector<const key_override_t *> overrides = {&delete_override, NULL};
+    key_overrides                                 = overrides.data();
+
+    EXPECT_REPORT(driver, (KC_LSFT)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_LSFT, KC_BSPC));
+    EXPECT_EMPTY_REPORT(driver);
+    shift.press();
+    run_one_scan_loop();
+    tap_key(bspc);
+    shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    enabled = true;
+    EXPECT_REPORT(driver, (KC_LSFT)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_DEL));
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    shift.press();
+    run_one_scan_loop();
+    tap_key(bspc);
+    shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    key_override_off();
+    EXPECT_REPORT(driver, (KC_LSFT)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_LSFT, KC_BSPC));
+    EXPECT_EMPTY_REPORT(driver);
+    shift.press();
+    run_one_scan_loop();
+    tap_key(bspc);
+    shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, IndexMatchesLinearScan) {
+    TestDriver             driver;
+    std::vector<KeymapKey> keys = {
+        KeymapKey(0, 0, 0, KC_A), KeymapKey(0, 1, 0, KC_B), KeymapKey(0, 2, 0, KC_C), KeymapKey(0, 3, 0, KC_D), KeymapKey(0, 4, 0, KC_E),
+        KeymapKey(0, 0, 1, KC_LSFT), KeymapKey(0, 1, 1, KC_LCTL), KeymapKey(0, 2, 1, KC_LALT), KeymapKey(0, 3, 1, KC_RSFT),
+    };
+    set_keymap({keys[0], keys[1], keys[2], keys[3], keys[4], keys[5], keys[6], keys[7], keys[8]});
+
+    const std::vector<uint16_t> triggers = {KC_NO, KC_A, KC_B, KC_C, KC_D, KC_E, KC_F, KC_LSFT};
+
+    for (size_t count : {10, 50, 150, 500}) {
+        for (uint32_t seed = 1; seed <= 4; seed++) {
+            std::mt19937 rng(seed * 1000 + count);
+            const auto   overrides = random_overrides(rng, count, triggers);
+
+            auto indexed  = pointers_to(overrides);
+            key_overrides = indexed.data();
+            const auto a  = replay(driver, keys, seed, 300);
+
+            auto linear   = pointers_to(overrides, KEY_OVERRIDE_INDEX_SIZE + 1 - count);
+            key_overrides = linear.data();
+            const auto b  = replay(driver, keys, seed, 300);
+
+            EXPECT_EQ(a, b) << count << " overrides, seed " << seed;
+        }
+    }
+}
@@ -0,0 +1,18 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define MK_3_SPEED
+#define MOUSEKEY_FIXED_POINT
+
+// 312.5 units per second, not a whole number of units per millisecond
+#define MK_C_OFFSET_1 5
+#define MK_C_INTERVAL_1 16
+
+// ACCEL0 is the fast one here, past what a single report can carry
+#define MOUSEKEY_MOVE_MAX 40
+#define MK_C_OFFSET_0 48
+#define MK_C_INTERVAL_0 16
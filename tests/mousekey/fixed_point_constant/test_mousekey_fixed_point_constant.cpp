@@ -0,0 +1,109 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycodes.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "mousekey.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+class MousekeyFixedPointConstant : public TestFixture {
+   protected:
+    void expect_motion(TestDriver &driver) {
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([this](report_mouse_t &report) {
+            total_x += report.x;
+            total_y += report.y;
+        }));
+    }
+
+    int64_t total_x = 0;
+    int64_t total_y = 0;
+};
+
+TEST_F(MousekeyFixedPointConstant, DistanceIsSpeedTimesTime) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey(0, 0, 0, KC_MS_RIGHT);
+    set_keymap({key});
+    expect_motion(driver);
+
+    key.press();
+    run_one_scan_loop();
+    idle_for(MK_C_INTERVAL_1 * 100);
+    key.release();
+    run_one_scan_loop();
+
+    EXPECT_EQ(total_x, MK_C_OFFSET_1 * 100);
+    EXPECT_EQ(total_y, 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeyFixedPointConstant, DiagonalKeepsFractions) {
+    TestDriver driver;
+    KeymapKey  right = KeymapKey(0, 0, 0, KC_MS_RIGHT);
+    KeymapKey  down  = KeymapKey(0, 1, 0, KC_MS_DOWN);
+    set_keymap({right, down});
+    expect_motion(driver);
+
+    right.press();
+    down.press();
+    run_one_scan_loop();
+    idle_for(MK_C_INTERVAL_1 * 256);
+    right.release();
+    down.release();
+    run_one_scan_loop();
+
+    // 5 / sqrt(2) = 3.54 units per tick, which rounding each tick would turn into 4
+    EXPECT_EQ(total_x, MK_C_OFFSET_1 * 181);
+    EXPECT_EQ(total_y, MK_C_OFFSET_1 * 181);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeyFixedPointConstant, SpeedChangeAppliesToNextTick) {
+    TestDriver driver;
+    KeymapKey  key   = KeymapKey(0, 0, 0, KC_MS_UP);
+    KeymapKey  accel = KeymapKey(0, 1, 0, KC_MS_ACCEL2);
+    set_keymap({key, accel});
+    expect_motion(driver);
+
+    key.press();
+    run_one_scan_loop();
+    idle_for(MK_C_INTERVAL_1 * 10);
+    accel.press();
+    run_one_scan_loop();
+    idle_for(MK_C_INTERVAL_2 * 10);
+    key.release();
+    accel.release();
+    run_one_scan_loop();
+
+    EXPECT_EQ(total_y, -(MK_C_OFFSET_1 * 10 + MK_C_OFFSET_2 * 10));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeyFixedPointConstant, DistancePastMoveMaxIsCarried) {
+    TestDriver driver;
+    KeymapKey  key   = KeymapKey(0, 0, 0, KC_MS_RIGHT);
+    KeymapKey  fast  = KeymapKey(0, 1, 0, KC_MS_ACCEL0);
+    KeymapKey  slow  = KeymapKey(0, 2, 0, KC_MS_ACCEL1);
+    set_keymap({key, fast, slow});
+    EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([this](report_mouse_t &report) {
+        EXPECT_LE(report.x, MOUSEKEY_MOVE_MAX);
+        total_x += report.x;
+    }));
+
+    tap_key(fast);
+    key.press();
+    run_one_scan_loop();
+    idle_for(MK_C_INTERVAL_0 * 10);
+    // What did not fit in the reports goes out on top of the slower ticks that follow
+    tap_key(slow);
+    idle_for(MK_C_INTERVAL_1 * 20);
+    key.release();
+    run_one_scan_loop();
+
+    EXPECT_EQ(total_x, MK_C_OFFSET_0 * 10 + MK_C_OFFSET_1 * 20);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,132 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cmath>
+#include "keycodes.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "mousekey.h"
+void advance_time(uint32_t ms);
+void deferred_exec_task(void);
+}
+
+using testing::_;
+using testing::Invoke;
+
+/* Distance in report units covered after `t` ms, integrated from the kinetic speed curve. */
+static double kinetic_distance(double t) {
+    const double initial = MOUSEKEY_INITIAL_SPEED;
+    const double base    = MOUSEKEY_BASE_SPEED;
+    const double accel   = MOUSEKEY_MOVE_DELTA;
+
+    // speed = I + A * t/50 + A * (t/50)^2 / 2 reaches the base speed at
+    const double t_base = 50.0 * (std::sqrt(1.0 + 2.0 * (base - initial) / accel) - 1.0);
+    const double t_ramp = std::min(t, t_base);
+
+    double distance = (initial * t_ramp + accel * t_ramp * t_ramp / 100.0 + accel * t_ramp * t_ramp * t_ramp / 15000.0) / 1000.0;
+    if (t > t_base) {
+        distance += base * (t - t_base) / 1000.0;
+    }
+    return distance;
+}
+
+class MousekeyFixedPointKinetic : public TestFixture {
+   protected:
+    void expect_motion(TestDriver &driver) {
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([this](report_mouse_t &report) {
+            total_x += report.x;
+            total_y += report.y;
+            if (report.x || report.y) ticks++;
+        }));
+    }
+
+    int64_t  total_x = 0;
+    int64_t  total_y = 0;
+    unsigned ticks   = 0;
+};
+
+TEST_F(MousekeyFixedPointKinetic, DistanceMatchesClosedForm) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey(0, 0, 0, KC_MS_RIGHT);
+    set_keymap({key});
+    expect_motion(driver);
+
+    for (unsigned hold : {40, 250, 1000, 1190, 3000}) {
+        total_x = total_y = ticks = 0;
+
+        key.press();
+        run_one_scan_loop();
+        idle_for(hold);
+        key.release();
+        run_one_scan_loop();
+        idle_for(100);
+
+        EXPECT_EQ(ticks, hold / MOUSEKEY_INTERVAL) << "hold " << hold;
+        EXPECT_NEAR(total_x, kinetic_distance(ticks * MOUSEKEY_INTERVAL), 1.0) << "hold " << hold;
+        EXPECT_EQ(total_y, 0);
+    }
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeyFixedPointKinetic, DiagonalIsScaled) {
+    TestDriver driver;
+    KeymapKey  right = KeymapKey(0, 0, 0, KC_MS_RIGHT);
+    KeymapKey  up    = KeymapKey(0, 1, 0, KC_MS_UP);
+    set_keymap({right, up});
+    expect_motion(driver);
+
+    right.press();
+    up.press();
+    run_one_scan_loop();
+    idle_for(2000);
+    right.release();
+    up.release();
+    run_one_scan_loop();
+
+    // ticks moving less than a whole unit per axis send nothing, so go by the time held
+    const double expected = kinetic_distance(2000) * 181.0 / 256.0;
+    EXPECT_NEAR(total_x, expected, 1.0);
+    EXPECT_NEAR(total_y, -expected, 1.0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeyFixedPointKinetic, SlowMainLoopKeepsDistance) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey(0, 0, 0, KC_MS_LEFT);
+    set_keymap({key});
+    expect_motion(driver);
+
+    key.press();
+    run_one_scan_loop();
+    // main loop running every 7ms instead of every 1ms, so ticks are handled late
+    for (unsigned elapsed = 0; elapsed < 1500; elapsed += 7) {
+        keyboard_task();
+        deferred_exec_task();
+        advance_time(7);
+    }
+    key.release();
+    run_one_scan_loop();
+
+    EXPECT_NEAR(-total_x, kinetic_distance(ticks * MOUSEKEY_INTERVAL), 1.0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeyFixedPointKinetic, ReleaseStopsMotion) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey(0, 0, 0, KC_MS_DOWN);
+    set_keymap({key});
+    expect_motion(driver);
+
+    key.press();
+    run_one_scan_loop();
+    idle_for(200);
+    key.release();
+    run_one_scan_loop();
+    const unsigned ticks_at_release = ticks;
+    idle_for(500);
+
+    EXPECT_EQ(ticks, ticks_at_release);
+    EXPECT_GT(total_y, 0);
+    VERIFY_AND_CLEAR(driver);
+}
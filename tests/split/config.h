@@ -0,0 +1,21 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// rgb_matrix_types.h is included from the C++ tests
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
+#define SPLIT_LAYER_STATE_ENABLE
+#define SPLIT_MODS_ENABLE
+#define SPLIT_LED_STATE_ENABLE
+
+#define RGB_MATRIX_LED_COUNT 4
+#define RGB_MATRIX_SPLIT \
+    { 2, 2 }
+
+#define SPLIT_TRANSACTION_IDS_USER USER_SYNC_A, USER_SYNC_B, USER_SYNC_C
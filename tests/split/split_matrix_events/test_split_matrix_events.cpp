@@ -0,0 +1,126 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "../split_sim.hpp"
+
+extern "C" {
+#include "split_util.h"
+}
+
+using testing::_;
+
+class SplitMatrixEvents : public TestFixture {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        SplitSim::start();
+    }
+
+    static void TearDownTestCase() {
+        SplitSim::stop();
+    }
+
+    void SetUp() override {
+        SplitSim::link = SplitLink{};
+    }
+
+    // Presses a key on the slave and returns how long it took to reach the host, in nanoseconds
+    uint64_t press_latency(TestDriver &driver, KeymapKey &key, int scans) {
+        uint64_t pressed  = SplitSim::now_ns();
+        uint64_t reported = 0;
+        EXPECT_REPORT(driver, (key.report_code)).WillOnce([&](report_keyboard_t &) { reported = SplitSim::now_ns(); });
+        SplitSim::press(key.position.col, key.position.row);
+        for (int i = 0; i < scans && !reported; i++) {
+            run_one_scan_loop();
+        }
+        EXPECT_NE(reported, 0);
+        return reported - pressed;
+    }
+
+    void release(TestDriver &driver, KeymapKey &key) {
+        EXPECT_EMPTY_REPORT(driver);
+        SplitSim::release(key.position.col, key.position.row);
+        idle_for(10);
+        VERIFY_AND_CLEAR(driver);
+    }
+};
+
+TEST_F(SplitMatrixEvents, SlaveKeyReachesHost) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey{0, 3, 2, KC_A};
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    SplitSim::press(3, 2);
+    idle_for(3);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    SplitSim::release(3, 2);
+    idle_for(3);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitMatrixEvents, IdleLinkIsQuiet) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    idle_for(200);
+    SplitLinkStats before = SplitSim::stats;
+    uint64_t       start  = SplitSim::now_ns();
+    idle_for(1000);
+    uint32_t transactions = SplitSim::stats.transactions - before.transactions;
+    uint64_t bytes        = SplitSim::stats.bytes - before.bytes;
+    uint64_t busy         = SplitSim::stats.busy_ns - before.busy_ns;
+    // What is left are the periodic refreshes of the other syncs, and the matrix consistency check
+    EXPECT_LT(transactions, 50);
+    EXPECT_LT(bytes, 200);
+    EXPECT_EQ(SplitSim::now_ns() - start, 1000 * 1000000ull + busy);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitMatrixEvents, ScanToReportLatency) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey{0, 0, 2, KC_A};
+    set_keymap({key});
+
+    // Between two refreshes of the sync timer
+    idle_for(250);
+    uint32_t transactions = SplitSim::stats.transactions;
+    uint64_t latency      = press_latency(driver, key, 10);
+    // A scan of the slave, then a single read of its matrix
+    EXPECT_LE(latency, 1000000 + 8 * SplitSim::link.byte_ns + SplitSim::link.turnaround_ns);
+    EXPECT_EQ(SplitSim::stats.transactions - transactions, 1);
+    release(driver, key);
+}
+
+TEST_F(SplitMatrixEvents, MissedEventIsCaughtByCheck) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey{0, 0, 2, KC_A};
+    set_keymap({key});
+
+    idle_for(200);
+    SplitSim::link.event_line = false;
+    uint64_t latency          = press_latency(driver, key, 1000);
+    EXPECT_GT(latency, 2000000);
+    EXPECT_LE(latency, 510000000);
+
+    SplitSim::link.event_line = true;
+    release(driver, key);
+}
+
+TEST_F(SplitMatrixEvents, CorruptedReadIsRetried) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey{0, 0, 2, KC_A};
+    set_keymap({key});
+
+    idle_for(200);
+    SplitSim::link.bit_error_rate = 2e-2;
+    uint32_t failures             = SplitSim::stats.failures;
+    press_latency(driver, key, 100);
+    EXPECT_GT(SplitSim::stats.failures, failures);
+
+    SplitSim::link.bit_error_rate = 0;
+    release(driver, key);
+}
@@ -0,0 +1,347 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_sim.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern "C" {
+#include "quantum.h"
+#include "serial.h"
+#include "split_util.h"
+#include "synchronization_util.h"
+#include "sync_timer.h"
+#include "test_matrix.h"
+#include "transactions.h"
+#include "transport.h"
+
+uint32_t timer_read_internal(void);
+void     set_time(uint32_t t);
+void     advance_time(uint32_t ms);
+}
+
+enum : uint8_t {
+    SIM_TRANSACTION,
+    SIM_PRESS,
+    SIM_RELEASE,
+    SIM_STATE,
+    SIM_EVENT_LINE,
+    SIM_EXIT,
+};
+
+// Sent ahead of the initiator2target data of a transaction, the slave answers with the handshake and its target2initiator data
+typedef struct {
+    uint8_t  command;
+    uint8_t  id;
+    uint8_t  col;
+    uint8_t  row;
+    uint32_t now;
+    uint16_t length;
+} sim_message_t;
+
+static bool is_master = true;
+// Pulled by the slave while the master has yet to read a change of its matrix
+static bool event_line = false;
+
+SplitLink      SplitSim::link;
+SplitLinkStats SplitSim::stats;
+int            SplitSim::fd         = -1;
+pid_t          SplitSim::pid        = 0;
+uint64_t       SplitSim::pending_ns = 0;
+std::mt19937   SplitSim::random;
+
+static void write_all(int fd, const void *data, size_t length) {
+    const uint8_t *p = (const uint8_t *)data;
+    while (length) {
+        ssize_t n = write(fd, p, length);
+        if (n <= 0) abort();
+        p += n;
+        length -= n;
+    }
+}
+
+static bool read_all(int fd, void *data, size_t length) {
+    uint8_t *p = (uint8_t *)data;
+    while (length) {
+        ssize_t n = read(fd, p, length);
+        if (n <= 0) return false;
+        p += n;
+        length -= n;
+    }
+    return true;
+}
+
+void SplitSim::start() {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) abort();
+
+    stats      = {};
+    pending_ns = 0;
+    random.seed(0);
+
+    pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        is_master = false;
+        keyboard_init();
+        run_slave(fds[1]);
+    }
+    close(fds[1]);
+    fd = fds[0];
+}
+
+void SplitSim::stop() {
+    request(SIM_EXIT, 0, 0);
+    close(fd);
+    waitpid(pid, NULL, 0);
+    fd = -1;
+}
+
+void SplitSim::press(uint8_t col, uint8_t row) {
+    request(SIM_PRESS, col, row);
+}
+
+void SplitSim::release(uint8_t col, uint8_t row) {
+    request(SIM_RELEASE, col, row);
+}
+
+SplitSlaveState SplitSim::slave_state() {
+    SplitSlaveState state;
+    request(SIM_STATE, 0, 0);
+    if (!read_all(fd, &state, sizeof(state))) abort();
+    return state;
+}
+
+uint64_t SplitSim::now_ns() {
+    return timer_read_internal() * 1000000ull + pending_ns;
+}
+
+void SplitSim::request(uint8_t command, uint8_t col, uint8_t row) {
+    sim_message_t message = {.command = command, .col = col, .row = row, .now = timer_read_internal()};
+    write_all(fd, &message, sizeof(message));
+}
+
+void SplitSim::corrupt(uint8_t *data, size_t length) {
+    if (link.bit_error_rate <= 0) {
+        return;
+    }
+    std::bernoulli_distribution flip(link.bit_error_rate);
+    for (size_t i = 0; i < length * 8; i++) {
+        if (flip(random)) {
+            data[i / 8] ^= 1 << (i % 8);
+        }
+    }
+}
+
+// Link time goes onto the master's clock once it adds up to a millisecond
+void SplitSim::charge(uint64_t ns) {
+    stats.busy_ns += ns;
+    pending_ns += ns;
+    if (pending_ns >= 1000000) {
+        advance_time(pending_ns / 1000000);
+        pending_ns %= 1000000;
+    }
+}
+
+bool SplitSim::transaction(int id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    uint8_t                   out[1 + UINT8_MAX];
+    uint8_t                   in[1 + UINT8_MAX];
+    uint16_t                  length;
+
+    out[0] = id;
+    memcpy(out + 1, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    corrupt(out, 1 + trans->initiator2target_buffer_size);
+
+    stats.transactions++;
+    stats.tries[id]++;
+    stats.bytes += 1 + trans->initiator2target_buffer_size;
+    if (out[0] != id) {
+        // The slave does not answer a transaction it does not know, the master times out
+        charge((1 + trans->initiator2target_buffer_size) * link.byte_ns + link.timeout_ns);
+        stats.failures++;
+        return false;
+    }
+
+    sim_message_t message = {.command = SIM_TRANSACTION, .id = (uint8_t)id, .now = timer_read_internal(), .length = trans->initiator2target_buffer_size};
+    write_all(fd, &message, sizeof(message));
+    write_all(fd, out + 1, message.length);
+
+    if (!read_all(fd, &length, sizeof(length)) || !read_all(fd, in, length)) abort();
+    corrupt(in, length);
+
+    stats.bytes += length;
+    charge((1 + message.length + length) * link.byte_ns + link.turnaround_ns);
+    if (id == link.fail_id && link.fail_every && (stats.tries[id] - 1) % link.fail_every == 0) {
+        in[0] = ~id;
+    }
+    if (in[0] != id) {
+        stats.failures++;
+        return false;
+    }
+
+    memcpy(split_trans_target2initiator_buffer(trans), in + 1, length - 1);
+    return true;
+}
+
+// Reading the line takes no time on the link, but the slave gets to catch up with the master's clock
+bool SplitSim::event_pending() {
+    uint8_t line;
+    request(SIM_EVENT_LINE, 0, 0);
+    if (!read_all(fd, &line, sizeof(line))) abort();
+    return line && link.event_line;
+}
+
+// The slave's side of the link, answers the master until it goes away
+void SplitSim::run_slave(int fd) {
+    sim_message_t message;
+    uint8_t       data[1 + UINT8_MAX];
+    uint32_t      last_loop = 0;
+    bool          started   = false;
+
+    while (read_all(fd, &message, sizeof(message))) {
+        // The slave has been scanning since before the master first talked to it
+        if (!started) {
+            last_loop = message.now;
+            started   = true;
+            set_time(last_loop);
+            keyboard_task();
+        }
+        // Every test starts the master's clock again from 0
+        if ((int32_t)(message.now - last_loop) < 0) {
+            last_loop = message.now;
+        }
+        while (last_loop != message.now) {
+            set_time(++last_loop);
+            keyboard_task();
+        }
+
+        switch (message.command) {
+            case SIM_TRANSACTION: {
+                split_transaction_desc_t *trans = &split_transaction_table[message.id];
+                if (!read_all(fd, data, message.length)) break;
+
+                split_shared_memory_lock();
+                memcpy(split_trans_initiator2target_buffer(trans), data, MIN(message.length, trans->initiator2target_buffer_size));
+                if (trans->slave_callback) {
+                    trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+                }
+                data[0] = message.id;
+                memcpy(data + 1, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+                split_shared_memory_unlock();
+
+                uint16_t length = 1 + trans->target2initiator_buffer_size;
+                write_all(fd, &length, sizeof(length));
+                write_all(fd, data, length);
+                break;
+            }
+            case SIM_PRESS:
+                press_key(message.col, message.row);
+                break;
+            case SIM_RELEASE:
+                release_key(message.col, message.row);
+                break;
+            case SIM_STATE: {
+                SplitSlaveState state = {
+                    .layer_state         = layer_state,
+                    .default_layer_state = default_layer_state,
+                    .mods                = get_mods(),
+                    .weak_mods           = get_weak_mods(),
+                    .oneshot_mods        = get_oneshot_mods(),
+                    .led_state           = host_keyboard_leds(),
+                    .sync_timer          = sync_timer_read32(),
+                };
+#ifdef RGB_MATRIX_ENABLE
+                state.rgb_matrix_enabled = rgb_matrix_is_enabled();
+                state.rgb_matrix_mode    = rgb_matrix_get_mode();
+                state.rgb_matrix_hue     = rgb_matrix_get_hue();
+#endif // RGB_MATRIX_ENABLE
+                write_all(fd, &state, sizeof(state));
+                break;
+            }
+            case SIM_EVENT_LINE: {
+                uint8_t line = event_line;
+                write_all(fd, &line, sizeof(line));
+                break;
+            }
+            case SIM_EXIT:
+                _exit(0);
+        }
+    }
+    _exit(0);
+}
+
+extern "C" {
+
+bool is_keyboard_master_impl(void) {
+    return is_master;
+}
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int sstd_index) {
+    return SplitSim::transaction(sstd_index);
+}
+
+#define ROWS_PER_HAND (MATRIX_ROWS / 2)
+
+static void set_rows(uint8_t first, const matrix_row_t *rows) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (rows[row] & ((matrix_row_t)1 << col)) {
+                press_key(col, first + row);
+            } else {
+                release_key(col, first + row);
+            }
+        }
+    }
+}
+
+// The same exchange as matrix_post_scan() in quantum/matrix_common.c, which is not built with the test matrix
+void matrix_scan_kb(void) {
+    uint8_t this_hand = is_keyboard_left() ? 0 : ROWS_PER_HAND;
+    uint8_t that_hand = ROWS_PER_HAND - this_hand;
+
+    matrix_row_t this_rows[ROWS_PER_HAND];
+    matrix_row_t that_rows[ROWS_PER_HAND] = {0};
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        this_rows[row] = matrix_get_row(this_hand + row);
+    }
+
+    if (is_keyboard_master()) {
+        static bool last_connected = false;
+        if (transport_master_if_connected(this_rows, that_rows)) {
+            set_rows(that_hand, that_rows);
+            last_connected = true;
+        } else if (last_connected) {
+            // reset other half when disconnected
+            set_rows(that_hand, that_rows);
+            last_connected = false;
+        }
+    } else {
+        for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+            that_rows[row] = matrix_get_row(that_hand + row);
+        }
+        transport_slave(that_rows, this_rows);
+        set_rows(that_hand, that_rows);
+    }
+}
+
+#ifdef SPLIT_MATRIX_EVENT_ENABLE
+void split_matrix_event_init(void) {}
+
+void split_matrix_event_signal(bool pending) {
+    event_line = pending;
+}
+
+bool split_matrix_event_pending(void) {
+    return SplitSim::event_pending();
+}
+#endif // SPLIT_MATRIX_EVENT_ENABLE
+
+}
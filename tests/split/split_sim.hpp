@@ -0,0 +1,90 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <sys/types.h>
+
+/* Two halves of a split keyboard in one test binary. The slave is a fork of
+ * the test process, so both halves run the same firmware with their own
+ * state. The master's serial driver is replaced with a link to the slave,
+ * that charges every transaction to the master's clock and can corrupt the
+ * bytes on the wire.
+ *
+ * The slave runs its main loop once per millisecond of the master's time,
+ * caught up whenever the master talks to it.
+ */
+
+struct SplitLink {
+    // Time on the wire per byte, 230400 baud with parity and two stop bits by default
+    uint32_t byte_ns = 1000000000ull * 12 / 230400;
+    // Time from the end of one direction to the start of the other
+    uint32_t turnaround_ns = 20000;
+    // How long the master waits for an answer that does not come, SERIAL_USART_TIMEOUT by default
+    uint32_t timeout_ns = 20000000;
+    // Chance of each bit flipping
+    double bit_error_rate = 0;
+    // Whether the master sees the slave pull the matrix event line
+    bool event_line = true;
+    // Every fail_every-th try of transaction fail_id gets a corrupted answer, starting with the first, as on a link that keeps needing retries
+    int      fail_id    = -1;
+    uint32_t fail_every = 0;
+};
+
+struct SplitLinkStats {
+    uint32_t transactions;
+    uint32_t failures;
+    uint64_t bytes;
+    uint64_t busy_ns;
+    // Tries of each transaction id
+    std::map<int, uint32_t> tries;
+};
+
+// What the tests look at on the slave half
+struct SplitSlaveState {
+    uint32_t layer_state;
+    uint32_t default_layer_state;
+    uint8_t  mods;
+    uint8_t  weak_mods;
+    uint8_t  oneshot_mods;
+    uint8_t  led_state;
+    uint32_t sync_timer;
+    bool     rgb_matrix_enabled;
+    uint8_t  rgb_matrix_mode;
+    uint8_t  rgb_matrix_hue;
+};
+
+class SplitSim {
+   public:
+    // Forks the slave, call after keyboard_init() on the master and after anything the slave needs to inherit
+    static void start();
+    static void stop();
+
+    static void press(uint8_t col, uint8_t row);
+    static void release(uint8_t col, uint8_t row);
+
+    static SplitSlaveState slave_state();
+
+    static SplitLink      link;
+    static SplitLinkStats stats;
+
+    // The master's time in nanoseconds, including link time not yet added to the millisecond clock
+    static uint64_t now_ns();
+
+    static bool transaction(int id);
+    static bool event_pending();
+
+   private:
+    static void request(uint8_t command, uint8_t col, uint8_t row);
+    static void run_slave(int fd);
+    static void corrupt(uint8_t *data, size_t length);
+    static void charge(uint64_t ns);
+
+    static int          fd;
+    static pid_t        pid;
+    static uint64_t     pending_ns;
+    static std::mt19937 random;
+};
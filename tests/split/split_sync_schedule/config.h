@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SPLIT_LAYER_STATE_ENABLE
+#define SPLIT_LED_STATE_ENABLE
+
+// The slave matrix checksum fits, the checksum and the slave matrix together do not
+#define SPLIT_TRANSACTION_BUDGET 8
+#define SPLIT_LED_STATE_SYNC_INTERVAL 50
+#define SPLIT_SYNC_MAX_DELAY 30
+// Only changes are sent while a test runs
+#define FORCED_SYNC_THROTTLE_MS 10000
@@ -0,0 +1,11 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+# split_sim.cpp takes the place of the serial driver
+SPLIT_KEYBOARD = yes
+
+SRC += tests/split/split_sim.cpp
@@ -0,0 +1,121 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "../split_sim.hpp"
+
+extern "C" {
+#include "split_util.h"
+#include "transactions.h"
+}
+
+using testing::_;
+
+class SplitSyncSchedule : public TestFixture {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        SplitSim::start();
+    }
+
+    static void TearDownTestCase() {
+        SplitSim::stop();
+    }
+
+    void SetUp() override {
+        SplitSim::link = SplitLink{};
+    }
+
+    // Lets the syncs forced by the clock starting again from 0 go out, then starts counting
+    void settle() {
+        idle_for(100);
+        SplitSim::stats.tries.clear();
+    }
+
+    static uint32_t tries(int id) {
+        return SplitSim::stats.tries[id];
+    }
+};
+
+TEST_F(SplitSyncSchedule, BudgetDefersToTheNextPass) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey{0, 3, 2, KC_A};
+    set_keymap({key, KeymapKey{1, 3, 2, KC_A}});
+    settle();
+
+    // The slave scans the key on its next loop, and the master reads it on the pass after that
+    SplitSim::press(3, 2);
+    run_one_scan_loop();
+    EXPECT_EQ(tries(GET_SLAVE_MATRIX_DATA), 0u);
+
+    // Reading the slave matrix uses up the budget, so the layer waits
+    EXPECT_REPORT(driver, (KC_A));
+    layer_on(1);
+    run_one_scan_loop();
+    EXPECT_EQ(tries(GET_SLAVE_MATRIX_DATA), 1u);
+    EXPECT_EQ(tries(PUT_LAYER_STATE), 0u);
+    EXPECT_EQ(SplitSim::slave_state().layer_state, 0u);
+    VERIFY_AND_CLEAR(driver);
+
+    // A sync that waited goes ahead on the next pass
+    run_one_scan_loop();
+    EXPECT_EQ(tries(PUT_LAYER_STATE), 1u);
+    EXPECT_EQ(SplitSim::slave_state().layer_state, (layer_state_t)1 << 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    SplitSim::release(3, 2);
+    layer_clear();
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitSyncSchedule, SyncIntervalLimitsRuns) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    settle();
+
+    // Caps lock changes on every pass, but is only sent every SPLIT_LED_STATE_SYNC_INTERVAL ms
+    led_t caps_lock = {.caps_lock = true};
+    for (int i = 0; i < 200; i++) {
+        driver.set_leds(i % 2 ? caps_lock.raw : 0);
+        run_one_scan_loop();
+    }
+    EXPECT_GE(tries(PUT_LED_STATE), 200u / 50 - 1);
+    EXPECT_LE(tries(PUT_LED_STATE), 200u / 50 + 1);
+
+    driver.set_leds(caps_lock.raw);
+    idle_for(50);
+    EXPECT_EQ(SplitSim::slave_state().led_state, caps_lock.raw);
+    driver.set_leds(0);
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitSyncSchedule, CongestionDefersNoLongerThanMaxDelay) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    settle();
+
+    // Every pass needs a retry
+    SplitSim::link.fail_id    = GET_SLAVE_MATRIX_CHECKSUM;
+    SplitSim::link.fail_every = 2;
+    layer_on(1);
+    idle_for(10);
+    EXPECT_EQ(tries(PUT_LAYER_STATE), 0u);
+    EXPECT_EQ(SplitSim::slave_state().layer_state, 0u);
+
+    idle_for(SPLIT_SYNC_MAX_DELAY);
+    EXPECT_EQ(tries(PUT_LAYER_STATE), 1u);
+    EXPECT_EQ(SplitSim::slave_state().layer_state, (layer_state_t)1 << 1);
+    EXPECT_TRUE(is_transport_connected());
+
+    // Once the link is healthy again, changes go out on the next pass
+    SplitSim::link.fail_every = 0;
+    layer_on(2);
+    run_one_scan_loop();
+    EXPECT_EQ(SplitSim::slave_state().layer_state, (layer_state_t)1 << 1 | (layer_state_t)1 << 2);
+
+    layer_clear();
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
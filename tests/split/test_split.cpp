@@ -0,0 +1,487 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "split_sim.hpp"
+#include <algorithm>
+
+extern "C" {
+#include "split_util.h"
+#include "transactions.h"
+}
+
+using testing::_;
+
+// One LED under the first key of each row
+// clang-format off
+led_config_t g_led_config = {{
+    {0, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+    {1, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+    {2, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+    {3, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+}, {
+    {0, 0}, {0, 21}, {0, 42}, {0, 64},
+}, {
+    4, 4, 4, 4,
+}};
+// clang-format on
+
+static void rgb_matrix_none(void) {}
+static void rgb_matrix_set_color_none(int index, uint8_t red, uint8_t green, uint8_t blue) {}
+static void rgb_matrix_set_color_all_none(uint8_t red, uint8_t green, uint8_t blue) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = rgb_matrix_none,
+    .set_color     = rgb_matrix_set_color_none,
+    .set_color_all = rgb_matrix_set_color_all_none,
+    .flush         = rgb_matrix_none,
+};
+
+// Answers with the inverted request
+static void invert_rpc(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    for (uint8_t i = 0; i < initiator2target_buffer_size && i < target2initiator_buffer_size; i++) {
+        ((uint8_t *)target2initiator_buffer)[i] = ~((const uint8_t *)initiator2target_buffer)[i];
+    }
+}
+
+// What the slave got of the streams, kept in the slave process
+static struct {
+    uint8_t  data[2048];
+    uint16_t received;
+    uint16_t repeats;
+    uint8_t  busy_every;
+    uint8_t  calls;
+} stream_slave;
+
+typedef struct {
+    uint8_t busy_every;
+} stream_control_t;
+
+typedef struct {
+    uint16_t received;
+    uint16_t repeats;
+    uint32_t hash;
+} stream_status_t;
+
+static uint32_t fnv1a(const uint8_t *data, uint16_t length) {
+    uint32_t hash = 2166136261u;
+    for (uint16_t i = 0; i < length; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool stream_chunk(int8_t transaction_id, uint16_t offset, const void *data, uint8_t length, uint16_t total_length) {
+    // Every busy_every-th chunk is refused, as if the slave had no room for it yet
+    if (stream_slave.busy_every && ++stream_slave.calls % stream_slave.busy_every == 0) {
+        return false;
+    }
+    if (total_length > sizeof(stream_slave.data)) {
+        return false;
+    }
+    if (offset < stream_slave.received) {
+        stream_slave.repeats++;
+    }
+    memcpy(stream_slave.data + offset, data, length);
+    stream_slave.received = offset + length;
+    return true;
+}
+
+// Sets how often the slave refuses a chunk, and tells what it got so far
+static void stream_control(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    stream_status_t *status = (stream_status_t *)target2initiator_buffer;
+    status->received        = stream_slave.received;
+    status->repeats         = stream_slave.repeats;
+    status->hash            = fnv1a(stream_slave.data, stream_slave.received);
+
+    stream_slave.busy_every = ((const stream_control_t *)initiator2target_buffer)->busy_every;
+    stream_slave.calls      = 0;
+    stream_slave.received   = 0;
+    stream_slave.repeats    = 0;
+}
+
+static int stream_result;
+
+static void stream_done(int8_t transaction_id, bool success) {
+    stream_result = success;
+}
+
+class Split : public TestFixture {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        // The slave inherits the registration
+        transaction_register_rpc(USER_SYNC_A, invert_rpc);
+        transaction_register_rpc_stream(USER_SYNC_B, stream_chunk);
+        transaction_register_rpc(USER_SYNC_C, stream_control);
+        SplitSim::start();
+    }
+
+    static void TearDownTestCase() {
+        SplitSim::stop();
+    }
+
+    void SetUp() override {
+        SplitSim::link = SplitLink{};
+    }
+
+    // Streams the buffer to the slave, and returns how long it took in nanoseconds
+    uint64_t stream(const std::vector<uint8_t> &buffer, uint8_t busy_every) {
+        stream_control_t control = {busy_every};
+        stream_status_t  status;
+        EXPECT_TRUE(transaction_rpc_exec(USER_SYNC_C, sizeof(control), &control, sizeof(status), &status));
+
+        uint64_t start = SplitSim::now_ns();
+        stream_result  = -1;
+        EXPECT_TRUE(transaction_rpc_stream(USER_SYNC_B, buffer.data(), buffer.size(), stream_done));
+        EXPECT_FALSE(transaction_rpc_stream(USER_SYNC_B, buffer.data(), buffer.size(), stream_done));
+        for (int i = 0; i < 1000 && stream_result < 0; i++) {
+            run_one_scan_loop();
+        }
+        uint64_t time = SplitSim::now_ns() - start;
+        EXPECT_EQ(stream_result, 1);
+        EXPECT_FALSE(transaction_rpc_stream_busy());
+        return time;
+    }
+
+    // What the slave got of the last stream
+    stream_status_t streamed() {
+        stream_control_t control = {0};
+        stream_status_t  status  = {0};
+        EXPECT_TRUE(transaction_rpc_exec(USER_SYNC_C, sizeof(control), &control, sizeof(status), &status));
+        return status;
+    }
+
+    static std::vector<uint8_t> payload(uint16_t length) {
+        std::vector<uint8_t> buffer(length);
+        for (uint16_t i = 0; i < length; i++) {
+            buffer[i] = i * 31 + (i >> 8);
+        }
+        return buffer;
+    }
+
+    // Taps a key on either half and returns how long it took to reach the host, in nanoseconds
+    uint64_t tap_latency(TestDriver &driver, KeymapKey &key, bool on_slave) {
+        uint64_t pressed  = SplitSim::now_ns();
+        uint64_t reported = 0;
+        EXPECT_REPORT(driver, (key.report_code)).WillOnce([&](report_keyboard_t &) { reported = SplitSim::now_ns(); });
+        if (on_slave) {
+            SplitSim::press(key.position.col, key.position.row);
+        } else {
+            key.press();
+        }
+        for (int i = 0; i < 10 && !reported; i++) {
+            run_one_scan_loop();
+        }
+
+        EXPECT_EMPTY_REPORT(driver);
+        if (on_slave) {
+            SplitSim::release(key.position.col, key.position.row);
+        } else {
+            key.release();
+        }
+        idle_for(10);
+        VERIFY_AND_CLEAR(driver);
+        return reported - pressed;
+    }
+};
+
+TEST_F(Split, SlaveKeyReachesHost) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey{0, 3, 2, KC_A};
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    SplitSim::press(3, 2);
+    idle_for(3);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    SplitSim::release(3, 2);
+    idle_for(3);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, LayerStateSyncs) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    layer_on(2);
+    default_layer_set((layer_state_t)1 << 1);
+    run_one_scan_loop();
+    EXPECT_EQ(SplitSim::slave_state().layer_state, (layer_state_t)1 << 2);
+    EXPECT_EQ(SplitSim::slave_state().default_layer_state, (layer_state_t)1 << 1);
+
+    layer_clear();
+    default_layer_set(1);
+    run_one_scan_loop();
+    EXPECT_EQ(SplitSim::slave_state().layer_state, 0u);
+    EXPECT_EQ(SplitSim::slave_state().default_layer_state, 1u);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, ModsOfSlaveKeySyncBack) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey{0, 0, 3, KC_LSFT};
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    SplitSim::press(0, 3);
+    idle_for(3);
+    EXPECT_EQ(SplitSim::slave_state().mods, MOD_BIT(KC_LSFT));
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    SplitSim::release(0, 3);
+    idle_for(3);
+    EXPECT_EQ(SplitSim::slave_state().mods, 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, LedStateSyncs) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    led_t caps_lock = {.caps_lock = true};
+    driver.set_leds(caps_lock.raw);
+    idle_for(2);
+    EXPECT_EQ(SplitSim::slave_state().led_state, caps_lock.raw);
+
+    driver.set_leds(0);
+    idle_for(2);
+    EXPECT_EQ(SplitSim::slave_state().led_state, 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, RgbMatrixSyncs) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    rgb_matrix_enable_noeeprom();
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(85, 255, 255);
+    idle_for(2);
+    SplitSlaveState state = SplitSim::slave_state();
+    EXPECT_TRUE(state.rgb_matrix_enabled);
+    EXPECT_EQ(state.rgb_matrix_mode, RGB_MATRIX_SOLID_COLOR);
+    EXPECT_EQ(state.rgb_matrix_hue, 85);
+
+    rgb_matrix_disable_noeeprom();
+    idle_for(2);
+    EXPECT_FALSE(SplitSim::slave_state().rgb_matrix_enabled);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, SyncTimerFollowsMaster) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    idle_for(500);
+    uint32_t master = sync_timer_read32();
+    uint32_t slave  = SplitSim::slave_state().sync_timer;
+    EXPECT_LE(master > slave ? master - slave : slave - master, 2u);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, CorruptedLinkRecovers) {
+    TestDriver driver;
+    // Bit errors must not make up key presses
+    EXPECT_NO_REPORT(driver);
+
+    SplitSim::link.bit_error_rate = 1e-3;
+    uint32_t failures             = SplitSim::stats.failures;
+    for (int i = 0; i < 50; i++) {
+        layer_move(i % 4);
+        idle_for(20);
+    }
+    EXPECT_GT(SplitSim::stats.failures, failures);
+
+    SplitSim::link.bit_error_rate = 0;
+    layer_move(3);
+    // Long enough for a disconnected master to try again
+    idle_for(600);
+    EXPECT_TRUE(is_transport_connected());
+    EXPECT_EQ(SplitSim::slave_state().layer_state, (layer_state_t)1 << 3);
+    layer_clear();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, RpcRoundTrip) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    uint8_t request[RPC_M2S_BUFFER_SIZE];
+    uint8_t response[RPC_S2M_BUFFER_SIZE];
+    for (uint8_t i = 0; i < sizeof(request); i++) {
+        request[i] = i * 7;
+    }
+
+    const int count  = 100;
+    uint64_t  before = SplitSim::stats.busy_ns;
+    for (int i = 0; i < count; i++) {
+        request[0] = i;
+        ASSERT_TRUE(transaction_rpc_exec(USER_SYNC_A, sizeof(request), request, sizeof(response), response));
+        ASSERT_EQ(response[0], (uint8_t)~i);
+        ASSERT_EQ(response[sizeof(response) - 1], (uint8_t)~request[sizeof(request) - 1]);
+    }
+    uint64_t per_call = (SplitSim::stats.busy_ns - before) / count;
+
+    // Four transactions: the info, the request, the call and the response, with a few bytes of framing on top of the payload
+    EXPECT_LT(per_call, (sizeof(request) + sizeof(response) + 16) * SplitSim::link.byte_ns + 4 * SplitSim::link.turnaround_ns);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, RpcStreamDeliversLargePayload) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    std::vector<uint8_t> buffer = payload(1000);
+    stream(buffer, 0);
+    stream_status_t status = streamed();
+    EXPECT_EQ(status.received, buffer.size());
+    EXPECT_EQ(status.hash, fnv1a(buffer.data(), buffer.size()));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, RpcStreamWaitsForSlowSlave) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    std::vector<uint8_t> buffer = payload(500);
+    stream(buffer, 3);
+    stream_status_t status = streamed();
+    EXPECT_EQ(status.received, buffer.size());
+    EXPECT_EQ(status.hash, fnv1a(buffer.data(), buffer.size()));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, RpcStreamSurvivesBitErrors) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    std::vector<uint8_t> buffer = payload(2000);
+    uint32_t             start  = SplitSim::stats.transactions;
+    stream(buffer, 0);
+    uint32_t clean = SplitSim::stats.transactions - start;
+
+    // Chunks that do not make it intact go again
+    SplitSim::link.bit_error_rate = 1e-3;
+    start                         = SplitSim::stats.transactions;
+    stream(buffer, 0);
+    EXPECT_GT(SplitSim::stats.transactions - start, clean);
+
+    SplitSim::link.bit_error_rate = 0;
+    stream_status_t status        = streamed();
+    EXPECT_EQ(status.received, buffer.size());
+    EXPECT_EQ(status.hash, fnv1a(buffer.data(), buffer.size()));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, RpcStreamDropsRepeatedChunks) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    // Every chunk reaches the slave, but the first answer to each is lost, so the master sends it again
+    std::vector<uint8_t> buffer = payload(500);
+    SplitSim::link.fail_id      = PUT_RPC_STREAM;
+    SplitSim::link.fail_every   = 2;
+    SplitSim::stats.tries.clear();
+    stream(buffer, 0);
+    EXPECT_GE(SplitSim::stats.tries[PUT_RPC_STREAM], 2 * ((buffer.size() + RPC_STREAM_CHUNK_SIZE - 1) / RPC_STREAM_CHUNK_SIZE));
+
+    SplitSim::link.fail_every = 0;
+    stream_status_t status    = streamed();
+    EXPECT_EQ(status.received, buffer.size());
+    EXPECT_EQ(status.repeats, 0);
+    EXPECT_EQ(status.hash, fnv1a(buffer.data(), buffer.size()));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, RpcStreamStartsOverAfterAbandonedStream) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    std::vector<uint8_t> first = payload(1000);
+    stream_result              = -1;
+    EXPECT_TRUE(transaction_rpc_stream(USER_SYNC_B, first.data(), first.size(), stream_done));
+    idle_for(2);
+    EXPECT_TRUE(transaction_rpc_stream_busy());
+
+    // The halves lose each other part way in, so the slave is left in the middle of a stream, as it is when the master restarts
+    SplitSim::link.bit_error_rate = 1;
+    for (int i = 0; i < 1000 && stream_result < 0; i++) {
+        run_one_scan_loop();
+    }
+    EXPECT_EQ(stream_result, 0);
+    SplitSim::link.bit_error_rate = 0;
+    idle_for(600);
+    ASSERT_TRUE(is_transport_connected());
+
+    std::vector<uint8_t> second = payload(300);
+    std::reverse(second.begin(), second.end());
+    stream(second, 0);
+    stream_status_t status = streamed();
+    EXPECT_EQ(status.received, second.size());
+    EXPECT_EQ(status.hash, fnv1a(second.data(), second.size()));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, RpcStreamThroughput) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    // The same 1024 bytes as 32 byte RPC calls, each with its own info transaction
+    std::vector<uint8_t> buffer = payload(1024);
+    uint8_t              response[RPC_S2M_BUFFER_SIZE];
+    uint64_t             start = SplitSim::now_ns();
+    for (size_t i = 0; i < buffer.size(); i += RPC_M2S_BUFFER_SIZE) {
+        ASSERT_TRUE(transaction_rpc_send(USER_SYNC_A, RPC_M2S_BUFFER_SIZE, buffer.data() + i));
+        run_one_scan_loop();
+    }
+    uint64_t calls = SplitSim::now_ns() - start;
+
+    uint64_t streamed = stream(buffer, 0);
+    // A chunk is no larger than a call's request and needs no info transaction, it only carries less of the data
+    EXPECT_LT(streamed * RPC_STREAM_CHUNK_SIZE, calls * RPC_M2S_BUFFER_SIZE);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, IdleTraffic) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    idle_for(200);
+    SplitLinkStats before = SplitSim::stats;
+    uint64_t       start  = SplitSim::now_ns();
+    idle_for(1000);
+    uint32_t transactions = SplitSim::stats.transactions - before.transactions;
+    uint64_t bytes        = SplitSim::stats.bytes - before.bytes;
+    uint64_t busy         = SplitSim::stats.busy_ns - before.busy_ns;
+    // The slave matrix checksum is read on every pass, the forced syncs add less than a tenth to that
+    EXPECT_GE(transactions, 1000);
+    EXPECT_LT(transactions, 1100);
+    EXPECT_LT(bytes, 4 * 1000);
+    // Nothing but the link adds to the scans
+    EXPECT_EQ(SplitSim::now_ns() - start, 1000 * 1000000ull + busy);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, ScanToReportLatency) {
+    TestDriver driver;
+    KeymapKey  master_key = KeymapKey{0, 0, 0, KC_B};
+    KeymapKey  slave_key  = KeymapKey{0, 0, 2, KC_A};
+    set_keymap({master_key, slave_key});
+
+    // Past the forced refresh of every sync, after the clock started again from 0
+    idle_for(200);
+
+    for (uint32_t baud : {460800, 230400, 115200, 38400}) {
+        SplitSim::link.byte_ns  = 1000000000ull * 12 / baud;
+        uint64_t master_latency = tap_latency(driver, master_key, false);
+        uint64_t slave_latency  = tap_latency(driver, slave_key, true);
+        // A key on the master is reported after the checksum read of the same pass
+        EXPECT_LE(master_latency, 3 * SplitSim::link.byte_ns + SplitSim::link.turnaround_ns);
+        // A key on the slave waits for its next scan, then for the checksum reads of two passes and the matrix read
+        EXPECT_LE(slave_latency, 1000000 + 12 * SplitSim::link.byte_ns + 3 * SplitSim::link.turnaround_ns);
+    }
+}
@@ -432,3 +432,65 @@ TEST_F(TapDance, DanceFnAdvancedWithReleaseAndFinish) {
     EXPECT_EMPTY_REPORT(driver);
     run_one_scan_loop();
 }
+
+TEST_F(TapDance, PressWithoutFreeStateIsIgnored) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_egg      = KeymapKey(0, 1, 0, TD(CT_EGG));
+    auto       key_esc_caps = KeymapKey(0, 2, 0, TD(TD_ESC_CAPS));
+    auto       key_rls_fin  = KeymapKey(0, 3, 0, TD(TD_RELEASE_AND_FINISH));
+    auto       key_rls      = KeymapKey(0, 4, 0, TD(TD_RELEASE));
+
+    set_keymap({key_egg, key_esc_caps, key_rls_fin, key_rls});
+
+    /* Three held dances use up every state, each one interrupting the one before */
+    key_egg.press();
+    run_one_scan_loop();
+    key_esc_caps.press();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_REPORT(driver, (KC_ESC, KC_P));
+    EXPECT_REPORT(driver, (KC_ESC));
+    key_rls_fin.press();
+    run_one_scan_loop();
+
+    /* The fourth dance only interrupts the third, none of its own callbacks run on press or release */
+    EXPECT_REPORT(driver, (KC_ESC, KC_F));
+    EXPECT_REPORT(driver, (KC_ESC));
+    key_rls.press();
+    run_one_scan_loop();
+    key_rls.release();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_ESC, KC_U));
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_REPORT(driver, (KC_ESC, KC_R));
+    EXPECT_REPORT(driver, (KC_ESC));
+    key_rls_fin.release();
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    key_esc_caps.release();
+    run_one_scan_loop();
+    key_egg.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* A state is free again */
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    key_rls.press();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_U));
+    EXPECT_EMPTY_REPORT(driver);
+    key_rls.release();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_R));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(TAPPING_TERM);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}